@@ -48,15 +48,27 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sensor_msgs/fill_image.h>
 #include <any_spinnaker_camera_driver/camera_exceptions.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <sstream>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 // Header generated by dynamic_reconfigure
 #include <any_spinnaker_camera_driver/SpinnakerConfig.h>
 #include "any_spinnaker_camera_driver/camera.h"
 #include "any_spinnaker_camera_driver/cm3.h"
+#include "any_spinnaker_camera_driver/decompression_pool.h"
+#include "any_spinnaker_camera_driver/device_registry.h"
+#include "any_spinnaker_camera_driver/packed_pixels.h"
+#include "any_spinnaker_camera_driver/pixel_format_negotiation.h"
 #include "any_spinnaker_camera_driver/set_property.h"
+#include "any_spinnaker_camera_driver/software_binning.h"
+#include "any_spinnaker_camera_driver/startup_profiler.h"
+#include "any_spinnaker_camera_driver/stream_buffer_pool.h"
 
 // Spinnaker SDK
 #include "Spinnaker.h"
@@ -64,6 +76,20 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace any_spinnaker_camera_driver
 {
+/// Information about a grabbed frame that is not part of the sensor_msgs::Image.
+struct FrameInfo
+{
+  uint64_t hardware_stamp_ns{ 0 };  ///< Camera time stamp of the frame (nanoseconds).
+  uint64_t frame_id{ 0 };           ///< Camera frame counter.
+  /// Binning times decimation applied to the frame by the camera and the driver together.
+  unsigned int binning_x{ 1 };
+  unsigned int binning_y{ 1 };
+  bool skipped{ false };  ///< Rejected by the frame filter, the image was not filled.
+};
+
+/// Decides from the camera time stamp and frame counter if a frame is turned into an image, before it is copied.
+using FrameFilter = std::function<bool(const FrameInfo&)>;
+
 class SpinnakerCamera
 {
 public:
@@ -86,6 +112,84 @@ public:
   */
   void setNewConfiguration(const any_spinnaker_camera_driver::SpinnakerConfig& config, const uint32_t& level);
 
+  /*!
+  * \brief Applies a full configuration to a freshly connected or re-initialized camera.
+  *
+  * The acquisition has to be stopped. If a UserSet is set with setUserSet() and holds this configuration from a
+  * previous call, it is loaded with a single command. Otherwise every feature is written and the result is stored in
+  * the UserSet for the next time.
+  * \param config The configuration to apply.
+  * \param warm_up Start and stop the acquisition once before writing the features, like setNewConfiguration() does.
+  * Without it the configuration is written exactly once before the first start().
+  * \return True if the configuration was loaded from the UserSet.
+  */
+  bool restoreConfiguration(const any_spinnaker_camera_driver::SpinnakerConfig& config, bool warm_up);
+
+  /*!
+  * \brief Selects the UserSet restoreConfiguration() keeps the configuration in.
+  *
+  * \param user_set Name of the UserSet, e.g. "UserSet1", empty to always write every feature.
+  */
+  void setUserSet(const std::string& user_set);
+
+  /*!
+  * \brief Selects how grabImage() returns 12-bit packed pixel formats like Mono12p or BayerRG12Packed.
+  *
+  * \param unpack True to unpack them to the 16-bit encodings, false to pass the packed data through with an encoding
+  * from getPackedEncoding(), e.g. "bayer_rggb12p".
+  */
+  void setUnpack12Bit(bool unpack);
+
+  /*!
+  * \brief Sets the number of threads decompressing the frames of a camera with on-camera lossless compression.
+  *
+  * Compression is enabled with the compression_mode parameter. Up to one frame per thread is decompressed at the
+  * same time, so grabImage() returns each frame up to threads - 1 frames late. Must be called before start().
+  * \param threads Number of decompression threads, at least 1.
+  */
+  void setDecompressionThreads(unsigned int threads);
+
+  /*!
+  * \brief Reads the compression ratio, decompression time and link utilization of the compressed frames.
+  *
+  * \param statistics Filled with the statistics.
+  * \return False if the camera did not compress its frames since the driver started.
+  */
+  bool getDecompressionStatistics(DecompressionPool::Statistics* statistics);
+
+  /*!
+  * \brief Sets the images the active topics need, from which the pixel format is chosen if the configuration has the
+  * image_format_color_coding "auto".
+  *
+  * The format is only chosen when the camera is configured, the next call of setNewConfiguration() applies it.
+  * \param demand The images the active topics need.
+  * \return True if the camera is configured with "auto" and the demand asks for a different pixel format.
+  */
+  bool setOutputDemand(const OutputDemand& demand);
+
+  /*!
+  * \brief Reads the pixel format chosen for the "auto" image_format_color_coding.
+  *
+  * \param choice Filled with the format and the link bandwidth it saves.
+  * \return False if the camera is not configured with "auto".
+  */
+  bool getPixelFormatChoice(PixelFormatChoice* choice);
+
+  /*!
+  * \brief Selects how grabImage() combines the pixels it bins on the host.
+  *
+  * Binning and decimation the camera does not support are done on the host. Must be called before the camera is
+  * configured.
+  */
+  void setSoftwareBinningMode(SoftwareBinning::Mode mode);
+
+  /*!
+  * \brief Reads the binning and decimation done on the host for the current configuration.
+  *
+  * \param factors Filled with the factors, all 1 if the camera applies the whole configuration.
+  */
+  void getSoftwareBinning(ImageFormatFactors* factors);
+
   /** Parameters that need a sensor to be stopped completely when changed. */
   static const uint8_t LEVEL_RECONFIGURE_CLOSE = 3;
 
@@ -107,6 +211,15 @@ public:
   */
   bool connect();
 
+  /*!
+  * \brief Waits until the camera connect() would connect to is present, without connecting to it.
+  *
+  * Lets a caller limit the number of concurrent connections without an absent camera taking up one of them. The
+  * camera is looked up again by connect(), from the cached camera lists.
+  * \return True if the camera was found within the connection timeout.
+  */
+  bool waitForCamera();
+
   /*!
   * \brief Disconnects from the camera.
   *
@@ -114,6 +227,14 @@ public:
   */
   void disconnect();
 
+  /*!
+  * \brief Deinitializes and initializes the connected camera again, without releasing it.
+  *
+  * Recovers a stuck stream faster than disconnect() and connect(), as the camera does not have to be enumerated again.
+  * The acquisition is stopped afterwards and the configuration has to be applied again.
+  */
+  void reinitialize();
+
   /*!
   * \brief Starts the camera loading data into its buffer.
   *
@@ -135,8 +256,12 @@ public:
   * This function will load the raw data from the buffer and place it into a sensor_msgs::Image.
   * \param image sensor_msgs::Image that will be filled with the image currently in the buffer.
   * \param frame_id The name of the optical frame of the camera.
+  * \param frame_info Optional, filled with the camera time stamp and frame counter of the image.
+  * \param filter Optional, called for every frame with frame_info. If it returns false, the image is not filled and
+  * frame_info is marked as skipped.
   */
-  bool grabImage(sensor_msgs::Image* image, const std::string& frame_id);
+  bool grabImage(sensor_msgs::Image* image, const std::string& frame_id, FrameInfo* frame_info = nullptr,
+                 const FrameFilter& filter = FrameFilter());
 
   /*!
   * \brief Will set grabImage timeout for the camera.
@@ -163,6 +288,39 @@ public:
   int getHeightMax();
   int getWidthMax();
   void setGigEParameters(bool auto_packet_size, unsigned int packet_size, unsigned int packet_delay);
+
+  /*!
+  * \brief Lets the driver allocate the stream buffers instead of the SDK.
+  *
+  * The buffers are announced to the SDK on every start() and reused across restarts. Must be called before start().
+  * \param buffer_count Number of stream buffers.
+  * \param huge_pages Back the buffers with huge pages if available.
+  * \param lock Lock the buffers into memory if permitted.
+  */
+  void setUserBuffers(unsigned int buffer_count, bool huge_pages, bool lock);
+
+  /*!
+  * \brief Takes the time the desired camera last arrived on an interface, so that it is only reported once.
+  *
+  * \param time Set to the arrival time.
+  * \return False if no arrival was reported since the last call, or if device events are not available.
+  */
+  bool takeArrivalTime(std::chrono::steady_clock::time_point* time);
+
+  /** True if the SDK reported the removal of the desired camera and it did not arrive again since. */
+  bool wasRemoved() const;
+
+  /** Records the enumerate and init phases of connect() in the given profiler, null to disable. */
+  void setStartupProfiler(StartupProfiler* profiler)
+  {
+    startup_profiler_ = profiler;
+  }
+
+  /** The driver allocated stream buffers, null if the SDK allocates them. */
+  const StreamBufferPool* getStreamBufferPool() const
+  {
+    return use_user_buffers_ ? buffer_pool_.get() : nullptr;
+  }
   Spinnaker::GenApi::CNodePtr readProperty(const Spinnaker::GenICam::gcstring property_name);
 
   uint32_t getSerial()
@@ -178,8 +336,30 @@ public:
 private:
   uint32_t serial_;  ///< A variable to hold the serial number of the desired camera.
 
-  Spinnaker::SystemPtr system_;
-  Spinnaker::CameraList camList_;
+  /// Driver allocated stream buffers, declared before the camera members so that it outlives them.
+  std::unique_ptr<StreamBufferPool> buffer_pool_;
+  unsigned int user_buffer_count_{ 1 };
+  std::atomic<bool> use_user_buffers_{ false };  ///< Cleared if the SDK rejects the user buffers.
+
+  /// Spinnaker system and camera list shared with the other cameras of the process.
+  std::shared_ptr<DeviceRegistry> registry_;
+  StartupProfiler* startup_profiler_{ nullptr };
+
+  std::string user_set_;        ///< UserSet holding the last restored configuration, empty if disabled.
+  uint64_t user_set_hash_{ 0 };  ///< Hash of the configuration stored in user_set_, 0 if none was stored.
+  bool unpack_12bit_{ true };    ///< Unpack 12-bit packed frames to 16 bit instead of passing them through.
+  unsigned int decompression_threads_{ 2 };
+  /// Created once the camera compresses its frames, guarded by decompression_mutex_.
+  std::shared_ptr<DecompressionPool> decompression_pool_;
+  std::mutex decompression_mutex_;
+  SoftwareBinning::Mode software_binning_mode_{ SoftwareBinning::Mode::AVERAGE };
+  ImageFormatFactors hardware_factors_;  ///< Binning and decimation done by the camera, guarded by mutex_.
+  ImageFormatFactors software_factors_;  ///< Binning and decimation done by the driver, guarded by mutex_.
+  /// Bins and decimates the frames on the host, empty if software_factors_ are all 1.
+  std::unique_ptr<SoftwareBinning> software_binning_;
+  std::vector<uint16_t> unpacked_;  ///< 12-bit packed frame unpacked before it is binned on the host.
+  OutputDemand pixel_format_demand_;       ///< Guarded by mutex_.
+  PixelFormatChoice pixel_format_choice_;  ///< Format chosen for "auto", empty otherwise, guarded by mutex_.
   Spinnaker::CameraPtr pCam_;
   // The timeout allowed for the driver to connect to the device. Unit: second.
   double deviceConnectionTimeout_{28};
@@ -212,6 +392,41 @@ private:
   // When chunk data is turned on, the data is made available in both the nodemap
   // and each image.
   void ConfigureChunkData(const Spinnaker::GenApi::INodeMap& nodeMap);
+
+  /// The decompression pool, created on the first call.
+  std::shared_ptr<DecompressionPool> getDecompressionPool();
+
+  /**
+   * @brief Submits a compressed frame for decompression and takes the oldest decompressed one.
+   * While fewer frames than decompression threads are in flight and the oldest one is not done, frames the camera
+   * delivered already are submitted first. It never waits for the camera to deliver a further frame.
+   * @param image_ptr The compressed frame, released after it was submitted. Invalid to only take a frame in flight.
+   * @param frame Filled with the oldest decompressed frame.
+   * @return False if the frame could not be decompressed.
+   */
+  bool takeDecompressed(Spinnaker::ImagePtr image_ptr, DecompressionPool::Frame* frame);
+
+  /** True if compressed frames were submitted for decompression and not taken yet. */
+  bool hasPendingDecompressed();
+
+  /** Returns the next frame the camera delivered already without waiting, an invalid pointer if there is none. */
+  Spinnaker::ImagePtr getQueuedImage();
+
+  /**
+   * @brief Splits the binning and decimation of a configuration into what the camera applied and what is left for
+   * the host. Called with mutex_ locked after the camera was configured.
+   */
+  void updateSoftwareBinning(const any_spinnaker_camera_driver::SpinnakerConfig& config);
+
+  /**
+   * @brief Replaces the "auto" image_format_color_coding with the pixel format negotiated for the output demand.
+   * Called with mutex_ locked while the camera is connected.
+   */
+  any_spinnaker_camera_driver::SpinnakerConfig
+  resolvePixelFormat(const any_spinnaker_camera_driver::SpinnakerConfig& config);
+
+  /// Hash over all parameters of a configuration, never 0.
+  static uint64_t configurationHash(const any_spinnaker_camera_driver::SpinnakerConfig& config);
   /**
    * @brief The function tries to obtain the valid camera pointer. It contains a while loop to query the camera point.
    * It never returns unless it obtains a valid camera pointer.
@@ -220,6 +435,14 @@ private:
    */
   bool obtainCameraPtr(double sleep_time);
 
+  /**
+   * @brief Waits for the desired camera to arrive using the device events, instead of enumerating periodically.
+   * The cached camera lists are checked on each arrival, all interfaces are only enumerated as a fallback every few
+   * seconds.
+   * @return True if the camera pointer is obtained within the connection timeout.
+   */
+  bool obtainCameraPtrOnArrival();
+
   /**
    * Auto force the IP so that the PC can talk with the camera given the camera pointer.
    * @param camPointer The spinnaker camera pointer.
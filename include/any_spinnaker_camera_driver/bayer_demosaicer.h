@@ -0,0 +1,140 @@
+/**
+Software License Agreement (BSD)
+
+\file      bayer_demosaicer.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_BAYER_DEMOSAICER_H
+#define SPINNAKER_CAMERA_DRIVER_BAYER_DEMOSAICER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Converts Bayer images to RGB and mono images, as image_proc/debayer does but inside the driver.
+ *
+ * The rows of an image are split into bands which are converted concurrently by a small pool of threads, the calling
+ * thread converts the first band. The row kernels are written to be vectorized by the compiler, on x86 they are
+ * built for AVX2 and the baseline and the variant is selected at runtime, on ARM NEON is part of the baseline.
+ */
+class BayerDemosaicer
+{
+public:
+  /** Color of the first two pixels of the first row. */
+  enum class Pattern
+  {
+    RGGB,
+    GRBG,
+    GBRG,
+    BGGR
+  };
+
+  enum class Method
+  {
+    BILINEAR,    ///< Average of the neighbors with the missing color.
+    EDGE_AWARE,  ///< Green along the direction of the smaller gradient, red and blue bilinear.
+  };
+
+  /*!
+   * \param method Interpolation of the missing colors.
+   * \param threads Number of threads converting an image including the calling one, at least 1.
+   */
+  BayerDemosaicer(Method method, unsigned int threads);
+  ~BayerDemosaicer();
+
+  BayerDemosaicer(const BayerDemosaicer&) = delete;
+  BayerDemosaicer& operator=(const BayerDemosaicer&) = delete;
+
+  /*!
+   * \brief Reads the pattern and bit depth from a ROS image encoding.
+   * \param encoding E.g. "bayer_rggb8" or "bayer_gbrg16".
+   * \return False if the encoding is not a Bayer encoding.
+   */
+  static bool parseEncoding(const std::string& encoding, Pattern* pattern, unsigned int* bit_depth);
+
+  /*!
+   * \brief Reads the method from its parameter name.
+   * \param name "bilinear" or "edge_aware".
+   * \return False if the name is unknown.
+   */
+  static bool parseMethod(const std::string& name, Method* method);
+
+  static std::string toString(Method method);
+
+  /** Instruction set of the row kernels on this CPU. */
+  static std::string getKernelName();
+
+  /*!
+   * \brief Converts a Bayer image.
+   *
+   * The borders are mirrored. Must not be called concurrently. Throws a std::runtime_error if the image is smaller than 2 x 2 pixels or the bit depth
+   * is neither 8 nor 16.
+   * \param src First row of the Bayer image, e.g. the data of the acquired frame.
+   * \param width Width of the image (pixels).
+   * \param height Height of the image (pixels).
+   * \param src_step Distance between two rows of the Bayer image (bytes).
+   * \param pattern Bayer pattern of the image.
+   * \param bit_depth 8 or 16, 16-bit pixels are in host byte order.
+   * \param color Output RGB image with the same bit depth, may be null.
+   * \param color_step Distance between two rows of the RGB image (bytes).
+   * \param mono Output luminance image with the same bit depth, may be null.
+   * \param mono_step Distance between two rows of the luminance image (bytes).
+   */
+  void process(const void* src, size_t width, size_t height, size_t src_step, Pattern pattern,
+               unsigned int bit_depth, void* color, size_t color_step, void* mono, size_t mono_step);
+
+  Method getMethod() const
+  {
+    return method_;
+  }
+
+  unsigned int getThreads() const
+  {
+    return static_cast<unsigned int>(workers_.size() + 1);
+  }
+
+private:
+  /** Runs job(band) for all bands, band 0 on the calling thread. */
+  void runBands(const std::function<void(size_t)>& job);
+  void workerLoop(size_t band);
+
+  Method method_;
+  std::vector<std::vector<uint8_t>> scratch_;  ///< Color planes of one row per band.
+  std::vector<std::thread> workers_;           ///< Convert the bands 1 to n.
+
+  std::mutex mutex_;
+  std::condition_variable job_cv_;   ///< Notifies the workers of a new job.
+  std::condition_variable done_cv_;  ///< Notifies the caller that a worker finished its band.
+  const std::function<void(size_t)>* job_{ nullptr };
+  uint64_t generation_{ 0 };  ///< Incremented for every job.
+  size_t pending_{ 0 };       ///< Workers still converting their band of the current job.
+  bool stop_{ false };
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_BAYER_DEMOSAICER_H
@@ -27,6 +27,9 @@ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSI
 
 #include <ros/ros.h>
 
+#include <string>
+#include <vector>
+
 // Header generated by dynamic_reconfigure
 #include <any_spinnaker_camera_driver/SpinnakerConfig.h>
 #include "any_spinnaker_camera_driver/set_property.h"
@@ -44,6 +47,15 @@ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSI
 
 namespace any_spinnaker_camera_driver
 {
+/// Binning and decimation of the frames, 1 for no reduction.
+struct ImageFormatFactors
+{
+  int binning_x{ 1 };
+  int binning_y{ 1 };
+  int decimation_x{ 1 };
+  int decimation_y{ 1 };
+};
+
 class Camera
 {
 public:
@@ -79,11 +91,42 @@ public:
   Spinnaker::GenApi::CNodePtr
   readProperty(const Spinnaker::GenICam::gcstring property_name);
 
+  /*!
+  * \brief Reads the binning and decimation the camera applies, 1 for the ones the model does not support.
+  *
+  * The driver does the rest of the configured binning and decimation on the host.
+  */
+  ImageFormatFactors readImageFormatFactors();
+
+  /*!
+  * \brief Reads the pixel formats the camera offers in its current configuration.
+  *
+  * \return The names of the formats, e.g. "BayerRG8" or "Mono12p".
+  */
+  std::vector<std::string> readPixelFormats();
+
+  /*!
+  * \brief Stores the current configuration of the camera in its non-volatile memory.
+  *
+  * \param user_set Name of the UserSet to store the configuration in, e.g. "UserSet1".
+  */
+  void saveUserSet(const std::string& user_set);
+
+  /*!
+  * \brief Loads a configuration stored with saveUserSet(). The acquisition has to be stopped.
+  *
+  * \param user_set Name of the UserSet to load.
+  */
+  void loadUserSet(const std::string& user_set);
+
 protected:
   Spinnaker::GenApi::INodeMap* node_map_;
 
   virtual void init();
 
+  /// Reads height_max_ and width_max_, which depend on the binning and decimation.
+  void readMaxSize();
+
   int height_max_;
   int width_max_;
 
@@ -0,0 +1,137 @@
+/**
+Software License Agreement (BSD)
+
+\file      compression_pool.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_COMPRESSION_POOL_H
+#define SPINNAKER_CAMERA_DRIVER_COMPRESSION_POOL_H
+
+#include <sensor_msgs/CompressedImage.h>
+#include <sensor_msgs/Image.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Compresses images on a pool of worker threads, so that the acquisition thread only queues them.
+ *
+ * Every image is compressed once, the result is handed to a callback that publishes it to all subscribers. The queue
+ * is bounded: if the workers fall behind, the oldest queued image is dropped instead of delaying the caller. Results
+ * are handed to the callback in the order the images were taken from the queue.
+ */
+class CompressionPool
+{
+public:
+  struct Config
+  {
+    std::string format{ "jpeg" };  ///< "jpeg" or "png".
+    int jpeg_quality{ 80 };         ///< 1 to 100.
+    int png_level{ 3 };             ///< 0 to 9.
+    unsigned int threads{ 2 };
+    size_t queue_size{ 2 };  ///< Images waiting for a worker, at least 1.
+  };
+
+  struct Statistics
+  {
+    uint64_t compressed{ 0 };         ///< Images handed to the callback.
+    uint64_t dropped{ 0 };            ///< Images dropped from the full queue.
+    uint64_t failed{ 0 };             ///< Images that could not be compressed.
+    double last_latency_ms{ 0.0 };    ///< From submit() to the callback, for the last image.
+    double max_latency_ms{ 0.0 };
+    double last_compression_ms{ 0.0 };  ///< Time spent compressing the last image.
+    std::string last_error;             ///< Reason the last failed image could not be compressed.
+  };
+
+  using Callback = std::function<void(const sensor_msgs::CompressedImageConstPtr&)>;
+
+  /*!
+   * \param config Format and pool size.
+   * \param callback Called with the compressed images, from the worker threads but never concurrently.
+   */
+  CompressionPool(const Config& config, Callback callback);
+  ~CompressionPool();
+
+  CompressionPool(const CompressionPool&) = delete;
+  CompressionPool& operator=(const CompressionPool&) = delete;
+
+  /*!
+   * \brief Queues an image for compression, never blocks.
+   *
+   * If the queue is full, the oldest queued image is dropped.
+   */
+  void submit(const sensor_msgs::ImageConstPtr& image);
+
+  Statistics getStatistics() const;
+
+  const Config& getConfig() const
+  {
+    return config_;
+  }
+
+  /*!
+   * \brief Compresses an image like the compressed plugin of image_transport.
+   *
+   * Bayer images are demosaiced, color images are stored as BGR. JPEG reduces 16-bit images to 8 bit.
+   * \param image The image to compress.
+   * \param config The format of the compressed image.
+   * \param compressed Filled with the compressed data and the format string of the compressed transport.
+   * \param error Set to the reason if the image could not be compressed.
+   * \return True on success.
+   */
+  static bool compress(const sensor_msgs::Image& image, const Config& config, sensor_msgs::CompressedImage* compressed,
+                       std::string* error);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Job
+  {
+    sensor_msgs::ImageConstPtr image;
+    Clock::time_point submitted;
+  };
+
+  void workerLoop();
+
+  Config config_;
+  Callback callback_;
+  std::vector<std::thread> workers_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable job_cv_;      ///< Notifies the workers of a queued job.
+  std::condition_variable publish_cv_;  ///< Notifies the workers that the previous result was handed on.
+  std::deque<Job> queue_;
+  uint64_t next_sequence_{ 0 };  ///< Sequence number of the next job taken from the queue.
+  uint64_t next_publish_{ 0 };   ///< Sequence number of the next result to hand to the callback.
+  bool stop_{ false };
+  Statistics statistics_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_COMPRESSION_POOL_H
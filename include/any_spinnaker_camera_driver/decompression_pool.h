@@ -0,0 +1,153 @@
+/**
+Software License Agreement (BSD)
+
+\file      decompression_pool.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_DECOMPRESSION_POOL_H
+#define SPINNAKER_CAMERA_DRIVER_DECOMPRESSION_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Spinnaker SDK
+#include "Spinnaker.h"
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Decompresses the frames of a camera with on-camera lossless compression on a pool of worker threads.
+ *
+ * The acquisition thread submits the compressed frames and takes the decompressed ones in the order they were
+ * submitted. Submitting copies the compressed payload, so that the stream buffer can be handed back to the camera
+ * before the frame is decompressed.
+ */
+class DecompressionPool
+{
+public:
+  struct Frame
+  {
+    Spinnaker::ImagePtr image;    ///< The decompressed image, null if it could not be decompressed.
+    uint64_t timestamp_ns{ 0 };   ///< Camera time stamp of the compressed frame.
+    uint64_t frame_id{ 0 };       ///< Camera frame counter of the compressed frame.
+    size_t payload_size{ 0 };     ///< Bytes transferred over the link.
+    std::string error;            ///< Reason the frame could not be decompressed.
+  };
+
+  struct Statistics
+  {
+    uint64_t decompressed{ 0 };            ///< Frames taken after they were decompressed.
+    uint64_t failed{ 0 };                  ///< Frames that could not be decompressed.
+    double compression_ratio{ 0.0 };       ///< Decompressed over transferred bytes, over the last second.
+    double last_decompression_ms{ 0.0 };   ///< Time a worker spent decompressing the last frame.
+    double max_decompression_ms{ 0.0 };
+    double payload_rate_mb_s{ 0.0 };       ///< Transferred megabytes per second, over the last second.
+    double link_utilization{ 0.0 };        ///< Payload rate over the link speed, 0 if the link speed is unknown.
+    std::string last_error;
+  };
+
+  /*!
+   * \param threads Number of worker threads, at least 1. It is also the number of frames that are decompressed at
+   * the same time.
+   */
+  explicit DecompressionPool(unsigned int threads);
+  ~DecompressionPool();
+
+  DecompressionPool(const DecompressionPool&) = delete;
+  DecompressionPool& operator=(const DecompressionPool&) = delete;
+
+  /*!
+   * \brief Copies a compressed frame and queues it for decompression.
+   *
+   * The caller may release the image right after.
+   * \throw Spinnaker::Exception if the frame cannot be copied.
+   */
+  void submit(const Spinnaker::ImagePtr& compressed);
+
+  /*!
+   * \brief Takes the oldest submitted frame once it is decompressed.
+   *
+   * \param frame Filled with the frame, its image is null if it could not be decompressed.
+   * \param wait Wait for the oldest frame instead of returning false if it is not decompressed yet.
+   * \return False if no frame was submitted, or if the oldest one is not done and wait is false.
+   */
+  bool take(Frame* frame, bool wait);
+
+  /** Drops all frames that were not taken yet, e.g. when the acquisition is stopped. */
+  void clear();
+
+  /** Frames submitted but not taken yet. */
+  size_t getPending() const;
+
+  unsigned int getThreads() const
+  {
+    return static_cast<unsigned int>(workers_.size());
+  }
+
+  /*!
+   * \brief Sets the speed of the link to the camera, for the link utilization.
+   *
+   * \param bytes_per_second Link speed, 0 if unknown.
+   */
+  void setLinkSpeed(double bytes_per_second);
+
+  Statistics getStatistics() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Job
+  {
+    Spinnaker::ImagePtr compressed;
+    Frame frame;
+    double decompression_ms{ 0.0 };
+    bool done{ false };
+  };
+
+  void workerLoop();
+
+  /** Accounts a taken frame for the ratio and rates over the last second, with mutex_ held. */
+  void account(const Job& job, size_t decompressed_size);
+
+  std::vector<std::thread> workers_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable job_cv_;   ///< Notifies the workers of a queued job.
+  std::condition_variable done_cv_;  ///< Notifies take() of a decompressed job.
+  std::deque<std::shared_ptr<Job>> queue_;    ///< Jobs waiting for a worker.
+  std::deque<std::shared_ptr<Job>> pending_;  ///< Jobs not taken yet, in the order they were submitted.
+  bool stop_{ false };
+
+  double link_speed_{ 0.0 };
+  Clock::time_point window_start_{ Clock::now() };
+  uint64_t window_payload_{ 0 };       ///< Transferred bytes of the frames taken in the current window.
+  uint64_t window_decompressed_{ 0 };  ///< Decompressed bytes of the frames taken in the current window.
+  Statistics statistics_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_DECOMPRESSION_POOL_H
@@ -0,0 +1,102 @@
+/**
+Software License Agreement (BSD)
+
+\file      device_event_monitor.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_DEVICE_EVENT_MONITOR_H
+#define SPINNAKER_CAMERA_DRIVER_DEVICE_EVENT_MONITOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+// Spinnaker SDK
+#include "Spinnaker.h"
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Tracks camera arrivals and removals reported by the interface event handlers of the SDK.
+ *
+ * Lets the driver wait for a camera to appear instead of enumerating all interfaces periodically.
+ */
+class DeviceEventMonitor
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   * \brief Registers the event handlers on all interfaces of the system.
+   *
+   * Throws a Spinnaker::Exception if the SDK does not support interface events.
+   */
+  explicit DeviceEventMonitor(Spinnaker::SystemPtr system);
+  ~DeviceEventMonitor();
+
+  DeviceEventMonitor(const DeviceEventMonitor&) = delete;
+  DeviceEventMonitor& operator=(const DeviceEventMonitor&) = delete;
+
+  /*!
+   * \brief Blocks until the camera arrived after a given time or the timeout expired.
+   *
+   * Returns immediately if such an arrival was reported and not taken yet.
+   * \param serial Serial number of the camera.
+   * \param after Arrivals up to this time are ignored, e.g. the last one waited for.
+   * \param timeout Maximum time to wait.
+   * \param time Set to the arrival time if the camera arrived.
+   * \return True if the camera arrived.
+   */
+  bool waitForArrival(const std::string& serial, Clock::time_point after, Clock::duration timeout,
+                      Clock::time_point* time);
+
+  /*!
+   * \brief Takes the time of the last arrival of a camera, so that it is only reported once.
+   *
+   * \param serial Serial number of the camera.
+   * \param time Set to the arrival time.
+   * \return False if no arrival was reported since the last call.
+   */
+  bool takeArrival(const std::string& serial, Clock::time_point* time);
+
+  /** True if the camera was removed and did not arrive again since. */
+  bool isRemoved(const std::string& serial) const;
+
+  void onArrival(const std::string& serial);
+  void onRemoval(const std::string& serial);
+
+private:
+  class Handler;
+
+  Spinnaker::SystemPtr system_;
+  std::unique_ptr<Handler> handler_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable arrival_cv_;
+  std::map<std::string, Clock::time_point> arrivals_;  ///< Arrivals not taken yet, by serial number.
+  std::set<std::string> removed_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_DEVICE_EVENT_MONITOR_H
@@ -0,0 +1,128 @@
+/**
+Software License Agreement (BSD)
+
+\file      device_registry.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_DEVICE_REGISTRY_H
+#define SPINNAKER_CAMERA_DRIVER_DEVICE_REGISTRY_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "any_spinnaker_camera_driver/device_event_monitor.h"
+
+// Spinnaker SDK
+#include "Spinnaker.h"
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Spinnaker system and camera list shared by all cameras of a process.
+ *
+ * Enumerating the interfaces takes a long time and blocks the other cameras, so it is done once for all of them.
+ * Rescans requested at the same time are coalesced into one, and with device events the camera lists are kept current
+ * by the SDK without enumerating at all.
+ */
+class DeviceRegistry
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// State the registry keeps per camera.
+  struct DeviceState
+  {
+    bool claimed{ false };        ///< A driver instance is connected to the camera.
+    unsigned int claims{ 0 };     ///< Number of times the camera was claimed.
+    Clock::time_point last_seen;  ///< Last time a lookup found the camera.
+  };
+
+  /*!
+   * \brief The registry of the process, created on first use and destroyed when the last user releases it.
+   */
+  static std::shared_ptr<DeviceRegistry> instance();
+
+  ~DeviceRegistry();
+
+  DeviceRegistry(const DeviceRegistry&) = delete;
+  DeviceRegistry& operator=(const DeviceRegistry&) = delete;
+
+  /*!
+   * \brief Looks up a camera.
+   *
+   * \param serial Serial number of the camera, empty for the first camera that is not claimed.
+   * \param rescan Enumerate all interfaces before the lookup, see rescan().
+   * \return The camera, null if it was not found.
+   */
+  Spinnaker::CameraPtr find(const std::string& serial, bool rescan);
+
+  /*!
+   * \brief Enumerates all interfaces.
+   *
+   * A rescan that is already running may have missed a camera that appeared after it started, so callers wait for
+   * the next one. All callers arriving during a rescan share that next one.
+   */
+  void rescan();
+
+  /*!
+   * \brief Marks a camera as used by a driver instance.
+   *
+   * \return False if another instance claimed it already.
+   */
+  bool claim(const std::string& serial);
+
+  /** Marks a camera as no longer used. */
+  void release(const std::string& serial);
+
+  DeviceState getDeviceState(const std::string& serial) const;
+
+  /** Number of completed rescans. */
+  uint64_t getRescanCount() const;
+
+  /** Camera arrivals and removals, null if the SDK does not support interface events. */
+  DeviceEventMonitor* getDeviceEvents() const
+  {
+    return device_events_.get();
+  }
+
+private:
+  DeviceRegistry();
+
+  static std::string serialOf(Spinnaker::CameraPtr camera);
+
+  Spinnaker::SystemPtr system_;
+  std::unique_ptr<DeviceEventMonitor> device_events_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable rescan_cv_;
+  Spinnaker::CameraList cameras_;  ///< Result of the last rescan.
+  bool rescanning_{ false };
+  uint64_t rescans_started_{ 0 };
+  uint64_t rescans_finished_{ 0 };
+  std::map<std::string, DeviceState> devices_;  ///< By serial number.
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_DEVICE_REGISTRY_H
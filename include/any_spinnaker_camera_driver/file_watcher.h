@@ -0,0 +1,46 @@
+/**
+Software License Agreement (BSD)
+
+\file      file_watcher.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_FILE_WATCHER_H
+#define SPINNAKER_CAMERA_DRIVER_FILE_WATCHER_H
+
+#include <functional>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+/*!
+ * \brief Waits until a file exists.
+ *
+ * Watches the closest existing parent directory with inotify and follows the path down as the missing directories
+ * are created, so that the wait ends as soon as the file appears. Pseudo file systems like sysfs do not emit inotify
+ * events, the path is therefore also checked at least every 100 ms.
+ * \param path The file to wait for.
+ * \param timeout Maximum time to wait in seconds, 0 or negative to wait forever.
+ * \param stop Checked at least every 100 ms, the wait is abandoned when it returns true.
+ * \return True if the file exists, false on timeout or when stopped.
+ */
+bool waitForFile(const std::string& path, double timeout, const std::function<bool()>& stop = std::function<bool()>());
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_FILE_WATCHER_H
@@ -0,0 +1,76 @@
+/**
+Software License Agreement (BSD)
+
+\file      frame_decimator.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_FRAME_DECIMATOR_H
+#define SPINNAKER_CAMERA_DRIVER_FRAME_DECIMATOR_H
+
+#include <cstdint>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Selects every n-th frame of a stream by its camera time stamp.
+ *
+ * The selection is based on the frame period estimated from the stamps instead of a frame counter, so that the
+ * selected frames stay evenly spaced in time when frames are dropped.
+ */
+class FrameDecimator
+{
+public:
+  /*!
+   * \param factor Decimation factor, 1 selects every frame.
+   */
+  explicit FrameDecimator(unsigned int factor);
+
+  /*!
+   * \brief Decides if a frame is part of the decimated stream.
+   *
+   * Has to be called for every frame in acquisition order.
+   * \param stamp_ns Camera time stamp of the frame (nanoseconds).
+   * \return True if the frame is selected.
+   */
+  bool select(uint64_t stamp_ns);
+
+  /** Forgets the stream, the next frame is selected. */
+  void reset();
+
+  unsigned int getFactor() const
+  {
+    return factor_;
+  }
+
+  /** Estimated frame period of the full stream (seconds), 0 until two frames were seen. */
+  double getPeriodEstimate() const
+  {
+    return period_ns_ * 1e-9;
+  }
+
+private:
+  unsigned int factor_;
+  uint64_t last_stamp_ns_{ 0 };      ///< Stamp of the previous frame, 0 before the first one.
+  uint64_t last_selected_ns_{ 0 };   ///< Stamp of the previously selected frame.
+  double period_ns_{ 0.0 };          ///< Moving average of the frame period.
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_FRAME_DECIMATOR_H
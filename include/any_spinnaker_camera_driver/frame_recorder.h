@@ -0,0 +1,232 @@
+/**
+Software License Agreement (BSD)
+
+\file      frame_recorder.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_FRAME_RECORDER_H
+#define SPINNAKER_CAMERA_DRIVER_FRAME_RECORDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+//*******************************************
+// Flight recorder for raw camera frames.
+// Frames are copied straight into a
+// preallocated, memory-mapped segment file
+// that is used as a ring buffer. A fixed
+// size index allows random access to the
+// recorded frames without scanning the data.
+//*******************************************
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Metadata stored in front of every recorded frame. The layout is part of the on-disk format, so fields must only be
+ * appended (and FrameRecorder::VERSION increased) when it changes.
+ */
+struct FrameRecordMetadata
+{
+  uint64_t sequence{ 0 };           ///< Record number assigned by the recorder, monotonically increasing.
+  uint64_t stamp_ns{ 0 };           ///< Host time stamp of the frame (nanoseconds).
+  uint64_t hardware_stamp_ns{ 0 };  ///< Camera time stamp of the frame (nanoseconds).
+  uint64_t frame_id{ 0 };           ///< Camera frame counter.
+  uint32_t width{ 0 };
+  uint32_t height{ 0 };
+  uint32_t step{ 0 };
+  uint32_t data_size{ 0 };  ///< Size of the payload following the metadata (bytes).
+  char encoding[32]{};      ///< sensor_msgs image encoding, null terminated.
+  // Configuration in effect when the frame was captured.
+  double gain{ 0.0 };
+  double exposure_time{ 0.0 };  ///< Exposure time in microseconds, negative if controlled by the camera.
+  double white_balance_blue{ 0.0 };
+  double white_balance_red{ 0.0 };
+  uint32_t binning_x{ 1 };
+  uint32_t binning_y{ 1 };
+  uint32_t roi_x_offset{ 0 };
+  uint32_t roi_y_offset{ 0 };
+  uint32_t flags{ 0 };  ///< Payload variant, 0 for raw image data, see FRAME_RECORD_FLAG_*.
+  uint32_t reserved{ 0 };
+};
+static_assert(std::is_trivially_copyable<FrameRecordMetadata>::value, "FrameRecordMetadata is written with memcpy");
+static_assert(sizeof(FrameRecordMetadata) % 8 == 0, "FrameRecordMetadata must keep 8-byte alignment");
+
+/// FrameRecordMetadata::flags: the payload is the frame encoded by RawCodec.
+constexpr uint32_t FRAME_RECORD_FLAG_RAW_CODEC = 1;
+
+/** File header at offset 0 of every recording. */
+struct FrameRecordFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint64_t file_size;
+  uint64_t index_offset;
+  uint64_t index_capacity;
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint64_t first_sequence;  ///< Oldest record that is still valid.
+  uint64_t next_sequence;   ///< Sequence number the next record will get.
+  uint64_t write_offset;    ///< Offset (relative to data_offset) of the next record.
+  uint64_t closed;          ///< Set to 1 when the recorder was shut down cleanly.
+};
+
+/** One slot of the fixed size frame index. */
+struct FrameIndexEntry
+{
+  uint64_t sequence;
+  uint64_t offset;  ///< Offset of the record relative to data_offset.
+  uint64_t size;    ///< Size of the record including metadata and padding.
+  uint64_t stamp_ns;
+};
+
+class FrameRecorder
+{
+public:
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t RECORD_ALIGNMENT = 64;
+
+  /*!
+   * \brief Creates (or truncates) the segment file and maps it into memory.
+   *
+   * The whole file is allocated up front so that recording never has to extend it.
+   * \param path Path of the segment file.
+   * \param file_size Total size of the segment file in bytes, including header and index.
+   * \param index_capacity Maximum number of frames that can be referenced by the index.
+   * \param flush_period Period of the background flush (in seconds).
+   */
+  FrameRecorder(const std::string& path, size_t file_size, size_t index_capacity, double flush_period);
+  ~FrameRecorder();
+
+  FrameRecorder(const FrameRecorder&) = delete;
+  FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+  /*!
+   * \brief Appends a frame to the recording, overwriting the oldest frames when the file is full.
+   *
+   * Only copies into the mapped file, disk I/O is left to the background flush thread. Not thread safe, frames are
+   * expected to come from a single acquisition thread.
+   * \param metadata Frame metadata. sequence and data_size are filled in by the recorder.
+   * \param data Raw frame buffer.
+   * \param size Size of the raw frame buffer in bytes.
+   * \return False if the frame does not fit into the data segment.
+   */
+  bool record(const FrameRecordMetadata& metadata, const uint8_t* data, size_t size);
+
+  uint64_t getRecordedFrames() const
+  {
+    return recorded_frames_.load();
+  }
+
+  uint64_t getDroppedFrames() const
+  {
+    return dropped_frames_.load();
+  }
+
+  const std::string& getPath() const
+  {
+    return path_;
+  }
+
+private:
+  void flushLoop();
+  void flush();
+
+  std::string path_;
+  int fd_{ -1 };
+  uint8_t* map_{ nullptr };
+  size_t map_size_{ 0 };
+
+  FrameRecordFileHeader* header_{ nullptr };
+  FrameIndexEntry* index_{ nullptr };
+  uint8_t* data_{ nullptr };
+
+  // Writer state, mirrored into header_ after every record.
+  uint64_t first_sequence_{ 0 };
+  uint64_t next_sequence_{ 0 };
+  uint64_t write_offset_{ 0 };
+
+  /// Total number of bytes written to the data segment, including wrap gaps. Used to find the range to flush.
+  std::atomic<uint64_t> written_bytes_{ 0 };
+  uint64_t flushed_bytes_{ 0 };
+
+  std::atomic<uint64_t> recorded_frames_{ 0 };
+  std::atomic<uint64_t> dropped_frames_{ 0 };
+
+  double flush_period_;
+  bool running_{ true };
+  std::mutex flush_mutex_;
+  std::condition_variable flush_cv_;
+  std::thread flush_thread_;
+};
+
+/**
+ * Read-only access to a recording written by FrameRecorder.
+ */
+class FrameRecordReader
+{
+public:
+  explicit FrameRecordReader(const std::string& path);
+  ~FrameRecordReader();
+
+  FrameRecordReader(const FrameRecordReader&) = delete;
+  FrameRecordReader& operator=(const FrameRecordReader&) = delete;
+
+  /** Number of frames that can be read, oldest first. */
+  size_t size() const;
+
+  /*!
+   * \brief Gives access to a recorded frame.
+   *
+   * \param i Position of the frame, 0 being the oldest frame in the recording.
+   * \param metadata Filled with the frame metadata.
+   * \param data Set to the start of the frame payload inside the mapped file (valid as long as the reader lives).
+   * \return False if the record was overwritten or is corrupt.
+   */
+  bool getFrame(size_t i, FrameRecordMetadata* metadata, const uint8_t** data) const;
+
+  /** Whether the recorder that wrote the file was shut down cleanly. */
+  bool wasClosed() const
+  {
+    return header_.closed != 0;
+  }
+
+  const FrameRecordFileHeader& getHeader() const
+  {
+    return header_;
+  }
+
+private:
+  int fd_{ -1 };
+  const uint8_t* map_{ nullptr };
+  size_t map_size_{ 0 };
+  FrameRecordFileHeader header_;
+  const FrameIndexEntry* index_{ nullptr };
+  const uint8_t* data_{ nullptr };
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_FRAME_RECORDER_H
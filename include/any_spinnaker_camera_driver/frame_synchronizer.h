@@ -0,0 +1,262 @@
+/**
+Software License Agreement (BSD)
+
+\file      frame_synchronizer.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_FRAME_SYNCHRONIZER_H
+#define SPINNAKER_CAMERA_DRIVER_FRAME_SYNCHRONIZER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Pairs the frames of several cameras on a shared trigger into synchronized sets.
+ *
+ * Frames are matched by their camera time stamps. Without a clock shared between the cameras (e.g. PTP), each camera
+ * time stamp is mapped to the host clock with an offset estimated as the minimum of the receive time minus the camera
+ * time stamp over recent frames, i.e. the frame with the lowest transfer latency. Once a set was matched by time, the
+ * frame counters can be used instead: the counter offsets between the cameras are taken from that set and re-learned
+ * whenever a counter jumps back, e.g. after a camera restarted.
+ * Frames are expected in acquisition order per camera. A frame that cannot be part of any set anymore is dropped.
+ * \tparam Payload Data kept with each frame, e.g. the image message.
+ */
+template <typename Payload>
+class FrameSynchronizer
+{
+public:
+  struct Config
+  {
+    double tolerance{ 0.005 };    ///< Maximum difference of the time stamps within a set (seconds).
+    size_t queue_size{ 4 };       ///< Frames kept per camera while waiting for the others.
+    bool shared_clock{ false };   ///< The camera time stamps share a clock and are compared directly.
+    bool use_frame_ids{ false };  ///< Match by frame counter once the counter offsets are known.
+    size_t offset_window{ 64 };   ///< Frames over which the clock offsets are estimated.
+  };
+
+  struct Frame
+  {
+    uint64_t hardware_stamp_ns{ 0 };  ///< Camera time stamp.
+    uint64_t frame_id{ 0 };           ///< Camera frame counter.
+    uint64_t receive_stamp_ns{ 0 };   ///< Host time at which the frame was received.
+    int64_t stamp_ns{ 0 };            ///< Time stamp the frames are matched by, on the common clock.
+    Payload payload;
+  };
+
+  struct Set
+  {
+    std::vector<Frame> frames;  ///< One frame per camera, in camera order.
+    uint64_t stamp_ns{ 0 };     ///< Common stamp for the whole set, the earliest receive time.
+    double skew_ms{ 0.0 };      ///< Largest difference of the matched time stamps within the set.
+  };
+
+  struct Statistics
+  {
+    uint64_t frames{ 0 };   ///< Frames added.
+    uint64_t sets{ 0 };     ///< Complete sets.
+    uint64_t dropped{ 0 };  ///< Frames that did not become part of a set.
+    double last_skew_ms{ 0.0 };
+    double max_skew_ms{ 0.0 };
+    double mean_skew_ms{ 0.0 };
+
+    /** Fraction of the added frames that became part of a set. */
+    double getPairingRate(size_t streams) const
+    {
+      return frames > 0 ? static_cast<double>(sets * streams) / static_cast<double>(frames) : 0.0;
+    }
+  };
+
+  FrameSynchronizer(size_t streams, const Config& config) : config_(config), streams_(streams)
+  {
+  }
+
+  /*!
+   * \brief Adds the frame of a camera.
+   *
+   * \param stream Index of the camera.
+   * \param frame The frame, stamp_ns is filled in.
+   * \param set Set to the completed set if the frame completed one.
+   * \return True if a set was completed.
+   */
+  bool add(size_t stream, Frame frame, Set* set)
+  {
+    Stream& s = streams_[stream];
+    ++statistics_.frames;
+
+    // A counter jumping back means that the camera restarted, its offsets have to be learned again.
+    if (s.started && frame.frame_id <= s.last_frame_id)
+    {
+      resetStream(s);
+    }
+    s.started = true;
+    s.last_frame_id = frame.frame_id;
+
+    frame.stamp_ns = commonStamp(s, frame);
+    s.queue.push_back(std::move(frame));
+    if (s.queue.size() > std::max<size_t>(config_.queue_size, 1))
+    {
+      s.queue.pop_front();
+      ++statistics_.dropped;
+    }
+    return match(set);
+  }
+
+  /** Forgets all queued frames and learned offsets. */
+  void reset()
+  {
+    for (Stream& s : streams_)
+    {
+      resetStream(s);
+      s.started = false;
+    }
+  }
+
+  const Statistics& getStatistics() const
+  {
+    return statistics_;
+  }
+
+  size_t getStreamCount() const
+  {
+    return streams_.size();
+  }
+
+private:
+  struct Stream
+  {
+    std::deque<Frame> queue;
+    std::deque<int64_t> offsets;  ///< Receive time minus camera time stamp of recent frames.
+    bool has_id_offset{ false };
+    int64_t id_offset{ 0 };       ///< Frame counter minus the counter of the first camera.
+    bool started{ false };
+    uint64_t last_frame_id{ 0 };
+  };
+
+  /// Forgets the queued frames, which are counted as dropped, and the learned offsets of a stream.
+  void resetStream(Stream& s)
+  {
+    statistics_.dropped += s.queue.size();
+    s.queue.clear();
+    s.offsets.clear();
+    s.has_id_offset = false;
+  }
+
+  int64_t commonStamp(Stream& s, const Frame& frame) const
+  {
+    const int64_t stamp = static_cast<int64_t>(frame.hardware_stamp_ns);
+    if (config_.shared_clock)
+    {
+      return stamp;
+    }
+    s.offsets.push_back(static_cast<int64_t>(frame.receive_stamp_ns) - stamp);
+    if (s.offsets.size() > std::max<size_t>(config_.offset_window, 1))
+    {
+      s.offsets.pop_front();
+    }
+    return stamp + *std::min_element(s.offsets.begin(), s.offsets.end());
+  }
+
+  bool idOffsetsKnown() const
+  {
+    return std::all_of(streams_.begin(), streams_.end(), [](const Stream& s) { return s.has_id_offset; });
+  }
+
+  /// Key of a frame when matching by frame counter.
+  static int64_t idKey(const Stream& s, const Frame& frame)
+  {
+    return static_cast<int64_t>(frame.frame_id) - s.id_offset;
+  }
+
+  bool match(Set* set)
+  {
+    const int64_t tolerance_ns = static_cast<int64_t>(config_.tolerance * 1e9);
+    const bool by_id = config_.use_frame_ids && idOffsetsKnown();
+    while (std::all_of(streams_.begin(), streams_.end(), [](const Stream& s) { return !s.queue.empty(); }))
+    {
+      // The heads of the queues are the oldest frames. The oldest of them cannot match any later frame of the other
+      // cameras, so it is dropped if the heads do not form a set.
+      size_t oldest = 0;
+      int64_t min_key = std::numeric_limits<int64_t>::max();
+      int64_t max_key = std::numeric_limits<int64_t>::min();
+      int64_t min_stamp = std::numeric_limits<int64_t>::max();
+      int64_t max_stamp = std::numeric_limits<int64_t>::min();
+      for (size_t i = 0; i < streams_.size(); ++i)
+      {
+        const Frame& head = streams_[i].queue.front();
+        const int64_t key = by_id ? idKey(streams_[i], head) : head.stamp_ns;
+        if (key < min_key)
+        {
+          min_key = key;
+          oldest = i;
+        }
+        max_key = std::max(max_key, key);
+        min_stamp = std::min(min_stamp, head.stamp_ns);
+        max_stamp = std::max(max_stamp, head.stamp_ns);
+      }
+
+      if (by_id ? min_key != max_key : max_stamp - min_stamp > tolerance_ns)
+      {
+        streams_[oldest].queue.pop_front();
+        ++statistics_.dropped;
+        continue;
+      }
+
+      set->frames.clear();
+      set->stamp_ns = std::numeric_limits<uint64_t>::max();
+      for (Stream& s : streams_)
+      {
+        set->stamp_ns = std::min(set->stamp_ns, s.queue.front().receive_stamp_ns);
+        set->frames.push_back(std::move(s.queue.front()));
+        s.queue.pop_front();
+      }
+      if (!by_id)
+      {
+        // Learn the counter offsets relative to the first camera from the set matched by time.
+        for (size_t i = 0; i < streams_.size(); ++i)
+        {
+          streams_[i].id_offset =
+              static_cast<int64_t>(set->frames[i].frame_id) - static_cast<int64_t>(set->frames[0].frame_id);
+          streams_[i].has_id_offset = true;
+        }
+      }
+      set->skew_ms = static_cast<double>(max_stamp - min_stamp) * 1e-6;
+
+      ++statistics_.sets;
+      statistics_.last_skew_ms = set->skew_ms;
+      statistics_.max_skew_ms = std::max(statistics_.max_skew_ms, set->skew_ms);
+      statistics_.mean_skew_ms += (set->skew_ms - statistics_.mean_skew_ms) / static_cast<double>(statistics_.sets);
+      return true;
+    }
+    return false;
+  }
+
+  Config config_;
+  std::vector<Stream> streams_;
+  Statistics statistics_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_FRAME_SYNCHRONIZER_H
@@ -0,0 +1,110 @@
+/**
+Software License Agreement (BSD)
+
+\file      grab_recovery_policy.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_GRAB_RECOVERY_POLICY_H
+#define SPINNAKER_CAMERA_DRIVER_GRAB_RECOVERY_POLICY_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Decides how to recover from failed grabs, escalating from the cheapest action to a full reconnect.
+ *
+ * An incident starts with the first failed grab and ends with the next successful one. Within an incident each tier
+ * is used a configured number of times before the next one is tried.
+ */
+class GrabRecoveryPolicy
+{
+public:
+  enum class Tier
+  {
+    NONE,       ///< No incident.
+    RETRY,      ///< Grab again.
+    REARM,      ///< Stop and start the acquisition.
+    REINIT,     ///< Deinitialize and initialize the camera, then configure and start it again.
+    RECONNECT,  ///< Release the camera and connect to it again.
+  };
+  static constexpr size_t TIER_COUNT = 5;
+
+  struct Config
+  {
+    unsigned int retries{ 2 };  ///< Grab retries before re-arming.
+    unsigned int rearms{ 1 };   ///< Re-arms before re-initializing.
+    unsigned int reinits{ 1 };  ///< Re-initializations before reconnecting.
+  };
+
+  struct Statistics
+  {
+    uint64_t incidents{ 0 };
+    double last_downtime_ms{ 0.0 };
+    double max_downtime_ms{ 0.0 };
+    Tier last_tier{ Tier::NONE };                   ///< Highest tier reached in the last incident.
+    std::array<uint64_t, TIER_COUNT> incidents_per_tier{};  ///< Incidents by the highest tier they reached.
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  GrabRecoveryPolicy();
+  explicit GrabRecoveryPolicy(const Config& config);
+
+  void setConfig(const Config& config);
+
+  /*!
+   * \brief Reports a failed grab.
+   *
+   * \param now Time of the failure.
+   * \param device_lost The camera is known to be gone, escalates to a reconnect right away.
+   * \return The recovery action to take.
+   */
+  Tier onFailure(Clock::time_point now = Clock::now(), bool device_lost = false);
+
+  /*!
+   * \brief Reports a successful grab, ending a running incident.
+   *
+   * \param now Time of the success.
+   * \return True if an incident ended, its downtime and tier are in getStatistics().
+   */
+  bool onSuccess(Clock::time_point now = Clock::now());
+
+  Statistics getStatistics() const;
+
+  static std::string toString(Tier tier);
+
+private:
+  Config config_;
+  bool in_incident_{ false };
+  unsigned int failures_{ 0 };  ///< Failures in the running incident.
+  Tier tier_{ Tier::NONE };     ///< Highest tier of the running incident.
+  Clock::time_point incident_start_;
+
+  mutable std::mutex statistics_mutex_;
+  Statistics statistics_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_GRAB_RECOVERY_POLICY_H
@@ -0,0 +1,80 @@
+/**
+Software License Agreement (BSD)
+
+\file      image_pyramid.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_IMAGE_PYRAMID_H
+#define SPINNAKER_CAMERA_DRIVER_IMAGE_PYRAMID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Reduces images to half and quarter resolution for consumers that do not need the full frames.
+ *
+ * Both levels are computed in one pass over the source: every pair of source rows gives a half resolution row, every
+ * pair of half rows a quarter resolution row while they are still in the cache. Mono and RGB images are reduced by
+ * a 2 x 2 box filter. A 2 x 2 cell of a Bayer image becomes one RGB pixel (superpixel), so that the half resolution
+ * of Bayer images is in color without demosaicing. The row kernels are vectorized by the compiler, on x86 they are
+ * built for AVX2 and the baseline and the variant is selected at runtime.
+ */
+class ImagePyramid
+{
+public:
+  /*!
+   * \brief Encoding of the reduced images.
+   * \param encoding ROS encoding of the source, e.g. "mono8", "rgb16" or "bayer_rggb8".
+   * \param reduced_encoding Set to the encoding of both levels, e.g. "rgb8" for "bayer_rggb8".
+   * \return False if images of this encoding cannot be reduced.
+   */
+  static bool getReducedEncoding(const std::string& encoding, std::string* reduced_encoding);
+
+  /** Bytes per pixel of the reduced images, 0 if the encoding cannot be reduced. */
+  static size_t getReducedPixelSize(const std::string& encoding);
+
+  /*!
+   * \brief Reduces an image.
+   *
+   * The levels are width / 2 x height / 2 and width / 4 x height / 4 pixels, odd rows and columns are dropped. Throws a
+   * std::runtime_error if the encoding cannot be reduced.
+   * \param src First row of the source image, e.g. the data of the acquired frame.
+   * \param width Width of the source (pixels).
+   * \param height Height of the source (pixels).
+   * \param src_step Distance between two source rows (bytes).
+   * \param encoding ROS encoding of the source.
+   * \param half Output at half resolution, may be null.
+   * \param half_step Distance between two rows of the half resolution image (bytes).
+   * \param quarter Output at quarter resolution, may be null.
+   * \param quarter_step Distance between two rows of the quarter resolution image (bytes).
+   */
+  void reduce(const void* src, size_t width, size_t height, size_t src_step, const std::string& encoding, void* half,
+              size_t half_step, void* quarter, size_t quarter_step);
+
+private:
+  std::vector<uint8_t> scratch_;  ///< Half resolution rows if the half resolution is not requested.
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_IMAGE_PYRAMID_H
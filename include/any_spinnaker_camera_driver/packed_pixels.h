@@ -0,0 +1,81 @@
+/**
+Software License Agreement (BSD)
+
+\file      packed_pixels.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_PACKED_PIXELS_H
+#define SPINNAKER_CAMERA_DRIVER_PACKED_PIXELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+/// Layouts of two 12-bit pixels in three bytes.
+enum class PackedLayout
+{
+  NONE,         ///< Not a packed format.
+  LSB_PACKED,   ///< PFNC "12p" formats, e.g. Mono12p: low byte of the first pixel first.
+  MSB_PACKED,   ///< GigE Vision "12Packed" formats, e.g. Mono12Packed: high bits of each pixel in a byte of its own.
+};
+
+/*!
+ * \brief Finds the packing of a pixel format.
+ * \param pixel_format Name of the pixel format, e.g. "BayerRG12p" or "Mono12Packed".
+ * \return NONE if the format is not a 12-bit packed format.
+ */
+PackedLayout getPackedLayout(const std::string& pixel_format);
+
+/*!
+ * \brief Image encoding for packed frames that are published without unpacking.
+ *
+ * The encoding is the lower case ROS name of the unpacked format with the packing as suffix, e.g. "mono12p" or
+ * "bayer_rggb12packed".
+ * \param unpacked_encoding ROS encoding of the unpacked 16-bit image, e.g. "mono16" or "bayer_rggb16".
+ */
+std::string getPackedEncoding(const std::string& unpacked_encoding, PackedLayout layout);
+
+/** Bytes of a row of packed pixels. */
+inline size_t getPackedRowSize(size_t width)
+{
+  return (width * 3 + 1) / 2;
+}
+
+/*!
+ * \brief Unpacks 12-bit pixels to 16 bit.
+ *
+ * The values are shifted to the upper 12 bits, so that the unpacked image uses the range of a 16-bit image like the
+ * 16-bit pixel formats of the camera. On x86 the kernel is built for AVX2 and the baseline and the variant is
+ * selected at runtime, on ARM NEON is part of the baseline.
+ * \param src First row of the packed image.
+ * \param width Width of the image (pixels).
+ * \param height Height of the image (pixels).
+ * \param src_step Distance between two packed rows (bytes), at least getPackedRowSize(width).
+ * \param layout Packing of the source, not NONE.
+ * \param dst First row of the unpacked image.
+ * \param dst_step Distance between two unpacked rows (bytes), at least 2 * width.
+ */
+void unpack12(const uint8_t* src, size_t width, size_t height, size_t src_step, PackedLayout layout, uint16_t* dst,
+              size_t dst_step);
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_PACKED_PIXELS_H
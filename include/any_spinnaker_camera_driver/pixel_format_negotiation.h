@@ -0,0 +1,84 @@
+/**
+Software License Agreement (BSD)
+
+\file      pixel_format_negotiation.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_PIXEL_FORMAT_NEGOTIATION_H
+#define SPINNAKER_CAMERA_DRIVER_PIXEL_FORMAT_NEGOTIATION_H
+
+#include <string>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/// Value of image_format_color_coding that lets the driver pick the pixel format.
+extern const char* const AUTO_PIXEL_FORMAT;
+
+/// The kinds of images the active output topics need.
+struct OutputDemand
+{
+  bool raw{ false };    ///< The frame as the sensor delivers it, e.g. image_raw, its compressed forms or the recorder.
+  bool color{ false };  ///< A color image, e.g. image_color.
+  bool mono{ false };   ///< A mono image, e.g. image_mono.
+
+  bool operator==(const OutputDemand& other) const
+  {
+    return raw == other.raw && color == other.color && mono == other.mono;
+  }
+};
+
+/// Result of negotiatePixelFormat().
+struct PixelFormatChoice
+{
+  std::string pixel_format;       ///< Pixel format for the camera, empty if none of the available ones fits.
+  double bytes_per_pixel{ 0.0 };  ///< Link bandwidth of the pixel format.
+  /// Format the camera would have to send to serve the demand without conversion on the host, e.g. "RGB8".
+  std::string reference_format;
+  double reference_bytes_per_pixel{ 0.0 };
+
+  /** Share of the link bandwidth of the reference format that is saved, 0 if nothing is. */
+  double getSavings() const
+  {
+    return reference_bytes_per_pixel > bytes_per_pixel ? 1.0 - bytes_per_pixel / reference_bytes_per_pixel : 0.0;
+  }
+};
+
+/*!
+ * \brief Bytes per pixel of a GenICam pixel format.
+ * \param pixel_format E.g. "BayerRG8", "Mono12p" or "RGB8Packed".
+ * \return 0 for unknown formats.
+ */
+double getBytesPerPixel(const std::string& pixel_format);
+
+/*!
+ * \brief Picks the most compact 8-bit pixel format that serves the demand, with color and mono converted on the host.
+ *
+ * Color sensors deliver Bayer frames, which the host demosaics for color and mono topics. Only when nothing but mono
+ * images are needed, the camera converts to Mono8 itself, which costs the same bandwidth and saves the host the
+ * conversion. Mono sensors deliver Mono8. Without any demand the raw frames are assumed, so that the format does not
+ * change when the last subscriber leaves.
+ * \param available_formats Pixel formats the camera offers in its current configuration.
+ * \param demand The images the active topics need.
+ */
+PixelFormatChoice negotiatePixelFormat(const std::vector<std::string>& available_formats, const OutputDemand& demand);
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_PIXEL_FORMAT_NEGOTIATION_H
@@ -0,0 +1,137 @@
+/**
+Software License Agreement (BSD)
+
+\file      raw_codec.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_RAW_CODEC_H
+#define SPINNAKER_CAMERA_DRIVER_RAW_CODEC_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/** Header in front of every frame encoded by RawCodec, followed by the sizes of the stripes and the stripes. */
+struct RawCodecHeader
+{
+  char magic[4];       ///< "RAWC".
+  uint16_t version;
+  uint8_t bit_depth;   ///< 8 or 16.
+  uint8_t shift;       ///< Low bits that are 0 in all pixels, e.g. 4 for unpacked 12-bit frames, removed before coding.
+  uint32_t width;
+  uint32_t height;
+  uint32_t stripes;    ///< Bands of rows coded independently of each other.
+  char encoding[32];   ///< sensor_msgs image encoding, null terminated.
+};
+static_assert(std::is_trivially_copyable<RawCodecHeader>::value, "RawCodecHeader is written with memcpy");
+
+/**
+ * Lossless codec for the raw Bayer and mono frames of the driver.
+ *
+ * The four color planes of a Bayer frame are separated, so that each pixel is predicted from its neighbors of the
+ * same color. The prediction (median edge detector, as in JPEG-LS) is subtracted and the residuals are coded with a
+ * Rice code whose parameter adapts to every block of 32 residuals. The rows are split into stripes that are encoded
+ * concurrently by a small pool of threads, the calling thread encodes the first stripe. The row kernels are written to
+ * be vectorized by the compiler, on x86 they are built for AVX2 and the baseline.
+ *
+ * Supported encodings are mono8, mono16 and the 8 and 16-bit Bayer encodings.
+ */
+class RawCodec
+{
+public:
+  static constexpr uint16_t VERSION = 1;
+
+  /*!
+   * \param threads Number of threads encoding a frame including the calling one, at least 1. It is also the number
+   * of stripes of a frame.
+   */
+  explicit RawCodec(unsigned int threads);
+  ~RawCodec();
+
+  RawCodec(const RawCodec&) = delete;
+  RawCodec& operator=(const RawCodec&) = delete;
+
+  /** True if frames with the encoding can be encoded. */
+  static bool isSupported(const std::string& encoding);
+
+  /*!
+   * \brief Encodes a frame.
+   *
+   * Must not be called concurrently. Throws a std::runtime_error if the encoding is not supported.
+   * \param src First row of the frame.
+   * \param width Width of the frame (pixels).
+   * \param height Height of the frame (pixels).
+   * \param step Distance between two rows of the frame (bytes).
+   * \param encoding sensor_msgs image encoding of the frame, 16-bit pixels are in host byte order.
+   * \param encoded Replaced by the encoded frame.
+   */
+  void encode(const void* src, size_t width, size_t height, size_t step, const std::string& encoding,
+              std::vector<uint8_t>* encoded);
+
+  /*!
+   * \brief Reads the header of an encoded frame.
+   * \return False if the data does not start with a header of this version.
+   */
+  static bool readHeader(const uint8_t* data, size_t size, RawCodecHeader* header);
+
+  /*!
+   * \brief Decodes a frame.
+   *
+   * Throws a std::runtime_error if the data is not a valid encoded frame.
+   * \param data The encoded frame.
+   * \param size Size of the encoded frame (bytes).
+   * \param header Filled with the header, which holds the size and encoding of the frame.
+   * \param image Replaced by the pixels, the rows are not padded.
+   */
+  static void decode(const uint8_t* data, size_t size, RawCodecHeader* header, std::vector<uint8_t>* image);
+
+  unsigned int getThreads() const
+  {
+    return static_cast<unsigned int>(workers_.size() + 1);
+  }
+
+private:
+  /** Runs job(stripe) for all stripes, stripe 0 on the calling thread. */
+  void runStripes(const std::function<void(size_t)>& job);
+  void workerLoop(size_t stripe);
+
+  std::vector<std::vector<uint8_t>> stripe_data_;  ///< Encoded stripes.
+  std::vector<std::vector<uint8_t>> scratch_;      ///< Plane rows and residuals of one row per stripe.
+  std::vector<std::thread> workers_;               ///< Encode the stripes 1 to n.
+
+  std::mutex mutex_;
+  std::condition_variable job_cv_;   ///< Notifies the workers of a new job.
+  std::condition_variable done_cv_;  ///< Notifies the caller that a worker finished its stripe.
+  const std::function<void(size_t)>* job_{ nullptr };
+  uint64_t generation_{ 0 };  ///< Incremented for every job.
+  size_t pending_{ 0 };       ///< Workers still encoding their stripe of the current job.
+  bool stop_{ false };
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_RAW_CODEC_H
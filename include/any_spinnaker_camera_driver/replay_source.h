@@ -0,0 +1,69 @@
+/**
+Software License Agreement (BSD)
+
+\file      replay_source.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_REPLAY_SOURCE_H
+#define SPINNAKER_CAMERA_DRIVER_REPLAY_SOURCE_H
+
+#include <sensor_msgs/Image.h>
+
+#include <memory>
+#include <string>
+
+//*******************************************
+// Sources of previously recorded frames, so
+// that the nodelet can run its publish
+// pipeline without a camera attached.
+//*******************************************
+
+namespace any_spinnaker_camera_driver
+{
+class ReplaySource
+{
+public:
+  virtual ~ReplaySource() = default;
+
+  /*!
+   * \brief Reads the next recorded frame.
+   *
+   * \param image Filled with the frame. The header stamp is the time stamp the frame was recorded with.
+   * \return False at the end of the recording.
+   */
+  virtual bool next(sensor_msgs::Image* image) = 0;
+
+  /*!
+   * \brief Restarts the replay at the first recorded frame.
+   */
+  virtual void rewind() = 0;
+
+  /*!
+   * \brief Opens a recording.
+   *
+   * Files ending in '.bag' are read as rosbags, all other files as flight recorder files (see FrameRecorder).
+   * \param path Path of the recording.
+   * \param topic Only for rosbags: name of the image topic to replay. Topics in the bag match if they end with it.
+   */
+  static std::unique_ptr<ReplaySource> create(const std::string& path, const std::string& topic);
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_REPLAY_SOURCE_H
@@ -0,0 +1,136 @@
+/**
+Software License Agreement (BSD)
+
+\file      seqlock.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_SEQLOCK_H
+#define SPINNAKER_CAMERA_DRIVER_SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Value that is rarely written and read often from another thread, e.g. for every frame.
+ *
+ * Reads never block and never see a partially written value: a reader copies the value and retries if a write
+ * happened in between, detected with a sequence number that is odd while a write is in progress. The value is kept in
+ * relaxed atomic words, so that a read racing with a write is well defined. Writers are serialized by a mutex.
+ * \tparam T Trivially copyable value.
+ */
+template <typename T>
+class SeqLock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied word by word");
+
+public:
+  explicit SeqLock(const T& value = T())
+  {
+    storeWords(value);
+  }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  /** Reads a consistent copy of the value, without locking. */
+  T load() const
+  {
+    uint64_t words[WORDS];
+    while (true)
+    {
+      const uint64_t sequence = sequence_.load(std::memory_order_acquire);
+      if ((sequence & 1) == 0)
+      {
+        for (size_t i = 0; i < WORDS; ++i)
+        {
+          words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == sequence)
+        {
+          break;
+        }
+      }
+    }
+    T value;
+    std::memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+  /** Replaces the value. */
+  void store(const T& value)
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    write(value);
+  }
+
+  /*!
+   * \brief Changes parts of the value, without losing concurrent changes of other writers.
+   * \param change Called with a pointer to a copy of the current value to change.
+   */
+  template <typename Change>
+  void modify(Change change)
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    T value = load();
+    change(&value);
+    write(value);
+  }
+
+  /** Number of completed writes. */
+  uint64_t getVersion() const
+  {
+    return sequence_.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  void write(const T& value)
+  {
+    const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    storeWords(value);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  void storeWords(const T& value)
+  {
+    uint64_t words[WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+    for (size_t i = 0; i < WORDS; ++i)
+    {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<uint64_t> sequence_{ 0 };
+  std::atomic<uint64_t> words_[WORDS];
+  std::mutex write_mutex_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_SEQLOCK_H
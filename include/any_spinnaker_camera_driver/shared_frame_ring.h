@@ -0,0 +1,183 @@
+/**
+Software License Agreement (BSD)
+
+\file      shared_frame_ring.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_SHARED_FRAME_RING_H
+#define SPINNAKER_CAMERA_DRIVER_SHARED_FRAME_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+//*******************************************
+// Ring of frame slots in POSIX shared memory.
+// The driver copies each frame into a free
+// slot once, consumers in other processes
+// read it in place. Only a small descriptor
+// (slot, sequence) travels over ROS.
+//*******************************************
+
+namespace any_spinnaker_camera_driver
+{
+/** Shared memory header, followed by the slot table and the slot data. */
+struct SharedFrameRingHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t slot_count;
+  uint64_t ring_id;  ///< Changes whenever a producer (re)creates the ring.
+  uint64_t slot_size;
+  uint64_t slot_table_offset;
+  uint64_t data_offset;
+};
+
+/// Maximum number of consumer processes holding the same slot at a time.
+constexpr uint32_t SHARED_FRAME_SLOT_HOLDERS = 14;
+
+struct alignas(64) SharedFrameSlot
+{
+  /// Non-zero while the producer fills the slot.
+  std::atomic<uint32_t> writing;
+  uint32_t size;
+  /// Sequence number of the frame in the slot, consumers check it to detect overwritten frames.
+  std::atomic<uint64_t> sequence;
+  /// References of the consumer processes holding the slot, the pid in the upper and the count in the lower 32 bits,
+  /// 0 if unused. The producer reclaims the references of processes that died without releasing them.
+  std::atomic<uint64_t> holders[SHARED_FRAME_SLOT_HOLDERS];
+};
+
+/**
+ * Producer side of the ring, owned by the driver.
+ */
+class SharedFrameRing
+{
+public:
+  static constexpr uint32_t VERSION = 2;
+
+  /*!
+   * \brief Creates the shared memory object, replacing a stale one with the same name.
+   *
+   * \param name Name of the POSIX shared memory object, e.g. "spinnaker_12345678".
+   * \param slot_count Number of frame slots.
+   * \param slot_size Maximum frame size in bytes.
+   */
+  SharedFrameRing(const std::string& name, uint32_t slot_count, size_t slot_size);
+  ~SharedFrameRing();
+
+  SharedFrameRing(const SharedFrameRing&) = delete;
+  SharedFrameRing& operator=(const SharedFrameRing&) = delete;
+
+  /*!
+   * \brief Copies a frame into the least recently written slot that no consumer holds.
+   *
+   * References held by consumer processes that no longer exist are reclaimed.
+   *
+   * \param data Frame buffer.
+   * \param size Size of the frame buffer in bytes.
+   * \param slot Set to the slot the frame was written to.
+   * \param sequence Set to the sequence number of the frame.
+   * \return False if the frame is too large or all slots are held by consumers.
+   */
+  bool write(const uint8_t* data, size_t size, uint32_t* slot, uint64_t* sequence);
+
+  const std::string& getName() const
+  {
+    return name_;
+  }
+
+  uint64_t getRingId() const
+  {
+    return header_->ring_id;
+  }
+
+  size_t getSlotSize() const
+  {
+    return header_->slot_size;
+  }
+
+  uint64_t getDroppedFrames() const
+  {
+    return dropped_frames_.load();
+  }
+
+  /// Number of slot references reclaimed from consumers that died while holding them.
+  uint64_t getReclaimedReferences() const
+  {
+    return reclaimed_references_.load();
+  }
+
+private:
+  /// Returns true if a living consumer holds the slot, reclaims the references of dead ones.
+  bool isHeld(SharedFrameSlot& slot);
+
+  std::string name_;
+  uint8_t* map_{ nullptr };
+  size_t map_size_{ 0 };
+  SharedFrameRingHeader* header_{ nullptr };
+  SharedFrameSlot* slots_{ nullptr };
+  uint8_t* data_{ nullptr };
+
+  uint32_t next_slot_{ 0 };
+  uint64_t sequence_{ 0 };
+  std::atomic<uint64_t> dropped_frames_{ 0 };
+  std::atomic<uint64_t> reclaimed_references_{ 0 };
+};
+
+/** A frame held in a ring slot. The slot stays reserved until the last copy of the pointer is released. */
+struct SharedFrame
+{
+  const uint8_t* data;
+  size_t size;
+};
+
+/**
+ * Consumer side of the ring, used by processes receiving SharedFrameDescriptor messages.
+ */
+class SharedFrameRingClient
+{
+public:
+  SharedFrameRingClient();
+  ~SharedFrameRingClient();
+
+  /*!
+   * \brief Reserves the slot named by a descriptor and gives read access to its frame.
+   *
+   * Maps the ring on first use, and again when the producer recreated it.
+   * \param name Name of the shared memory object (ring_name of the descriptor).
+   * \param ring_id Ring id of the descriptor.
+   * \param slot Slot of the descriptor.
+   * \param sequence Sequence number of the descriptor.
+   * \return The frame, or null if it was overwritten already, the slot has too many holders or the ring is not
+   * available.
+   */
+  std::shared_ptr<const SharedFrame> acquire(const std::string& name, uint64_t ring_id, uint32_t slot,
+                                             uint64_t sequence);
+
+private:
+  struct Mapping;
+  std::shared_ptr<Mapping> mapping_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_SHARED_FRAME_RING_H
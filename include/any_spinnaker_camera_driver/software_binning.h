@@ -0,0 +1,122 @@
+/**
+Software License Agreement (BSD)
+
+\file      software_binning.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_SOFTWARE_BINNING_H
+#define SPINNAKER_CAMERA_DRIVER_SOFTWARE_BINNING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Binning and decimation on the host, for the factors the camera cannot apply itself.
+ *
+ * Bayer frames are binned and decimated in units of 2 x 2 cells, so pixels are only combined with pixels of the same
+ * color and the output keeps the Bayer pattern of the input. Mono frames are processed per pixel. The binned blocks are
+ * taken every decimation_x blocks horizontally and every decimation_y blocks vertically, trailing pixels that do not
+ * fill a block are dropped, like the camera does. The rows are accumulated with kernels written to be vectorized by the
+ * compiler, on x86 they are built for AVX2 and the baseline.
+ *
+ * Supported encodings are mono8, mono16 and the 8 and 16-bit Bayer encodings.
+ */
+class SoftwareBinning
+{
+public:
+  enum class Mode
+  {
+    SUM,      ///< Sum of the binned pixels, saturated at the maximum value of the encoding.
+    AVERAGE,  ///< Rounded average of the binned pixels.
+  };
+
+  /*!
+   * \param binning_x Pixels combined horizontally, at least 1.
+   * \param binning_y Pixels combined vertically, at least 1.
+   * \param decimation_x Horizontal decimation after the binning, at least 1.
+   * \param decimation_y Vertical decimation after the binning, at least 1.
+   * \param mode How the binned pixels are combined.
+   */
+  SoftwareBinning(unsigned int binning_x, unsigned int binning_y, unsigned int decimation_x,
+                  unsigned int decimation_y, Mode mode);
+
+  /*!
+   * \brief Reads the mode from its parameter name.
+   * \param name "sum" or "average".
+   * \return False if the name is unknown.
+   */
+  static bool parseMode(const std::string& name, Mode* mode);
+
+  /** True if frames with the encoding can be binned. */
+  static bool isSupported(const std::string& encoding);
+
+  /** True if the frames are left as they are. */
+  bool isIdentity() const;
+
+  /** Horizontal size reduction, binning times decimation. */
+  unsigned int getFactorX() const
+  {
+    return binning_x_ * decimation_x_;
+  }
+
+  /** Vertical size reduction, binning times decimation. */
+  unsigned int getFactorY() const
+  {
+    return binning_y_ * decimation_y_;
+  }
+
+  /*!
+   * \brief Computes the size of a processed frame.
+   *
+   * Throws a std::runtime_error if the encoding is not supported.
+   */
+  void getOutputSize(size_t width, size_t height, const std::string& encoding, size_t* output_width,
+                     size_t* output_height) const;
+
+  /*!
+   * \brief Bins and decimates a frame.
+   *
+   * Must not be called concurrently. Throws a std::runtime_error if the encoding is not supported.
+   * \param src First row of the frame.
+   * \param width Width of the frame (pixels).
+   * \param height Height of the frame (pixels).
+   * \param src_step Distance between two rows of the frame (bytes).
+   * \param encoding sensor_msgs image encoding of the frame, 16-bit pixels are in host byte order.
+   * \param dst First row of the output, of the size returned by getOutputSize().
+   * \param dst_step Distance between two rows of the output (bytes).
+   */
+  void process(const void* src, size_t width, size_t height, size_t src_step, const std::string& encoding, void* dst,
+               size_t dst_step);
+
+private:
+  unsigned int binning_x_;
+  unsigned int binning_y_;
+  unsigned int decimation_x_;
+  unsigned int decimation_y_;
+  Mode mode_;
+  std::vector<uint32_t> accumulator_;  ///< Sum of the binned rows of one output row.
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_SOFTWARE_BINNING_H
@@ -0,0 +1,119 @@
+/**
+Software License Agreement (BSD)
+
+\file      startup_orchestrator.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_STARTUP_ORCHESTRATOR_H
+#define SPINNAKER_CAMERA_DRIVER_STARTUP_ORCHESTRATOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Coordinates the bring-up (connect, Init and configuration) of all cameras of a process.
+ *
+ * The cameras bring themselves up concurrently on their own threads, which act as the workers of a pool with a
+ * bounded number of slots, so that a rig does not saturate the bus or the host while initializing. The bring-up time
+ * of every camera and of the whole rig is recorded, from the registration of the first camera until all registered
+ * cameras were brought up once. All methods are thread safe.
+ */
+class StartupOrchestrator
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct CameraTiming
+  {
+    unsigned int attempts{ 0 };  ///< Bring-up attempts, including the failed ones.
+    double wait_ms{ 0.0 };       ///< Time the successful attempt waited for a slot.
+    double bring_up_ms{ 0.0 };   ///< Duration of the successful attempt.
+    double ready_ms{ 0.0 };      ///< Time from the registration of the first camera until this camera was up.
+    bool ready{ false };
+  };
+
+  /*!
+   * \brief The orchestrator of the process, created on first use and destroyed when the last user releases it.
+   */
+  static std::shared_ptr<StartupOrchestrator> instance();
+
+  StartupOrchestrator(const StartupOrchestrator&) = delete;
+  StartupOrchestrator& operator=(const StartupOrchestrator&) = delete;
+
+  /*!
+   * \brief Limits the number of cameras that are brought up at the same time.
+   *
+   * \param slots Maximum number of concurrent bring-ups, 0 for no limit. The smallest limit requested by any camera
+   * applies.
+   */
+  void setMaxParallel(unsigned int slots);
+
+  /** Announces a camera, the rig is complete once all announced cameras were brought up. */
+  void registerCamera(const std::string& name);
+
+  /** Removes a camera that will not be brought up, e.g. because its driver shuts down. Ends its wait for a slot. */
+  void unregisterCamera(const std::string& name);
+
+  /*!
+   * \brief Runs the bring-up of a camera on the calling thread as soon as a slot is free.
+   *
+   * Exceptions of the bring-up are passed on, the attempt is counted and the camera is expected to try again. The
+   * bring-up should only start once the camera is known to be present, an absent camera would hold its slot until the
+   * connection times out.
+   * \throw std::runtime_error if the camera is not registered, or was unregistered while waiting for a slot.
+   * \param name Name the camera was registered with.
+   * \param bring_up Connects and configures the camera.
+   * \return True if this bring-up completed the rig.
+   */
+  bool run(const std::string& name, const std::function<void()>& bring_up);
+
+  CameraTiming getTiming(const std::string& name) const;
+
+  /** Time from the registration of the first camera until all were up (ms), 0 while the rig is incomplete. */
+  double getTotalMs() const;
+
+  /** Summary of all cameras, e.g. "left 812.3 ms (waited 0.0 ms), right 790.1 ms (waited 0.0 ms), total 815.2 ms". */
+  std::string toString() const;
+
+private:
+  StartupOrchestrator() = default;
+
+  bool isComplete() const;
+  double sinceOrigin(Clock::time_point time) const;
+
+  mutable std::mutex mutex_;
+  std::condition_variable slot_cv_;
+  unsigned int max_parallel_{ 0 };
+  unsigned int running_{ 0 };
+  bool has_origin_{ false };
+  Clock::time_point origin_;  ///< Registration of the first camera.
+  double total_ms_{ 0.0 };
+  std::map<std::string, CameraTiming> cameras_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_STARTUP_ORCHESTRATOR_H
@@ -0,0 +1,112 @@
+/**
+Software License Agreement (BSD)
+
+\file      startup_profiler.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_STARTUP_PROFILER_H
+#define SPINNAKER_CAMERA_DRIVER_STARTUP_PROFILER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Records the duration of the phases from the start of the driver to its first frame.
+ *
+ * Phases are recorded until finish() is called, later calls are ignored so that reconnects do not overwrite the
+ * startup profile. All methods are thread safe.
+ */
+class StartupProfiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Phase
+  {
+    std::string name;
+    double start_ms;     ///< Start relative to the origin of the profile.
+    double duration_ms;  ///< 0 for events without duration.
+  };
+
+  /** Starts the profile now. */
+  StartupProfiler();
+
+  /** Marks the start of a phase. */
+  void begin(const std::string& name);
+
+  /** Marks the end of the last started phase with this name. */
+  void end(const std::string& name);
+
+  /** Records the end of the startup, e.g. the first frame, and stops recording. */
+  void finish(const std::string& name);
+
+  bool isFinished() const;
+
+  std::vector<Phase> getPhases() const;
+
+  /** Time from the origin to finish() (ms), or the time elapsed so far if not finished. */
+  double getTotalMs() const;
+
+  /** Summary of all phases, e.g. "enumerate 12.0 ms @ 3.1, init 240.5 ms @ 15.1, first_frame @ 702.3". */
+  std::string toString() const;
+
+private:
+  double sinceOrigin(Clock::time_point time) const;
+
+  mutable std::mutex mutex_;
+  Clock::time_point origin_;
+  Clock::time_point finish_time_;
+  bool finished_{ false };
+  std::vector<Phase> phases_;
+  std::vector<Clock::time_point> phase_starts_;
+};
+
+/**
+ * Records a phase for the lifetime of the object.
+ */
+class ScopedStartupPhase
+{
+public:
+  ScopedStartupPhase(StartupProfiler* profiler, const std::string& name) : profiler_(profiler), name_(name)
+  {
+    if (profiler_ != nullptr)
+      profiler_->begin(name_);
+  }
+
+  ~ScopedStartupPhase()
+  {
+    if (profiler_ != nullptr)
+      profiler_->end(name_);
+  }
+
+  ScopedStartupPhase(const ScopedStartupPhase&) = delete;
+  ScopedStartupPhase& operator=(const ScopedStartupPhase&) = delete;
+
+private:
+  StartupProfiler* profiler_;
+  std::string name_;
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_STARTUP_PROFILER_H
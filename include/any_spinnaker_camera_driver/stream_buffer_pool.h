@@ -0,0 +1,115 @@
+/**
+Software License Agreement (BSD)
+
+\file      stream_buffer_pool.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_STREAM_BUFFER_POOL_H
+#define SPINNAKER_CAMERA_DRIVER_STREAM_BUFFER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Page-aligned memory for the stream buffers of a camera, handed to the SDK as user buffers.
+ *
+ * The memory is kept across stream restarts and only reallocated if a larger payload needs it, so that starting the
+ * acquisition does not allocate.
+ */
+class StreamBufferPool
+{
+public:
+  /*!
+   * \param huge_pages Back the buffers with huge pages if the system provides them, falls back to normal pages.
+   * \param lock Lock the buffers into memory, continues unlocked if the memlock limit does not allow it.
+   */
+  StreamBufferPool(bool huge_pages, bool lock);
+  ~StreamBufferPool();
+
+  StreamBufferPool(const StreamBufferPool&) = delete;
+  StreamBufferPool& operator=(const StreamBufferPool&) = delete;
+
+  /*!
+   * \brief Makes sure the pool holds the given number of buffers of at least the given size.
+   *
+   * Reallocates only if the current memory is too small. Must not be called while the SDK uses the buffers.
+   * \param buffer_count Number of stream buffers.
+   * \param payload_size Size of one frame as reported by the camera (bytes).
+   */
+  void reserve(size_t buffer_count, size_t payload_size);
+
+  /** Start of the contiguous buffer memory. */
+  void* data() const
+  {
+    return memory_;
+  }
+
+  /** Size of the memory to hand to the SDK, a multiple of the buffer size. */
+  size_t totalSize() const
+  {
+    return buffer_count_ * buffer_size_;
+  }
+
+  /** Size of one buffer, the payload size rounded up to whole pages. */
+  size_t bufferSize() const
+  {
+    return buffer_size_;
+  }
+
+  size_t bufferCount() const
+  {
+    return buffer_count_;
+  }
+
+  bool isHugePageBacked() const
+  {
+    return huge_page_backed_.load();
+  }
+
+  bool isLocked() const
+  {
+    return locked_.load();
+  }
+
+  /** Number of times memory was allocated, stays constant over stream restarts once the payload is stable. */
+  uint64_t getAllocations() const
+  {
+    return allocations_.load();
+  }
+
+private:
+  void release();
+
+  bool huge_pages_;
+  bool lock_;
+  void* memory_{ nullptr };
+  size_t mapped_size_{ 0 };
+  size_t buffer_count_{ 0 };
+  size_t buffer_size_{ 0 };
+  std::atomic<bool> huge_page_backed_{ false };
+  std::atomic<bool> locked_{ false };
+  std::atomic<uint64_t> allocations_{ 0 };
+};
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_STREAM_BUFFER_POOL_H
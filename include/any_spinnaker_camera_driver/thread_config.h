@@ -0,0 +1,82 @@
+/**
+Software License Agreement (BSD)
+
+\file      thread_config.h
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef SPINNAKER_CAMERA_DRIVER_THREAD_CONFIG_H
+#define SPINNAKER_CAMERA_DRIVER_THREAD_CONFIG_H
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/// Scheduling requested for a driver thread.
+struct ThreadConfig
+{
+  std::string policy{ "other" };  ///< "other", "fifo" or "rr".
+  int priority{ 0 };              ///< Real-time priority, ignored for "other".
+  std::vector<int> cpus;          ///< CPUs the thread may run on, empty for all.
+  size_t prefault_stack_size{ 0 };  ///< Bytes of stack to touch once, so that the thread does not page fault later.
+};
+
+/// Scheduling a thread actually runs with.
+struct ThreadConfigResult
+{
+  std::string policy;
+  int priority{ 0 };
+  std::string cpus;   ///< Affinity as a list, e.g. "2,3", or "all".
+  bool complete{ true };  ///< False if part of the requested config could not be applied.
+  std::string message;    ///< Reasons for anything not applied.
+
+  /** One line summary for logs and diagnostics, e.g. "fifo 50 on cpus 2,3". */
+  std::string toString() const;
+};
+
+/*!
+ * \brief Applies a scheduling config to a thread.
+ *
+ * Real-time policies need CAP_SYS_NICE or an rtprio limit. Without them the thread keeps its current policy and the
+ * failure is reported in the result instead of being treated as an error.
+ * \param thread The thread to configure.
+ * \param config The requested scheduling.
+ * \return The scheduling the thread runs with afterwards.
+ */
+ThreadConfigResult applyThreadConfig(pthread_t thread, const ThreadConfig& config);
+
+/*!
+ * \brief Touches the given amount of stack of the calling thread, so that its pages are resident.
+ */
+void prefaultStack(size_t size);
+
+/*!
+ * \brief Locks all current and future pages of the process into memory.
+ *
+ * \param error Set to the reason if locking failed.
+ * \return True on success.
+ */
+bool lockProcessMemory(std::string* error);
+}  // namespace any_spinnaker_camera_driver
+#endif  // SPINNAKER_CAMERA_DRIVER_THREAD_CONFIG_H
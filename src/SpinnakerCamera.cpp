@@ -42,31 +42,32 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "any_spinnaker_camera_driver/SpinnakerCamera.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <typeinfo>
 #include <string>
+#include <thread>
 
 #include <ros/ros.h>
+#include <dynamic_reconfigure/Config.h>
 
 namespace any_spinnaker_camera_driver
 {
 SpinnakerCamera::SpinnakerCamera()
   : serial_(0)
-  , system_(Spinnaker::System::GetInstance())
-  , camList_(system_->GetCameras())
+  , registry_(DeviceRegistry::instance())
   , pCam_(static_cast<int>(NULL))  // Hack to suppress compiler warning. Spinnaker has only one contructor which takes
                                    // an int
   , camera_(static_cast<int>(NULL))
   , captureRunning_(false)
 {
-  unsigned int num_cameras = camList_.GetSize();
-  ROS_DEBUG_STREAM_ONCE("[SpinnakerCamera]: Number of cameras detected: " << num_cameras);
 }
 
 SpinnakerCamera::~SpinnakerCamera()
 {
-  // @note ebretl Destructors of camList_ and system_ handle teardown
+  // @note ebretl Destructors of pCam_ and registry_ handle teardown
 }
 
 void SpinnakerCamera::setNewConfiguration(const any_spinnaker_camera_driver::SpinnakerConfig& config, const uint32_t& level)
@@ -94,7 +95,9 @@ void SpinnakerCamera::setNewConfiguration(const any_spinnaker_camera_driver::Spi
       throw std::runtime_error("Failed to restart the camera: " + std::string(e.what()));
     }
 
-    camera_->setNewConfiguration(config, level);
+    const any_spinnaker_camera_driver::SpinnakerConfig resolved = resolvePixelFormat(config);
+    camera_->setNewConfiguration(resolved, level);
+    updateSoftwareBinning(resolved);
     if (capture_was_running)
       start();
   }
@@ -104,6 +107,265 @@ void SpinnakerCamera::setNewConfiguration(const any_spinnaker_camera_driver::Spi
   }
 }  // end setNewConfiguration
 
+bool SpinnakerCamera::restoreConfiguration(const any_spinnaker_camera_driver::SpinnakerConfig& config, bool warm_up)
+{
+  // Check if camera is connected
+  if (!pCam_)
+  {
+    SpinnakerCamera::connect();
+  }
+
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  if (captureRunning_)
+  {
+    throw std::runtime_error(
+        "[SpinnakerCamera::restoreConfiguration] The acquisition has to be stopped to configure the camera.");
+  }
+
+  const any_spinnaker_camera_driver::SpinnakerConfig resolved = resolvePixelFormat(config);
+  const uint64_t hash = configurationHash(resolved);
+  if (!user_set_.empty() && user_set_hash_ == hash)
+  {
+    try
+    {
+      camera_->loadUserSet(user_set_);
+      updateSoftwareBinning(resolved);
+      ROS_DEBUG_STREAM("[SpinnakerCamera::restoreConfiguration] Loaded the configuration from " << user_set_ << ".");
+      return true;
+    }
+    catch (const std::runtime_error& e)
+    {
+      ROS_WARN_STREAM("[SpinnakerCamera::restoreConfiguration] Writing the configuration instead: " << e.what());
+    }
+  }
+
+  if (warm_up)
+  {
+    // For some reason some params only work after acquisition has been started once.
+    try
+    {
+      start();
+      stop();
+    }
+    catch (const std::runtime_error& e)
+    {
+      throw std::runtime_error("Failed to restart the camera: " + std::string(e.what()));
+    }
+  }
+  camera_->setNewConfiguration(resolved, LEVEL_RECONFIGURE_STOP);
+  updateSoftwareBinning(resolved);
+
+  if (!user_set_.empty() && user_set_hash_ != hash)
+  {
+    // Only stored when the configuration changed, as every save writes the non-volatile memory of the camera.
+    user_set_hash_ = 0;
+    try
+    {
+      camera_->saveUserSet(user_set_);
+      user_set_hash_ = hash;
+      ROS_INFO_STREAM("[SpinnakerCamera::restoreConfiguration] Stored the configuration in " << user_set_ << ".");
+    }
+    catch (const std::runtime_error& e)
+    {
+      ROS_WARN_STREAM("[SpinnakerCamera::restoreConfiguration] " << e.what());
+    }
+  }
+  return false;
+}
+
+void SpinnakerCamera::setUserSet(const std::string& user_set)
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  if (user_set != user_set_)
+  {
+    user_set_ = user_set;
+    user_set_hash_ = 0;
+  }
+}
+
+void SpinnakerCamera::setUnpack12Bit(bool unpack)
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  unpack_12bit_ = unpack;
+}
+
+void SpinnakerCamera::setDecompressionThreads(unsigned int threads)
+{
+  std::lock_guard<std::mutex> lock(decompression_mutex_);
+  decompression_threads_ = std::max(1u, threads);
+}
+
+bool SpinnakerCamera::getDecompressionStatistics(DecompressionPool::Statistics* statistics)
+{
+  std::lock_guard<std::mutex> lock(decompression_mutex_);
+  if (!decompression_pool_)
+  {
+    return false;
+  }
+  *statistics = decompression_pool_->getStatistics();
+  return true;
+}
+
+bool SpinnakerCamera::setOutputDemand(const OutputDemand& demand)
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  pixel_format_demand_ = demand;
+  if (!pCam_ || pixel_format_choice_.pixel_format.empty())
+  {
+    return false;
+  }
+  const PixelFormatChoice choice = negotiatePixelFormat(camera_->readPixelFormats(), demand);
+  return !choice.pixel_format.empty() && choice.pixel_format != pixel_format_choice_.pixel_format;
+}
+
+bool SpinnakerCamera::getPixelFormatChoice(PixelFormatChoice* choice)
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  if (pixel_format_choice_.pixel_format.empty())
+  {
+    return false;
+  }
+  *choice = pixel_format_choice_;
+  return true;
+}
+
+any_spinnaker_camera_driver::SpinnakerConfig
+SpinnakerCamera::resolvePixelFormat(const any_spinnaker_camera_driver::SpinnakerConfig& config)
+{
+  if (config.image_format_color_coding != AUTO_PIXEL_FORMAT)
+  {
+    pixel_format_choice_ = PixelFormatChoice();
+    return config;
+  }
+  any_spinnaker_camera_driver::SpinnakerConfig resolved = config;
+  const PixelFormatChoice choice = negotiatePixelFormat(camera_->readPixelFormats(), pixel_format_demand_);
+  if (choice.pixel_format.empty())
+  {
+    Spinnaker::GenApi::CEnumerationPtr format_ptr = node_map_->GetNode("PixelFormat");
+    resolved.image_format_color_coding = format_ptr->ToString().c_str();
+    ROS_WARN_STREAM("[SpinnakerCamera::resolvePixelFormat] Camera "
+                    << serial_ << " offers no 8-bit format to choose from, keeping "
+                    << resolved.image_format_color_coding << ".");
+    return resolved;
+  }
+  if (choice.pixel_format != pixel_format_choice_.pixel_format)
+  {
+    ROS_INFO_STREAM("[SpinnakerCamera::resolvePixelFormat] Camera " << serial_ << " sends " << choice.pixel_format
+                                                                    << ", " << std::round(100.0 * choice.getSavings())
+                                                                    << "% less than " << choice.reference_format
+                                                                    << ".");
+  }
+  pixel_format_choice_ = choice;
+  resolved.image_format_color_coding = choice.pixel_format;
+  return resolved;
+}
+
+void SpinnakerCamera::setSoftwareBinningMode(SoftwareBinning::Mode mode)
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  software_binning_mode_ = mode;
+}
+
+void SpinnakerCamera::getSoftwareBinning(ImageFormatFactors* factors)
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  *factors = software_factors_;
+}
+
+void SpinnakerCamera::updateSoftwareBinning(const any_spinnaker_camera_driver::SpinnakerConfig& config)
+{
+  hardware_factors_ = camera_->readImageFormatFactors();
+  const auto remainder = [this](int requested, int applied, const char* name) {
+    if (requested <= applied)
+    {
+      return 1;
+    }
+    if (requested % applied != 0)
+    {
+      ROS_WARN_STREAM("[SpinnakerCamera::updateSoftwareBinning] Camera " << serial_ << " applies a " << name
+                                                                         << " of " << applied << " instead of "
+                                                                         << requested << ", which is kept.");
+      return 1;
+    }
+    return requested / applied;
+  };
+  software_factors_.binning_x = remainder(config.image_format_x_binning, hardware_factors_.binning_x,
+                                          "horizontal binning");
+  software_factors_.binning_y = remainder(config.image_format_y_binning, hardware_factors_.binning_y,
+                                          "vertical binning");
+  software_factors_.decimation_x = remainder(config.image_format_x_decimation, hardware_factors_.decimation_x,
+                                             "horizontal decimation");
+  software_factors_.decimation_y = remainder(config.image_format_y_decimation, hardware_factors_.decimation_y,
+                                             "vertical decimation");
+
+  software_binning_.reset(new SoftwareBinning(software_factors_.binning_x, software_factors_.binning_y,
+                                              software_factors_.decimation_x, software_factors_.decimation_y,
+                                              software_binning_mode_));
+  if (software_binning_->isIdentity())
+  {
+    software_binning_.reset();
+  }
+  else
+  {
+    ROS_INFO_STREAM("[SpinnakerCamera::updateSoftwareBinning] Camera "
+                    << serial_ << " is binned " << software_factors_.binning_x << "x" << software_factors_.binning_y
+                    << " and decimated " << software_factors_.decimation_x << "x" << software_factors_.decimation_y
+                    << " on the host.");
+  }
+}
+
+std::shared_ptr<DecompressionPool> SpinnakerCamera::getDecompressionPool()
+{
+  std::lock_guard<std::mutex> lock(decompression_mutex_);
+  if (!decompression_pool_)
+  {
+    decompression_pool_.reset(new DecompressionPool(decompression_threads_));
+  }
+  return decompression_pool_;
+}
+
+uint64_t SpinnakerCamera::configurationHash(const any_spinnaker_camera_driver::SpinnakerConfig& config)
+{
+  dynamic_reconfigure::Config msg;
+  config.__toMessage__(msg);
+
+  // FNV-1a over the names and values of all parameters.
+  uint64_t hash = 14695981039346656037ull;
+  const auto add = [&hash](const std::string& bytes) {
+    for (const char byte : bytes)
+    {
+      hash = (hash ^ static_cast<unsigned char>(byte)) * 1099511628211ull;
+    }
+    // Separator, so that adjacent strings cannot be shifted into each other.
+    hash = (hash ^ 0xffu) * 1099511628211ull;
+  };
+  for (const auto& param : msg.bools)
+  {
+    add(param.name);
+    add(param.value ? "1" : "0");
+  }
+  for (const auto& param : msg.ints)
+  {
+    add(param.name);
+    add(std::to_string(param.value));
+  }
+  for (const auto& param : msg.strs)
+  {
+    add(param.name);
+    add(param.value);
+  }
+  for (const auto& param : msg.doubles)
+  {
+    add(param.name);
+    std::ostringstream value;
+    value.precision(17);
+    value << param.value;
+    add(value.str());
+  }
+  // 0 marks that nothing was stored.
+  return hash == 0 ? 1 : hash;
+}
+
 void SpinnakerCamera::setGain(const float& gain)
 {
   if (camera_)
@@ -149,14 +411,85 @@ Spinnaker::GenApi::CNodePtr SpinnakerCamera::readProperty(const Spinnaker::GenIC
   }
 }
 
+bool SpinnakerCamera::obtainCameraPtrOnArrival()
+{
+  // Interface events can be missed, e.g. for a network interface that came up after the driver started.
+  const std::chrono::seconds enumeration_fallback_period(5);
+  // Time to let a camera that just arrived finish registering with its interface.
+  const std::chrono::milliseconds arrival_retry_period(20);
+
+  const std::string serial_string = std::to_string(serial_);
+  const auto start = std::chrono::steady_clock::now();
+  const auto timeout = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(deviceConnectionTimeout_));
+  auto last_enumeration = start;
+  auto last_arrival = std::chrono::steady_clock::time_point::min();
+  bool enumerate = false;
+  while (ros::ok() && std::chrono::steady_clock::now() - start <= timeout)
+  {
+    try
+    {
+      pCam_ = registry_->find(serial_string, enumerate);
+      if (pCam_ && pCam_->IsValid())
+      {
+        return true;
+      }
+    }
+    catch (const Spinnaker::Exception& e)
+    {
+      ROS_DEBUG_STREAM("[SpinnakerCamera::obtainCameraPtrOnArrival] Camera not available yet: " << e.what());
+    }
+    pCam_ = static_cast<int>(NULL);
+    if (enumerate)
+    {
+      last_enumeration = std::chrono::steady_clock::now();
+    }
+    ROS_INFO_STREAM_THROTTLE(10, "Waiting for camera with serial number " + serial_string +
+                                     " to arrive. Is that camera plugged in? (Throttled: 10s)");
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto until_enumeration = last_enumeration + enumeration_fallback_period - now;
+    const auto until_timeout = start + timeout - now;
+    if (registry_->getDeviceEvents()->waitForArrival(serial_string, last_arrival,
+                                                     std::min(until_enumeration, until_timeout), &last_arrival))
+    {
+      std::this_thread::sleep_for(arrival_retry_period);
+    }
+    // Also after an arrival, in case the camera is not in the cached lists.
+    enumerate = std::chrono::steady_clock::now() - last_enumeration >= enumeration_fallback_period;
+  }
+  ROS_ERROR("Time used to connect to the device / upper bound time: %f seconds / %f seconds",
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), deviceConnectionTimeout_);
+  return false;
+}
+
+bool SpinnakerCamera::takeArrivalTime(std::chrono::steady_clock::time_point* time)
+{
+  DeviceEventMonitor* device_events = registry_->getDeviceEvents();
+  return device_events && serial_ != 0 && device_events->takeArrival(std::to_string(serial_), time);
+}
+
+bool SpinnakerCamera::wasRemoved() const
+{
+  DeviceEventMonitor* device_events = registry_->getDeviceEvents();
+  return device_events && serial_ != 0 && device_events->isRemoved(std::to_string(serial_));
+}
+
 bool SpinnakerCamera::obtainCameraPtr(double sleep_time){
+  if (registry_->getDeviceEvents() && serial_ != 0)
+  {
+    return obtainCameraPtrOnArrival();
+  }
   const ros::Time currTime{ros::Time::now()};
   const auto isCameraPtrObtained = [this](const ros::Time currTime) -> bool {
     return (!pCam_ || !pCam_->IsValid()) && ros::ok() && ((ros::Time::now() - currTime).toSec() <= deviceConnectionTimeout_);
   };
+  bool rescan = false;
   while (isCameraPtrObtained(currTime)){
-    // Without the following line, camList_ will be always empty if we start the ROS driver before the cameras are powered on.
-    camList_ = system_->GetCameras();
+    // The registry enumerated when it was created. Without rescanning afterwards, the camera list will be always empty
+    // if we start the ROS driver before the cameras are powered on.
+    const bool enumerate = rescan;
+    rescan = true;
     // If we have a specific camera to connect to (specified by a serial number)
     if (serial_ != 0)
     {
@@ -164,7 +497,7 @@ bool SpinnakerCamera::obtainCameraPtr(double sleep_time){
 
       try
       {
-        pCam_ = camList_.GetBySerial(serial_string);
+        pCam_ = registry_->find(serial_string, enumerate);
         if (!pCam_ || !pCam_->IsValid()){
           // This can happen when the robot is still on but the sensor power is cut off.
           ROS_INFO_STREAM_THROTTLE(10, "Could not find camera with serial number " +
@@ -184,10 +517,10 @@ bool SpinnakerCamera::obtainCameraPtr(double sleep_time){
     }
     else
     {
-      // Connect to any camera (the first)
+      // Connect to any camera (the first one no other driver instance is connected to)
       try
       {
-        pCam_ = camList_.GetByIndex(0);
+        pCam_ = registry_->find("", enumerate);
         if (!pCam_ || !pCam_->IsValid()){
           ROS_INFO_STREAM_THROTTLE(10, "Failed to get first connected camera. Is that camera plugged in? (Throttled: 10s)");
           continue;
@@ -211,14 +544,59 @@ bool SpinnakerCamera::obtainCameraPtr(double sleep_time){
   return false;
 }
 
+bool SpinnakerCamera::waitForCamera()
+{
+  if (pCam_)
+  {
+    return true;
+  }
+  bool camera_found;
+  {
+    ScopedStartupPhase phase(startup_profiler_, "wait_for_camera");
+    camera_found = obtainCameraPtr(1.0);
+  }
+  // Not claimed yet, connect() claims it.
+  pCam_ = static_cast<int>(NULL);
+  return camera_found;
+}
+
 bool SpinnakerCamera::connect()
 {
   if (!pCam_)
   {
-    if(!obtainCameraPtr(1.0)){
+    bool camera_found;
+    {
+      ScopedStartupPhase phase(startup_profiler_, "enumerate");
+      camera_found = obtainCameraPtr(1.0);
+    }
+    if(!camera_found){
       return false;
     }
 
+    const uint32_t desired_serial = serial_;
+    bool claimed = false;
+    // Leaves no half connected camera behind on a failure, so that the next connect() starts over and other driver
+    // instances can claim the camera.
+    const auto abandon = [&]() {
+      if (claimed)
+      {
+        try
+        {
+          if (pCam_->IsInitialized())
+          {
+            pCam_->DeInit();
+          }
+        }
+        catch (const Spinnaker::Exception& e)
+        {
+          ROS_WARN_STREAM("[SpinnakerCamera::connect] Failed to de-initialize the camera: " << e.what());
+        }
+        registry_->release(std::to_string(serial_));
+      }
+      pCam_ = static_cast<int>(NULL);
+      serial_ = desired_serial;
+    };
+
     try
     {
       // Check Device type and save serial for reconnecting
@@ -236,10 +614,21 @@ bool SpinnakerCamera::connect()
         else
         {
           ROS_DEBUG("[SpinnakerCamera::connect]: Unable to determine serial number.");
+          abandon();
           return false;
         }
       }
 
+      // Another driver instance of this process may have connected to the same camera in the meantime.
+      if (!registry_->claim(std::to_string(serial_)))
+      {
+        ROS_ERROR_STREAM("[SpinnakerCamera::connect]: Camera " << serial_
+                                                               << " is already used by another driver instance.");
+        abandon();
+        return false;
+      }
+      claimed = true;
+
       Spinnaker::GenApi::CEnumerationPtr device_type_ptr =
           static_cast<Spinnaker::GenApi::CEnumerationPtr>(genTLNodeMap.GetNode("DeviceType"));
 
@@ -264,6 +653,7 @@ bool SpinnakerCamera::connect()
     {
       ROS_ERROR_STREAM("[SpinnakerCamera::connect] Failed to determine device info with error: " +
                                std::string(e.what()));
+      abandon();
       return false;
     }
 
@@ -277,7 +667,10 @@ bool SpinnakerCamera::connect()
       pCam_->TLStream.StreamBufferCountManual.SetValue(1);
 
       // Initialize Camera
-      pCam_->Init();
+      {
+        ScopedStartupPhase phase(startup_profiler_, "init");
+        pCam_->Init();
+      }
 
       // Retrieve GenICam nodemap
       node_map_ = &pCam_->GetNodeMap();
@@ -317,12 +710,14 @@ bool SpinnakerCamera::connect()
     {
       ROS_ERROR_STREAM("[SpinnakerCamera::connect] Failed to connect to camera. Error: " +
                                std::string(e.what()));
+      abandon();
       return false;
     }
     catch (const std::runtime_error& e)
     {
       ROS_ERROR_STREAM("[SpinnakerCamera::connect] Failed to configure chunk data. Error: " +
                                std::string(e.what()));
+      abandon();
       return false;
     }
   }
@@ -378,10 +773,9 @@ void SpinnakerCamera::disconnect()
     {
       pCam_->DeInit();
       pCam_ = static_cast<int>(NULL);
-      camList_.RemoveBySerial(std::to_string(serial_));
+      registry_->release(std::to_string(serial_));
     }
-    Spinnaker::CameraList temp_list = system_->GetCameras();
-    camList_.Append(temp_list);
+    // The registry looks the camera up again on the next connect, rescanning only if it is not found.
   }
   catch (const Spinnaker::Exception& e)
   {
@@ -390,6 +784,57 @@ void SpinnakerCamera::disconnect()
   }
 }
 
+void SpinnakerCamera::reinitialize()
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  if (!pCam_)
+  {
+    throw std::runtime_error("[SpinnakerCamera::reinitialize] Not connected to the camera.");
+  }
+  try
+  {
+    if (captureRunning_)
+    {
+      captureRunning_ = false;
+      try
+      {
+        pCam_->EndAcquisition();
+      }
+      catch (const Spinnaker::Exception& e)
+      {
+        // A broken stream may fail to stop, DeInit cleans it up.
+        ROS_WARN_STREAM("[SpinnakerCamera::reinitialize] Failed to stop capture: " << e.what());
+      }
+    }
+    pCam_->DeInit();
+    pCam_->Init();
+
+    // The node map belongs to the camera object and survives the re-initialization, but look it up again anyway.
+    Spinnaker::GenApi::INodeMap* node_map = &pCam_->GetNodeMap();
+    if (node_map != node_map_)
+    {
+      node_map_ = node_map;
+      if (std::dynamic_pointer_cast<Cm3>(camera_))
+        camera_.reset(new Cm3(node_map_));
+      else
+        camera_.reset(new Camera(node_map_));
+    }
+  }
+  catch (const Spinnaker::Exception& e)
+  {
+    throw std::runtime_error("[SpinnakerCamera::reinitialize] Failed to re-initialize the camera with error: " +
+                             std::string(e.what()));
+  }
+}
+
+void SpinnakerCamera::setUserBuffers(unsigned int buffer_count, bool huge_pages, bool lock)
+{
+  std::lock_guard<std::mutex> scopedLock(mutex_);
+  user_buffer_count_ = std::max(1u, buffer_count);
+  buffer_pool_.reset(new StreamBufferPool(huge_pages, lock));
+  use_user_buffers_ = true;
+}
+
 void SpinnakerCamera::start()
 {
   try
@@ -397,6 +842,33 @@ void SpinnakerCamera::start()
     // Check if camera is connected
     if (pCam_ && !captureRunning_)
     {
+      if (buffer_pool_ && use_user_buffers_)
+      {
+        // The pool only allocates if the payload grew, e.g. after a larger ROI was configured.
+        try
+        {
+          buffer_pool_->reserve(user_buffer_count_, static_cast<size_t>(pCam_->PayloadSize.GetValue()));
+          pCam_->TLStream.StreamBufferCountManual.SetValue(user_buffer_count_);
+          pCam_->SetUserBuffers(buffer_pool_->data(), buffer_pool_->totalSize());
+        }
+        catch (const std::exception& e)
+        {
+          ROS_ERROR_STREAM("[SpinnakerCamera::start] Failed to set user stream buffers, using SDK allocated buffers: "
+                           << e.what());
+          use_user_buffers_ = false;
+        }
+      }
+      // Start the decompression workers before the first compressed frame arrives.
+      Spinnaker::GenApi::CEnumerationPtr compression_mode_ptr = node_map_->GetNode("ImageCompressionMode");
+      if (IsAvailable(compression_mode_ptr) && IsReadable(compression_mode_ptr) &&
+          compression_mode_ptr->ToString() != "Off")
+      {
+        // DeviceLinkSpeed is in bytes per second.
+        Spinnaker::GenApi::CIntegerPtr link_speed_ptr = node_map_->GetNode("DeviceLinkSpeed");
+        getDecompressionPool()->setLinkSpeed(IsAvailable(link_speed_ptr) && IsReadable(link_speed_ptr) ?
+                                                 static_cast<double>(link_speed_ptr->GetValue()) :
+                                                 0.0);
+      }
       // Start capturing images
       pCam_->BeginAcquisition();
       captureRunning_ = true;
@@ -417,6 +889,12 @@ void SpinnakerCamera::stop()
     {
       captureRunning_ = false;
       pCam_->EndAcquisition();
+      // Frames in flight would be handed out after the next start.
+      std::lock_guard<std::mutex> lock(decompression_mutex_);
+      if (decompression_pool_)
+      {
+        decompression_pool_->clear();
+      }
     }
     catch (const Spinnaker::Exception& e)
     {
@@ -425,7 +903,8 @@ void SpinnakerCamera::stop()
   }
 }
 
-bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& frame_id)
+bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& frame_id, FrameInfo* frame_info,
+                                const FrameFilter& filter)
 {
   std::lock_guard<std::mutex> scopedLock(mutex_);
 
@@ -435,11 +914,14 @@ bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& fr
     // Handle "Image Retrieval" Exception
     try
     {
-      Spinnaker::ImagePtr image_ptr = pCam_->GetNextImage(timeout_);
+      // Frames in flight for decompression are older than any frame the camera delivers next, and waiting for it
+      // would delay them by a frame period, or forever with a paused trigger.
+      const bool decompressing = hasPendingDecompressed();
+      Spinnaker::ImagePtr image_ptr = decompressing ? Spinnaker::ImagePtr() : pCam_->GetNextImage(timeout_);
       //  std::string format(image_ptr->GetPixelFormatName());
       //  std::printf("\033[100m format: %s \n", format.c_str());
 
-      if (image_ptr->IsIncomplete())
+      if (!decompressing && image_ptr->IsIncomplete())
       {
         ROS_ERROR_STREAM("[SpinnakerCamera::grabImage] Image received from camera " << std::to_string(serial_) <<
                                  " is incomplete. " << "Status: " <<  Spinnaker::Image::GetImageStatusDescription(image_ptr->GetImageStatus()));
@@ -447,12 +929,42 @@ bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& fr
       }
       else
       {
+        uint64_t timestamp_ns = decompressing ? 0 : image_ptr->GetTimeStamp();
+        uint64_t frame_counter = decompressing ? 0 : image_ptr->GetFrameID();
+        if (decompressing || image_ptr->IsCompressed())
+        {
+          // On-camera lossless compression, continue with the decompressed image of the oldest frame in flight.
+          DecompressionPool::Frame frame;
+          if (!takeDecompressed(image_ptr, &frame))
+          {
+            return false;
+          }
+          image_ptr = frame.image;
+          timestamp_ns = frame.timestamp_ns;
+          frame_counter = frame.frame_id;
+        }
+
         // Set Image Time Stamp
-        image->header.stamp.sec = image_ptr->GetTimeStamp() * 1e-9;
-        image->header.stamp.nsec = image_ptr->GetTimeStamp();
+        image->header.stamp.sec = timestamp_ns * 1e-9;
+        image->header.stamp.nsec = timestamp_ns;
+        if (frame_info != nullptr)
+        {
+          frame_info->hardware_stamp_ns = timestamp_ns;
+          frame_info->frame_id = frame_counter;
+          frame_info->binning_x = hardware_factors_.binning_x * hardware_factors_.decimation_x;
+          frame_info->binning_y = hardware_factors_.binning_y * hardware_factors_.decimation_y;
+          frame_info->skipped = filter && !filter(*frame_info);
+          if (frame_info->skipped)
+          {
+            return true;
+          }
+        }
 
         // Check the bits per pixel.
         size_t bitsPerPixel = image_ptr->GetBitsPerPixel();
+        // 12-bit packed formats get the 16-bit encodings when unpacked and a packed variant of them otherwise.
+        const PackedLayout packed_layout = getPackedLayout(image_ptr->GetPixelFormatName().c_str());
+        const bool wide_pixels = bitsPerPixel == 16 || packed_layout != PackedLayout::NONE;
 
         // --------------------------------------------------
         // Set the image encoding
@@ -470,7 +982,7 @@ bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& fr
         // if(isColor_ && bayer_format != NONE)
         if (color_filter_ptr->GetCurrentEntry() != color_filter_ptr->GetEntryByName("None"))
         {
-          if (bitsPerPixel == 16)
+          if (wide_pixels)
           {
             // 16 Bits per Pixel
             if (color_filter_str.compare(bayer_rg_str) == 0)
@@ -521,7 +1033,7 @@ bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& fr
         }
         else  // Mono camera or in pixel binned mode.
         {
-          if (bitsPerPixel == 16)
+          if (wide_pixels)
           {
             imageEncoding = sensor_msgs::image_encodings::MONO16;
           }
@@ -540,13 +1052,79 @@ bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& fr
         int stride = image_ptr->GetStride();
 
         ROS_DEBUG_ONCE("\033[93m wxh: (%d, %d), stride: %d \n", width, height, stride);
-        fillImage(*image, imageEncoding, height, width, stride, image_ptr->GetData());
+        const bool packed_output = packed_layout != PackedLayout::NONE && !unpack_12bit_;
+        if (software_binning_ && (packed_output || !SoftwareBinning::isSupported(imageEncoding)))
+        {
+          ROS_WARN_STREAM_THROTTLE(10, "[SpinnakerCamera::grabImage] Frames of camera "
+                                           << serial_ << " are not binned on the host, it is not supported for "
+                                           << (packed_output ? "packed 12-bit frames." : imageEncoding + "."));
+        }
+        else if (software_binning_)
+        {
+          // Bin straight from the acquisition buffer into the message, packed frames are unpacked first.
+          const void* pixels = image_ptr->GetData();
+          size_t pixels_step = stride;
+          if (packed_layout != PackedLayout::NONE)
+          {
+            unpacked_.resize(static_cast<size_t>(width) * height);
+            unpack12(static_cast<const uint8_t*>(image_ptr->GetData()), width, height, stride, packed_layout,
+                     unpacked_.data(), 2 * width);
+            pixels = unpacked_.data();
+            pixels_step = 2 * width;
+          }
+          size_t binned_width;
+          size_t binned_height;
+          software_binning_->getOutputSize(width, height, imageEncoding, &binned_width, &binned_height);
+          image->encoding = imageEncoding;
+          image->height = binned_height;
+          image->width = binned_width;
+          image->step = binned_width * (wide_pixels ? 2 : 1);
+          image->is_bigendian = 0;
+          image->data.resize(static_cast<size_t>(image->step) * binned_height);
+          software_binning_->process(pixels, width, height, pixels_step, imageEncoding, image->data.data(),
+                                     image->step);
+          if (frame_info != nullptr)
+          {
+            frame_info->binning_x *= software_binning_->getFactorX();
+            frame_info->binning_y *= software_binning_->getFactorY();
+          }
+          image->header.frame_id = frame_id;
+          return true;
+        }
+
+        if (packed_layout != PackedLayout::NONE && unpack_12bit_)
+        {
+          // Unpack straight from the acquisition buffer into the message.
+          image->encoding = imageEncoding;
+          image->height = height;
+          image->width = width;
+          image->step = 2 * width;
+          image->is_bigendian = 0;
+          image->data.resize(static_cast<size_t>(image->step) * height);
+          unpack12(static_cast<const uint8_t*>(image_ptr->GetData()), width, height, stride, packed_layout,
+                   reinterpret_cast<uint16_t*>(image->data.data()), image->step);
+        }
+        else if (packed_layout != PackedLayout::NONE)
+        {
+          fillImage(*image, getPackedEncoding(imageEncoding, packed_layout), height, width, stride,
+                    image_ptr->GetData());
+        }
+        else
+        {
+          fillImage(*image, imageEncoding, height, width, stride, image_ptr->GetData());
+        }
         image->header.frame_id = frame_id;
         return true;
       }  // end else
     }
     catch (const Spinnaker::Exception& e)
     {
+      if (e.GetError() == Spinnaker::SPINNAKER_ERR_TIMEOUT)
+      {
+        // No frame arrived, e.g. because the trigger is paused. Frames in flight are never held back by this.
+        throw CameraTimeoutException("[SpinnakerCamera::grabImage] No image received from camera " +
+                                     std::to_string(serial_) + " within the timeout.");
+      }
       ROS_ERROR_STREAM("[SpinnakerCamera::grabImage] Failed to retrieve buffer with error: " << e.what());
       return false;
     }
@@ -562,6 +1140,72 @@ bool SpinnakerCamera::grabImage(sensor_msgs::Image* image, const std::string& fr
   }
 }  // end grabImage
 
+bool SpinnakerCamera::takeDecompressed(Spinnaker::ImagePtr image_ptr, DecompressionPool::Frame* frame)
+{
+  const std::shared_ptr<DecompressionPool> pool = getDecompressionPool();
+  if (image_ptr.IsValid())
+  {
+    pool->submit(image_ptr);
+    // The pool decompresses a copy, the stream buffer goes back to the camera right away.
+    image_ptr->Release();
+  }
+  // Frames the camera delivered already are decompressed in parallel. Once they are submitted, waiting on the pool
+  // takes less time than waiting for the next frame.
+  bool taken = pool->take(frame, false);
+  while (!taken && pool->getPending() < pool->getThreads())
+  {
+    image_ptr = getQueuedImage();
+    if (!image_ptr.IsValid())
+    {
+      break;
+    }
+    if (image_ptr->IsIncomplete() || !image_ptr->IsCompressed())
+    {
+      ROS_WARN_STREAM("[SpinnakerCamera::grabImage] Dropped an incomplete or uncompressed frame of camera "
+                      << std::to_string(serial_) << " while decompressing.");
+    }
+    else
+    {
+      pool->submit(image_ptr);
+    }
+    image_ptr->Release();
+    taken = pool->take(frame, false);
+  }
+  if (!taken && !pool->take(frame, true))
+  {
+    return false;
+  }
+  if (!frame->image)
+  {
+    ROS_ERROR_STREAM("[SpinnakerCamera::grabImage] Failed to decompress a frame of camera " << std::to_string(serial_)
+                                                                                              << ": " << frame->error);
+    return false;
+  }
+  return true;
+}
+
+bool SpinnakerCamera::hasPendingDecompressed()
+{
+  std::lock_guard<std::mutex> lock(decompression_mutex_);
+  return decompression_pool_ && decompression_pool_->getPending() > 0;
+}
+
+Spinnaker::ImagePtr SpinnakerCamera::getQueuedImage()
+{
+  try
+  {
+    return pCam_->GetNextImage(Spinnaker::EVENT_TIMEOUT_NONE);
+  }
+  catch (const Spinnaker::Exception& e)
+  {
+    if (e.GetError() != Spinnaker::SPINNAKER_ERR_TIMEOUT)
+    {
+      throw;
+    }
+  }
+  return Spinnaker::ImagePtr();
+}
+
 void SpinnakerCamera::setTimeout(const double& timeout)
 {
   timeout_ = static_cast<uint64_t>(std::round(timeout * 1000));
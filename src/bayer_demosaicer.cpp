@@ -0,0 +1,464 @@
+/**
+Software License Agreement (BSD)
+
+\file      bayer_demosaicer.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <stdexcept>
+
+// The row kernels are built for AVX2 and the baseline, the dynamic loader picks the variant supported by the CPU.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define DEMOSAIC_TARGET_CLONES 1
+#define DEMOSAIC_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define DEMOSAIC_TARGET_CLONES 0
+#define DEMOSAIC_KERNEL
+#endif
+
+#if defined(__GNUC__)
+#define DEMOSAIC_INLINE inline __attribute__((always_inline))
+#else
+#define DEMOSAIC_INLINE inline
+#endif
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+/*!
+ * \brief Interpolates the three colors of one pixel.
+ *
+ * All pointers point to the pixel. The planes are named after the row: row_color is the color sharing the row with
+ * green (red or blue), other the color of the adjacent rows.
+ * \param left Offset of the left neighbor, mirrored at the border.
+ * \param right Offset of the right neighbor, mirrored at the border.
+ */
+template <typename T, bool EdgeAware, bool IsGreen>
+DEMOSAIC_INLINE void interpolatePixel(const T* up, const T* mid, const T* down, ptrdiff_t left, ptrdiff_t right,
+                                      T* row_color, T* green, T* other)
+{
+  const int l = mid[left];
+  const int r = mid[right];
+  const int u = *up;
+  const int d = *down;
+  if (IsGreen)
+  {
+    *row_color = static_cast<T>((l + r + 1) >> 1);
+    *green = *mid;
+    *other = static_cast<T>((u + d + 1) >> 1);
+    return;
+  }
+  int cross = (l + r + u + d + 2) >> 2;
+  if (EdgeAware)
+  {
+    const int gradient_h = std::abs(l - r);
+    const int gradient_v = std::abs(u - d);
+    cross = gradient_h < gradient_v ? (l + r + 1) >> 1 : (gradient_v < gradient_h ? (u + d + 1) >> 1 : cross);
+  }
+  *row_color = *mid;
+  *green = static_cast<T>(cross);
+  *other = static_cast<T>((up[left] + up[right] + down[left] + down[right] + 2) >> 2);
+}
+
+/** Interpolates a pixel whose color is only known at runtime, for the borders. */
+template <typename T, bool EdgeAware>
+DEMOSAIC_INLINE void interpolatePixelAt(const T* up, const T* mid, const T* down, size_t x, ptrdiff_t left,
+                                        ptrdiff_t right, size_t green_parity, T* row_color, T* green, T* other)
+{
+  if ((x & 1) == green_parity)
+  {
+    interpolatePixel<T, EdgeAware, true>(up + x, mid + x, down + x, left, right, row_color + x, green + x, other + x);
+  }
+  else
+  {
+    interpolatePixel<T, EdgeAware, false>(up + x, mid + x, down + x, left, right, row_color + x, green + x, other + x);
+  }
+}
+
+/*!
+ * \brief Interpolates pairs of pixels starting at column 2, the vectorized part of a row.
+ * \return The first column that was not interpolated.
+ */
+template <typename T, bool EdgeAware, bool EvenGreen>
+DEMOSAIC_INLINE size_t interpolatePairs(const T* __restrict up, const T* __restrict mid, const T* __restrict down,
+                                        size_t width, T* __restrict row_color, T* __restrict green,
+                                        T* __restrict other)
+{
+  // Both neighbors of the second pixel of the last pair have to be inside of the row.
+  const size_t pairs = (width - 3) / 2;
+  for (size_t i = 0; i < pairs; ++i)
+  {
+    const size_t x = 2 + 2 * i;
+    interpolatePixel<T, EdgeAware, EvenGreen>(up + x, mid + x, down + x, -1, 1, row_color + x, green + x, other + x);
+    interpolatePixel<T, EdgeAware, !EvenGreen>(up + x + 1, mid + x + 1, down + x + 1, -1, 1, row_color + x + 1,
+                                               green + x + 1, other + x + 1);
+  }
+  return 2 + 2 * pairs;
+}
+
+template <typename T, bool EdgeAware>
+DEMOSAIC_INLINE void interpolateRow(const T* up, const T* mid, const T* down, size_t width, size_t green_parity,
+                                    T* row_color, T* green, T* other)
+{
+  interpolatePixelAt<T, EdgeAware>(up, mid, down, 0, 1, 1, green_parity, row_color, green, other);
+  size_t x = 1;
+  if (width > 3)
+  {
+    interpolatePixelAt<T, EdgeAware>(up, mid, down, 1, -1, 1, green_parity, row_color, green, other);
+    x = green_parity == 0 ? interpolatePairs<T, EdgeAware, true>(up, mid, down, width, row_color, green, other) :
+                            interpolatePairs<T, EdgeAware, false>(up, mid, down, width, row_color, green, other);
+  }
+  for (; x + 1 < width; ++x)
+  {
+    interpolatePixelAt<T, EdgeAware>(up, mid, down, x, -1, 1, green_parity, row_color, green, other);
+  }
+  interpolatePixelAt<T, EdgeAware>(up, mid, down, width - 1, -1, -1, green_parity, row_color, green, other);
+}
+
+/** Interleaves the planes to RGB and computes the luminance with the weights of cv::COLOR_RGB2GRAY. */
+template <typename T>
+DEMOSAIC_INLINE void packRow(const T* __restrict red, const T* __restrict green, const T* __restrict blue,
+                             size_t width, T* __restrict color, T* __restrict mono)
+{
+  if (color != nullptr)
+  {
+    for (size_t x = 0; x < width; ++x)
+    {
+      color[3 * x] = red[x];
+      color[3 * x + 1] = green[x];
+      color[3 * x + 2] = blue[x];
+    }
+  }
+  if (mono != nullptr)
+  {
+    for (size_t x = 0; x < width; ++x)
+    {
+      const uint32_t luminance = 4899u * red[x] + 9617u * green[x] + 1868u * blue[x] + 8192u;
+      mono[x] = static_cast<T>(luminance >> 14);
+    }
+  }
+}
+
+DEMOSAIC_KERNEL void interpolateRow8(const uint8_t* up, const uint8_t* mid, const uint8_t* down, size_t width,
+                                     size_t green_parity, bool edge_aware, uint8_t* row_color, uint8_t* green,
+                                     uint8_t* other)
+{
+  if (edge_aware)
+  {
+    interpolateRow<uint8_t, true>(up, mid, down, width, green_parity, row_color, green, other);
+  }
+  else
+  {
+    interpolateRow<uint8_t, false>(up, mid, down, width, green_parity, row_color, green, other);
+  }
+}
+
+DEMOSAIC_KERNEL void interpolateRow16(const uint16_t* up, const uint16_t* mid, const uint16_t* down, size_t width,
+                                      size_t green_parity, bool edge_aware, uint16_t* row_color, uint16_t* green,
+                                      uint16_t* other)
+{
+  if (edge_aware)
+  {
+    interpolateRow<uint16_t, true>(up, mid, down, width, green_parity, row_color, green, other);
+  }
+  else
+  {
+    interpolateRow<uint16_t, false>(up, mid, down, width, green_parity, row_color, green, other);
+  }
+}
+
+DEMOSAIC_KERNEL void packRow8(const uint8_t* red, const uint8_t* green, const uint8_t* blue, size_t width,
+                              uint8_t* color, uint8_t* mono)
+{
+  packRow(red, green, blue, width, color, mono);
+}
+
+DEMOSAIC_KERNEL void packRow16(const uint16_t* red, const uint16_t* green, const uint16_t* blue, size_t width,
+                               uint16_t* color, uint16_t* mono)
+{
+  packRow(red, green, blue, width, color, mono);
+}
+
+void interpolateRow(const uint8_t* up, const uint8_t* mid, const uint8_t* down, size_t width, size_t green_parity,
+                    bool edge_aware, uint8_t* row_color, uint8_t* green, uint8_t* other)
+{
+  interpolateRow8(up, mid, down, width, green_parity, edge_aware, row_color, green, other);
+}
+
+void interpolateRow(const uint16_t* up, const uint16_t* mid, const uint16_t* down, size_t width, size_t green_parity,
+                    bool edge_aware, uint16_t* row_color, uint16_t* green, uint16_t* other)
+{
+  interpolateRow16(up, mid, down, width, green_parity, edge_aware, row_color, green, other);
+}
+
+void packRow(const uint8_t* red, const uint8_t* green, const uint8_t* blue, size_t width, uint8_t* color,
+             uint8_t* mono)
+{
+  packRow8(red, green, blue, width, color, mono);
+}
+
+void packRow(const uint16_t* red, const uint16_t* green, const uint16_t* blue, size_t width, uint16_t* color,
+             uint16_t* mono)
+{
+  packRow16(red, green, blue, width, color, mono);
+}
+
+/*!
+ * \brief Converts the rows [begin, end) of an image.
+ * \param scratch Memory for three rows of T.
+ */
+template <typename T>
+void processRows(const uint8_t* src, size_t width, size_t height, size_t src_step, BayerDemosaicer::Pattern pattern,
+                 bool edge_aware, uint8_t* color, size_t color_step, uint8_t* mono, size_t mono_step, size_t begin,
+                 size_t end, T* scratch)
+{
+  // Colors of the first row, the following rows alternate.
+  const bool first_row_red =
+      pattern == BayerDemosaicer::Pattern::RGGB || pattern == BayerDemosaicer::Pattern::GRBG;
+  const size_t first_green_parity =
+      pattern == BayerDemosaicer::Pattern::RGGB || pattern == BayerDemosaicer::Pattern::BGGR ? 1 : 0;
+
+  T* row_color = scratch;
+  T* green = scratch + width;
+  T* other = scratch + 2 * width;
+  const auto row = [&](size_t y) { return reinterpret_cast<const T*>(src + y * src_step); };
+  for (size_t y = begin; y < end; ++y)
+  {
+    // Mirroring by one row keeps the Bayer phase.
+    const T* up = row(y == 0 ? 1 : y - 1);
+    const T* down = row(y + 1 == height ? height - 2 : y + 1);
+    const size_t odd = y & 1;
+    interpolateRow(up, row(y), down, width, first_green_parity ^ odd, edge_aware, row_color, green, other);
+
+    const bool row_red = first_row_red != (odd != 0);
+    packRow(row_red ? row_color : other, green, row_red ? other : row_color, width,
+            color != nullptr ? reinterpret_cast<T*>(color + y * color_step) : nullptr,
+            mono != nullptr ? reinterpret_cast<T*>(mono + y * mono_step) : nullptr);
+  }
+}
+}  // namespace
+
+BayerDemosaicer::BayerDemosaicer(Method method, unsigned int threads) : method_(method)
+{
+  if (threads == 0)
+  {
+    threads = 1;
+  }
+  scratch_.resize(threads);
+  for (size_t band = 1; band < threads; ++band)
+  {
+    workers_.emplace_back(&BayerDemosaicer::workerLoop, this, band);
+  }
+}
+
+BayerDemosaicer::~BayerDemosaicer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_cv_.notify_all();
+  for (auto& worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+bool BayerDemosaicer::parseEncoding(const std::string& encoding, Pattern* pattern, unsigned int* bit_depth)
+{
+  const std::string prefix = "bayer_";
+  if (encoding.compare(0, prefix.size(), prefix) != 0 || encoding.size() < prefix.size() + 5)
+  {
+    return false;
+  }
+  const std::string order = encoding.substr(prefix.size(), 4);
+  const std::string depth = encoding.substr(prefix.size() + 4);
+  if (order == "rggb")
+  {
+    *pattern = Pattern::RGGB;
+  }
+  else if (order == "grbg")
+  {
+    *pattern = Pattern::GRBG;
+  }
+  else if (order == "gbrg")
+  {
+    *pattern = Pattern::GBRG;
+  }
+  else if (order == "bggr")
+  {
+    *pattern = Pattern::BGGR;
+  }
+  else
+  {
+    return false;
+  }
+  if (depth == "8")
+  {
+    *bit_depth = 8;
+  }
+  else if (depth == "16")
+  {
+    *bit_depth = 16;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+bool BayerDemosaicer::parseMethod(const std::string& name, Method* method)
+{
+  if (name == "bilinear")
+  {
+    *method = Method::BILINEAR;
+    return true;
+  }
+  if (name == "edge_aware")
+  {
+    *method = Method::EDGE_AWARE;
+    return true;
+  }
+  return false;
+}
+
+std::string BayerDemosaicer::toString(Method method)
+{
+  return method == Method::EDGE_AWARE ? "edge_aware" : "bilinear";
+}
+
+std::string BayerDemosaicer::getKernelName()
+{
+#if DEMOSAIC_TARGET_CLONES
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? "avx2" : "sse2";
+#elif defined(__AVX2__)
+  return "avx2";
+#elif defined(__x86_64__)
+  return "sse2";
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+  return "neon";
+#else
+  return "generic";
+#endif
+}
+
+void BayerDemosaicer::process(const void* src, size_t width, size_t height, size_t src_step, Pattern pattern,
+                              unsigned int bit_depth, void* color, size_t color_step, void* mono, size_t mono_step)
+{
+  if (width < 2 || height < 2)
+  {
+    throw std::runtime_error("[BayerDemosaicer::process] The image has to be at least 2 x 2 pixels.");
+  }
+  if (bit_depth != 8 && bit_depth != 16)
+  {
+    throw std::runtime_error("[BayerDemosaicer::process] Unsupported bit depth " + std::to_string(bit_depth) + ".");
+  }
+  if (color == nullptr && mono == nullptr)
+  {
+    return;
+  }
+
+  const size_t bytes_per_pixel = bit_depth / 8;
+  for (auto& scratch : scratch_)
+  {
+    if (scratch.size() < 3 * width * bytes_per_pixel)
+    {
+      scratch.resize(3 * width * bytes_per_pixel);
+    }
+  }
+
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+  auto* color_bytes = static_cast<uint8_t*>(color);
+  auto* mono_bytes = static_cast<uint8_t*>(mono);
+  const bool edge_aware = method_ == Method::EDGE_AWARE;
+  const size_t bands = scratch_.size();
+  const std::function<void(size_t)> job = [&](size_t band) {
+    const size_t begin = height * band / bands;
+    const size_t end = height * (band + 1) / bands;
+    if (bit_depth == 8)
+    {
+      processRows<uint8_t>(src_bytes, width, height, src_step, pattern, edge_aware, color_bytes, color_step,
+                           mono_bytes, mono_step, begin, end, scratch_[band].data());
+    }
+    else
+    {
+      processRows<uint16_t>(src_bytes, width, height, src_step, pattern, edge_aware, color_bytes, color_step,
+                            mono_bytes, mono_step, begin, end, reinterpret_cast<uint16_t*>(scratch_[band].data()));
+    }
+  };
+  runBands(job);
+}
+
+void BayerDemosaicer::runBands(const std::function<void(size_t)>& job)
+{
+  if (workers_.empty())
+  {
+    job(0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    pending_ = workers_.size();
+    ++generation_;
+  }
+  job_cv_.notify_all();
+  job(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return pending_ == 0; });
+  job_ = nullptr;
+}
+
+void BayerDemosaicer::workerLoop(size_t band)
+{
+  uint64_t seen_generation = 0;
+  while (true)
+  {
+    const std::function<void(size_t)>* job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+      if (stop_)
+      {
+        return;
+      }
+      seen_generation = generation_;
+      job = job_;
+    }
+    (*job)(band);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0)
+      {
+        done_cv_.notify_one();
+      }
+    }
+  }
+}
+}  // namespace any_spinnaker_camera_driver
@@ -24,24 +24,15 @@ ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSI
 */
 #include "any_spinnaker_camera_driver/camera.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 namespace any_spinnaker_camera_driver
 {
 void Camera::init()
 {
-  Spinnaker::GenApi::CIntegerPtr height_max_ptr = node_map_->GetNode("HeightMax");
-  if (!IsAvailable(height_max_ptr) || !IsReadable(height_max_ptr))
-  {
-    throw std::runtime_error("[Camera::init] Unable to read HeightMax");
-  }
-  height_max_ = height_max_ptr->GetValue();
-  Spinnaker::GenApi::CIntegerPtr width_max_ptr = node_map_->GetNode("WidthMax");
-  if (!IsAvailable(width_max_ptr) || !IsReadable(width_max_ptr))
-  {
-    throw std::runtime_error("[Camera::init] Unable to read WidthMax");
-  }
-  width_max_ = width_max_ptr->GetValue();
+  readMaxSize();
   // Set Throughput to maximum
   //=====================================
   setMaxInt(node_map_, "DeviceLinkThroughputLimit");
@@ -217,6 +208,16 @@ void Camera::setImageControlFormats(const any_spinnaker_camera_driver::Spinnaker
 
   // Set Pixel Format
   setProperty(node_map_, "PixelFormat", config.image_format_color_coding);
+
+  // Lossless compression depends on the pixel format and is only available on some models.
+  if (IsAvailable(node_map_->GetNode("ImageCompressionMode")))
+  {
+    setProperty(node_map_, "ImageCompressionMode", config.compression_mode);
+  }
+  else if (config.compression_mode != "Off")
+  {
+    ROS_WARN("[Camera::setImageControlFormats] The camera does not support on-camera compression.");
+  }
 }
 
 void Camera::setGain(const float& gain)
@@ -248,6 +249,102 @@ void Camera::setupGigEPacketDelay(PGRGuid & guid, unsigned int packet_delay)
 
 */
 
+void Camera::readMaxSize()
+{
+  Spinnaker::GenApi::CIntegerPtr height_max_ptr = node_map_->GetNode("HeightMax");
+  if (!IsAvailable(height_max_ptr) || !IsReadable(height_max_ptr))
+  {
+    throw std::runtime_error("[Camera::readMaxSize] Unable to read HeightMax");
+  }
+  height_max_ = height_max_ptr->GetValue();
+  Spinnaker::GenApi::CIntegerPtr width_max_ptr = node_map_->GetNode("WidthMax");
+  if (!IsAvailable(width_max_ptr) || !IsReadable(width_max_ptr))
+  {
+    throw std::runtime_error("[Camera::readMaxSize] Unable to read WidthMax");
+  }
+  width_max_ = width_max_ptr->GetValue();
+}
+
+ImageFormatFactors Camera::readImageFormatFactors()
+{
+  const auto read = [this](const char* name) {
+    Spinnaker::GenApi::CIntegerPtr factor_ptr = node_map_->GetNode(name);
+    return IsAvailable(factor_ptr) && IsReadable(factor_ptr) ? std::max(1, static_cast<int>(factor_ptr->GetValue())) :
+                                                               1;
+  };
+  ImageFormatFactors factors;
+  factors.binning_x = read("BinningHorizontal");
+  factors.binning_y = read("BinningVertical");
+  factors.decimation_x = read("DecimationHorizontal");
+  factors.decimation_y = read("DecimationVertical");
+  return factors;
+}
+
+std::vector<std::string> Camera::readPixelFormats()
+{
+  std::vector<std::string> formats;
+  Spinnaker::GenApi::CEnumerationPtr format_ptr = node_map_->GetNode("PixelFormat");
+  if (!IsAvailable(format_ptr) || !IsReadable(format_ptr))
+  {
+    throw std::runtime_error("[Camera::readPixelFormats] Unable to read PixelFormat");
+  }
+  Spinnaker::GenApi::NodeList_t entries;
+  format_ptr->GetEntries(entries);
+  for (Spinnaker::GenApi::CNodePtr node : entries)
+  {
+    Spinnaker::GenApi::CEnumEntryPtr entry_ptr = node;
+    if (IsAvailable(entry_ptr) && IsReadable(entry_ptr))
+    {
+      formats.emplace_back(entry_ptr->GetSymbolic().c_str());
+    }
+  }
+  return formats;
+}
+
+void Camera::saveUserSet(const std::string& user_set)
+{
+  try
+  {
+    if (!setProperty(node_map_, "UserSetSelector", user_set))
+    {
+      throw std::runtime_error("[Camera::saveUserSet] Unable to select " + user_set);
+    }
+    Spinnaker::GenApi::CCommandPtr save_ptr = node_map_->GetNode("UserSetSave");
+    if (!IsAvailable(save_ptr) || !IsWritable(save_ptr))
+    {
+      throw std::runtime_error("[Camera::saveUserSet] UserSetSave is not available");
+    }
+    save_ptr->Execute();
+  }
+  catch (const Spinnaker::Exception& e)
+  {
+    throw std::runtime_error("[Camera::saveUserSet] Failed to save " + user_set + ": " + std::string(e.what()));
+  }
+}
+
+void Camera::loadUserSet(const std::string& user_set)
+{
+  try
+  {
+    if (!setProperty(node_map_, "UserSetSelector", user_set))
+    {
+      throw std::runtime_error("[Camera::loadUserSet] Unable to select " + user_set);
+    }
+    Spinnaker::GenApi::CCommandPtr load_ptr = node_map_->GetNode("UserSetLoad");
+    if (!IsAvailable(load_ptr) || !IsWritable(load_ptr))
+    {
+      throw std::runtime_error("[Camera::loadUserSet] UserSetLoad is not available");
+    }
+    load_ptr->Execute();
+    // The UserSet may change the binning and decimation.
+    readMaxSize();
+  }
+  catch (const Spinnaker::Exception& e)
+  {
+    throw std::runtime_error("[Camera::loadUserSet] Failed to load " + user_set + ": " + std::string(e.what()));
+  }
+}
+
 int Camera::getHeightMax()
 {
   return height_max_;
@@ -164,7 +164,7 @@ void Cm3::setNewConfiguration(const SpinnakerConfig& config, const uint32_t& lev
 // Image Size and Pixel Format
 void Cm3::setImageControlFormats(const any_spinnaker_camera_driver::SpinnakerConfig& config)
 {
-  // Set Binning and Decimation
+  // Set Binning and Decimation, SpinnakerCamera bins and decimates on the host what is not available on CM3.
   // setProperty(node_map_, "BinningHorizontal", config.image_format_x_binning);  // Not available on CM3
   setProperty(node_map_, "BinningVertical", config.image_format_y_binning);
   // setProperty(node_map_, "DecimationHorizontal", config.image_format_x_decimation);
@@ -211,5 +211,6 @@ void Cm3::setImageControlFormats(const any_spinnaker_camera_driver::SpinnakerCon
 
   // Set Pixel Format
   setProperty(node_map_, "PixelFormat", config.image_format_color_coding);
+  // setProperty(node_map_, "ImageCompressionMode", config.compression_mode);  // Not available on CM3
 }
 }  // namespace any_spinnaker_camera_driver
@@ -0,0 +1,222 @@
+/**
+Software License Agreement (BSD)
+
+\file      compression_pool.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/compression_pool.h"
+
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+/** cv::cvtColor code converting a Bayer pattern to BGR, OpenCV names the patterns after the second row. */
+int bayerToBgrCode(BayerDemosaicer::Pattern pattern)
+{
+  switch (pattern)
+  {
+    case BayerDemosaicer::Pattern::RGGB:
+      return cv::COLOR_BayerBG2BGR;
+    case BayerDemosaicer::Pattern::GRBG:
+      return cv::COLOR_BayerGB2BGR;
+    case BayerDemosaicer::Pattern::GBRG:
+      return cv::COLOR_BayerGR2BGR;
+    case BayerDemosaicer::Pattern::BGGR:
+    default:
+      return cv::COLOR_BayerRG2BGR;
+  }
+}
+}  // namespace
+
+CompressionPool::CompressionPool(const Config& config, Callback callback)
+  : config_(config), callback_(std::move(callback))
+{
+  config_.queue_size = std::max<size_t>(1, config_.queue_size);
+  config_.threads = std::max(1u, config_.threads);
+  for (unsigned int i = 0; i < config_.threads; ++i)
+  {
+    workers_.emplace_back(&CompressionPool::workerLoop, this);
+  }
+}
+
+CompressionPool::~CompressionPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_cv_.notify_all();
+  publish_cv_.notify_all();
+  for (auto& worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+void CompressionPool::submit(const sensor_msgs::ImageConstPtr& image)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.size() >= config_.queue_size)
+    {
+      queue_.pop_front();
+      ++statistics_.dropped;
+    }
+    queue_.push_back(Job{ image, Clock::now() });
+  }
+  job_cv_.notify_one();
+}
+
+CompressionPool::Statistics CompressionPool::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+bool CompressionPool::compress(const sensor_msgs::Image& image, const Config& config,
+                               sensor_msgs::CompressedImage* compressed, std::string* error)
+{
+  const bool jpeg = config.format == "jpeg";
+  if (!jpeg && config.format != "png")
+  {
+    *error = "Unknown compression format " + config.format + ".";
+    return false;
+  }
+
+  BayerDemosaicer::Pattern pattern;
+  unsigned int bit_depth = 8;
+  const bool bayer = BayerDemosaicer::parseEncoding(image.encoding, &pattern, &bit_depth);
+  const bool mono = image.encoding == "mono8" || image.encoding == "mono16";
+  const bool rgb = image.encoding == "rgb8" || image.encoding == "rgb16";
+  const bool bgr = image.encoding == "bgr8" || image.encoding == "bgr16";
+  if (!bayer && !mono && !rgb && !bgr)
+  {
+    *error = "Cannot compress images with encoding " + image.encoding + ".";
+    return false;
+  }
+  if (!bayer)
+  {
+    bit_depth = image.encoding.back() == '6' ? 16 : 8;
+  }
+
+  const int depth = bit_depth == 8 ? CV_8U : CV_16U;
+  // The encoder only reads the image, the message data is not copied.
+  const cv::Mat source(static_cast<int>(image.height), static_cast<int>(image.width),
+                       CV_MAKETYPE(depth, bayer || mono ? 1 : 3), const_cast<uint8_t*>(image.data.data()),
+                       image.step);
+  cv::Mat converted = source;
+  if (bayer)
+  {
+    cv::cvtColor(source, converted, bayerToBgrCode(pattern));
+  }
+  else if (rgb)
+  {
+    cv::cvtColor(source, converted, cv::COLOR_RGB2BGR);
+  }
+  if (jpeg && bit_depth == 16)
+  {
+    converted.convertTo(converted, CV_8U, 1.0 / 256.0);
+    bit_depth = 8;
+  }
+
+  const std::string target = std::string(mono ? "mono" : "bgr") + std::to_string(bit_depth);
+  compressed->header = image.header;
+  compressed->format = image.encoding + (jpeg ? "; jpeg compressed " : "; png compressed ") + target;
+  const std::vector<int> parameters =
+      jpeg ? std::vector<int>{ cv::IMWRITE_JPEG_QUALITY, config.jpeg_quality } :
+             std::vector<int>{ cv::IMWRITE_PNG_COMPRESSION, config.png_level };
+  try
+  {
+    if (!cv::imencode(jpeg ? ".jpg" : ".png", converted, compressed->data, parameters))
+    {
+      *error = "The encoder failed.";
+      return false;
+    }
+  }
+  catch (const cv::Exception& e)
+  {
+    *error = e.what();
+    return false;
+  }
+  return true;
+}
+
+void CompressionPool::workerLoop()
+{
+  while (true)
+  {
+    Job job;
+    uint64_t sequence;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (stop_)
+      {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+      sequence = next_sequence_++;
+    }
+
+    const Clock::time_point start = Clock::now();
+    sensor_msgs::CompressedImagePtr compressed(new sensor_msgs::CompressedImage);
+    std::string error;
+    const bool success = compress(*job.image, config_, compressed.get(), &error);
+    const double compression_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Hand on the results in the order the jobs were taken, so that the published stamps never go backwards.
+    std::unique_lock<std::mutex> lock(mutex_);
+    publish_cv_.wait(lock, [&] { return stop_ || next_publish_ == sequence; });
+    if (stop_)
+    {
+      return;
+    }
+    if (success)
+    {
+      lock.unlock();
+      callback_(compressed);
+      lock.lock();
+      const double latency_ms = std::chrono::duration<double, std::milli>(Clock::now() - job.submitted).count();
+      ++statistics_.compressed;
+      statistics_.last_latency_ms = latency_ms;
+      statistics_.max_latency_ms = std::max(statistics_.max_latency_ms, latency_ms);
+      statistics_.last_compression_ms = compression_ms;
+    }
+    else
+    {
+      ++statistics_.failed;
+      statistics_.last_error = error;
+    }
+    ++next_publish_;
+    publish_cv_.notify_all();
+  }
+}
+}  // namespace any_spinnaker_camera_driver
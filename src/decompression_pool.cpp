@@ -0,0 +1,198 @@
+/**
+Software License Agreement (BSD)
+
+\file      decompression_pool.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/decompression_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace any_spinnaker_camera_driver
+{
+DecompressionPool::DecompressionPool(unsigned int threads)
+{
+  for (unsigned int i = 0; i < std::max(1u, threads); ++i)
+  {
+    workers_.emplace_back(&DecompressionPool::workerLoop, this);
+  }
+}
+
+DecompressionPool::~DecompressionPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_cv_.notify_all();
+  for (auto& worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+void DecompressionPool::submit(const Spinnaker::ImagePtr& compressed)
+{
+  std::shared_ptr<Job> job(new Job);
+  job->frame.timestamp_ns = compressed->GetTimeStamp();
+  job->frame.frame_id = compressed->GetFrameID();
+  job->frame.payload_size = compressed->GetValidPayloadSize();
+  // The compressed payload is about half the size of the image, copying it is cheaper than holding the stream buffer.
+  job->compressed = Spinnaker::Image::Create();
+  job->compressed->DeepCopy(compressed);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(job);
+    pending_.push_back(job);
+  }
+  job_cv_.notify_one();
+}
+
+bool DecompressionPool::take(Frame* frame, bool wait)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (pending_.empty())
+  {
+    return false;
+  }
+  if (wait)
+  {
+    done_cv_.wait(lock, [this] { return pending_.empty() || pending_.front()->done; });
+  }
+  if (pending_.empty() || !pending_.front()->done)
+  {
+    return false;
+  }
+  std::shared_ptr<Job> job = std::move(pending_.front());
+  pending_.pop_front();
+  account(*job, job->frame.image ? job->frame.image->GetImageSize() : 0);
+  *frame = std::move(job->frame);
+  return true;
+}
+
+void DecompressionPool::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Jobs a worker is decompressing are only dropped once it is done with them.
+  queue_.clear();
+  pending_.clear();
+  done_cv_.notify_all();
+}
+
+size_t DecompressionPool::getPending() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_.size();
+}
+
+void DecompressionPool::setLinkSpeed(double bytes_per_second)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  link_speed_ = bytes_per_second;
+}
+
+DecompressionPool::Statistics DecompressionPool::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+void DecompressionPool::account(const Job& job, size_t decompressed_size)
+{
+  if (job.frame.image)
+  {
+    ++statistics_.decompressed;
+    statistics_.last_decompression_ms = job.decompression_ms;
+    statistics_.max_decompression_ms = std::max(statistics_.max_decompression_ms, job.decompression_ms);
+    window_decompressed_ += decompressed_size;
+  }
+  else
+  {
+    ++statistics_.failed;
+    statistics_.last_error = job.frame.error;
+  }
+  // Failed frames were transferred all the same.
+  window_payload_ += job.frame.payload_size;
+
+  const Clock::time_point now = Clock::now();
+  const double window_s = std::chrono::duration<double>(now - window_start_).count();
+  if (window_s < 1.0)
+  {
+    return;
+  }
+  const double payload_rate = static_cast<double>(window_payload_) / window_s;
+  statistics_.payload_rate_mb_s = payload_rate * 1e-6;
+  statistics_.link_utilization = link_speed_ > 0.0 ? payload_rate / link_speed_ : 0.0;
+  if (window_payload_ > 0)
+  {
+    statistics_.compression_ratio = static_cast<double>(window_decompressed_) / static_cast<double>(window_payload_);
+  }
+  window_start_ = now;
+  window_payload_ = 0;
+  window_decompressed_ = 0;
+}
+
+void DecompressionPool::workerLoop()
+{
+  // One processor per worker, so that the workers do not share its state.
+  Spinnaker::ImageProcessor processor;
+  while (true)
+  {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (stop_)
+      {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+    }
+
+    const Clock::time_point start = Clock::now();
+    Spinnaker::ImagePtr image;
+    std::string error;
+    try
+    {
+      // Converting a compressed image to its own pixel format only decompresses it.
+      image = processor.Convert(job->compressed, job->compressed->GetPixelFormat());
+    }
+    catch (const Spinnaker::Exception& e)
+    {
+      error = e.what();
+    }
+    const double decompression_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job->compressed = Spinnaker::ImagePtr();
+      job->frame.image = image;
+      job->frame.error = error;
+      job->decompression_ms = decompression_ms;
+      job->done = true;
+    }
+    done_cv_.notify_all();
+  }
+}
+}  // namespace any_spinnaker_camera_driver
@@ -0,0 +1,237 @@
+/**
+Software License Agreement (BSD)
+
+\file      demosaic_benchmark.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+   @file demosaic_benchmark.cpp
+   @brief Compares the demosaicing of the driver against the cv::cvtColor conversion used by image_proc/debayer.
+
+   A synthetic scene with gradients and sharp edges is sampled with a Bayer pattern. Both conversions are timed and
+   compared against the scene and against each other.
+*/
+
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::BayerDemosaicer;
+
+namespace
+{
+void printUsage()
+{
+  std::cerr << "Usage: demosaic_benchmark [options]" << std::endl
+            << "  --width <n>         Image width (default 1920)." << std::endl
+            << "  --height <n>        Image height (default 1200)." << std::endl
+            << "  --encoding <e>      Bayer encoding, e.g. bayer_rggb8 or bayer_gbrg16 (default bayer_rggb8)." << std::endl
+            << "  --method <m>        bilinear or edge_aware (default bilinear)." << std::endl
+            << "  --threads <n>       Threads of the driver conversion (default 2)." << std::endl
+            << "  --iterations <n>    Number of conversions to time (default 100)." << std::endl;
+}
+
+/** RGB test scene: smooth gradients on the left half, a grid of one pixel lines and a circle on the right half. */
+cv::Mat makeScene(int width, int height, int depth)
+{
+  const double max_value = depth == CV_8U ? 255.0 : 65535.0;
+  cv::Mat scene(height, width, CV_MAKETYPE(depth, 3));
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      double red = static_cast<double>(x) / width;
+      double green = static_cast<double>(y) / height;
+      double blue = 0.5 + 0.5 * std::sin(0.05 * (x + y));
+      if (x >= width / 2)
+      {
+        const double dx = x - 0.75 * width;
+        const double dy = y - 0.5 * height;
+        const bool line = x % 16 == 0 || y % 16 == 0;
+        const bool inside = dx * dx + dy * dy < 0.04 * height * height;
+        red = line ? 1.0 : (inside ? 0.9 : 0.2);
+        green = line ? 1.0 : (inside ? 0.3 : 0.2);
+        blue = line ? 1.0 : (inside ? 0.1 : 0.6);
+      }
+      const cv::Vec3d value(red * max_value, green * max_value, blue * max_value);
+      if (depth == CV_8U)
+        scene.at<cv::Vec3b>(y, x) = value;
+      else
+        scene.at<cv::Vec3w>(y, x) = value;
+    }
+  }
+  return scene;
+}
+
+/** Samples the color of the pattern at every pixel. */
+cv::Mat mosaic(const cv::Mat& scene, BayerDemosaicer::Pattern pattern)
+{
+  // Channel of the pixels (0, 0), (0, 1), (1, 0) and (1, 1).
+  static const int channels[4][4] = { { 0, 1, 1, 2 }, { 1, 0, 2, 1 }, { 1, 2, 0, 1 }, { 2, 1, 1, 0 } };
+  const int* layout = channels[static_cast<int>(pattern)];
+  std::vector<cv::Mat> planes;
+  cv::split(scene, planes);
+  cv::Mat bayer(scene.rows, scene.cols, scene.depth());
+  for (int y = 0; y < scene.rows; ++y)
+  {
+    for (int x = 0; x < scene.cols; ++x)
+    {
+      const cv::Mat& plane = planes[layout[(y & 1) * 2 + (x & 1)]];
+      if (scene.depth() == CV_8U)
+        bayer.at<uint8_t>(y, x) = plane.at<uint8_t>(y, x);
+      else
+        bayer.at<uint16_t>(y, x) = plane.at<uint16_t>(y, x);
+    }
+  }
+  return bayer;
+}
+
+/** The conversion code image_proc/debayer uses for the pattern, with RGB instead of BGR output. */
+int openCvCode(BayerDemosaicer::Pattern pattern, BayerDemosaicer::Method method)
+{
+  // OpenCV names the patterns after the second row.
+  const bool edge_aware = method == BayerDemosaicer::Method::EDGE_AWARE;
+  switch (pattern)
+  {
+    case BayerDemosaicer::Pattern::RGGB:
+      return edge_aware ? cv::COLOR_BayerBG2RGB_EA : cv::COLOR_BayerBG2RGB;
+    case BayerDemosaicer::Pattern::GRBG:
+      return edge_aware ? cv::COLOR_BayerGB2RGB_EA : cv::COLOR_BayerGB2RGB;
+    case BayerDemosaicer::Pattern::GBRG:
+      return edge_aware ? cv::COLOR_BayerGR2RGB_EA : cv::COLOR_BayerGR2RGB;
+    case BayerDemosaicer::Pattern::BGGR:
+    default:
+      return edge_aware ? cv::COLOR_BayerRG2RGB_EA : cv::COLOR_BayerRG2RGB;
+  }
+}
+
+/** PSNR of an image against a reference, ignoring a border of two pixels where the conversions differ. */
+double psnr(const cv::Mat& image, const cv::Mat& reference, double max_value)
+{
+  const cv::Rect inner(2, 2, image.cols - 4, image.rows - 4);
+  cv::Mat difference;
+  cv::absdiff(image(inner), reference(inner), difference);
+  difference.convertTo(difference, CV_64F);
+  const cv::Scalar sums = cv::sum(difference.mul(difference));
+  const double mse = (sums[0] + sums[1] + sums[2]) / (3.0 * inner.area());
+  return mse > 0.0 ? 10.0 * std::log10(max_value * max_value / mse) : INFINITY;
+}
+
+template <typename Function>
+double timeMs(int iterations, Function function)
+{
+  function();  // Warm up.
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    function();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  int width = 1920;
+  int height = 1200;
+  std::string encoding = "bayer_rggb8";
+  std::string method_name = "bilinear";
+  int threads = 2;
+  int iterations = 100;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string argument = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (argument == "--width" && has_value)
+      width = std::atoi(argv[++i]);
+    else if (argument == "--height" && has_value)
+      height = std::atoi(argv[++i]);
+    else if (argument == "--encoding" && has_value)
+      encoding = argv[++i];
+    else if (argument == "--method" && has_value)
+      method_name = argv[++i];
+    else if (argument == "--threads" && has_value)
+      threads = std::atoi(argv[++i]);
+    else if (argument == "--iterations" && has_value)
+      iterations = std::atoi(argv[++i]);
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+
+  BayerDemosaicer::Pattern pattern;
+  unsigned int bit_depth;
+  BayerDemosaicer::Method method;
+  if (!BayerDemosaicer::parseEncoding(encoding, &pattern, &bit_depth) ||
+      !BayerDemosaicer::parseMethod(method_name, &method) || width < 8 || height < 8 || threads < 1 ||
+      iterations < 1)
+  {
+    printUsage();
+    return 1;
+  }
+
+  const int depth = bit_depth == 8 ? CV_8U : CV_16U;
+  const double max_value = bit_depth == 8 ? 255.0 : 65535.0;
+  const cv::Mat scene = makeScene(width, height, depth);
+  const cv::Mat bayer = mosaic(scene, pattern);
+
+  BayerDemosaicer demosaicer(method, static_cast<unsigned int>(threads));
+  cv::Mat color(height, width, CV_MAKETYPE(depth, 3));
+  cv::Mat mono(height, width, depth);
+  const double driver_color_ms = timeMs(iterations, [&]() {
+    demosaicer.process(bayer.data, width, height, bayer.step, pattern, bit_depth, color.data, color.step, nullptr, 0);
+  });
+  const double driver_both_ms = timeMs(iterations, [&]() {
+    demosaicer.process(bayer.data, width, height, bayer.step, pattern, bit_depth, color.data, color.step, mono.data,
+                       mono.step);
+  });
+
+  // image_proc converts to color and separately to mono, each on the thread of the debayer nodelet.
+  const int code = openCvCode(pattern, method);
+  cv::Mat opencv_color;
+  cv::Mat opencv_mono;
+  const double opencv_color_ms = timeMs(iterations, [&]() { cv::cvtColor(bayer, opencv_color, code); });
+  const double opencv_both_ms = timeMs(iterations, [&]() {
+    cv::cvtColor(bayer, opencv_color, code);
+    cv::cvtColor(opencv_color, opencv_mono, cv::COLOR_RGB2GRAY);
+  });
+
+  std::printf("%s %dx%d, %s, %d driver threads, %s kernels, %d iterations\n", encoding.c_str(), width, height,
+              method_name.c_str(), threads, BayerDemosaicer::getKernelName().c_str(), iterations);
+  std::printf("                 color [ms]  color+mono [ms]  PSNR vs scene [dB]\n");
+  std::printf("  driver         %10.2f  %15.2f  %18.1f\n", driver_color_ms, driver_both_ms,
+              psnr(color, scene, max_value));
+  std::printf("  cv::cvtColor   %10.2f  %15.2f  %18.1f\n", opencv_color_ms, opencv_both_ms,
+              psnr(opencv_color, scene, max_value));
+  std::printf("  PSNR driver vs cv::cvtColor: %.1f dB\n", psnr(color, opencv_color, max_value));
+  return 0;
+}
@@ -0,0 +1,159 @@
+/**
+Software License Agreement (BSD)
+
+\file      device_event_monitor.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/device_event_monitor.h"
+
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+// The interface event API changed with Spinnaker 3, which reports cameras instead of serial numbers.
+#if defined(FLIR_SPINNAKER_VERSION_MAJOR) && FLIR_SPINNAKER_VERSION_MAJOR >= 3
+class DeviceEventMonitor::Handler : public Spinnaker::InterfaceEventHandler
+{
+public:
+  explicit Handler(DeviceEventMonitor* monitor) : monitor_(monitor)
+  {
+  }
+
+  void OnDeviceArrival(Spinnaker::CameraPtr camera) override
+  {
+    monitor_->onArrival(serialOf(camera));
+  }
+
+  void OnDeviceRemoval(Spinnaker::CameraPtr camera) override
+  {
+    monitor_->onRemoval(serialOf(camera));
+  }
+
+private:
+  static std::string serialOf(Spinnaker::CameraPtr camera)
+  {
+    return std::string(camera->TLDevice.DeviceSerialNumber.GetValue().c_str());
+  }
+
+  DeviceEventMonitor* monitor_;
+};
+#else
+class DeviceEventMonitor::Handler : public Spinnaker::InterfaceEvent
+{
+public:
+  explicit Handler(DeviceEventMonitor* monitor) : monitor_(monitor)
+  {
+  }
+
+  void OnDeviceArrival(uint64_t serial) override
+  {
+    monitor_->onArrival(std::to_string(serial));
+  }
+
+  void OnDeviceRemoval(uint64_t serial) override
+  {
+    monitor_->onRemoval(std::to_string(serial));
+  }
+
+private:
+  DeviceEventMonitor* monitor_;
+};
+#endif
+
+DeviceEventMonitor::DeviceEventMonitor(Spinnaker::SystemPtr system) : system_(system), handler_(new Handler(this))
+{
+  // Updating the interfaces keeps their camera lists current, so that an arrived camera can be looked up without
+  // enumerating again.
+#if defined(FLIR_SPINNAKER_VERSION_MAJOR) && FLIR_SPINNAKER_VERSION_MAJOR >= 3
+  system_->RegisterInterfaceEventHandler(*handler_, true);
+#else
+  system_->RegisterInterfaceEvent(*handler_, true);
+#endif
+}
+
+DeviceEventMonitor::~DeviceEventMonitor()
+{
+  try
+  {
+#if defined(FLIR_SPINNAKER_VERSION_MAJOR) && FLIR_SPINNAKER_VERSION_MAJOR >= 3
+    system_->UnregisterInterfaceEventHandler(*handler_);
+#else
+    system_->UnregisterInterfaceEvent(*handler_);
+#endif
+  }
+  catch (const Spinnaker::Exception&)
+  {
+    // The system is shutting down already.
+  }
+}
+
+bool DeviceEventMonitor::waitForArrival(const std::string& serial, Clock::time_point after, Clock::duration timeout,
+                                        Clock::time_point* time)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  // The arrival is only taken once the first frame arrived, so earlier waits must not see it again.
+  const bool arrived = arrival_cv_.wait_for(lock, timeout, [this, &serial, after]() {
+    const auto arrival = arrivals_.find(serial);
+    return arrival != arrivals_.end() && arrival->second > after;
+  });
+  if (arrived)
+  {
+    *time = arrivals_[serial];
+  }
+  return arrived;
+}
+
+bool DeviceEventMonitor::takeArrival(const std::string& serial, Clock::time_point* time)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto arrival = arrivals_.find(serial);
+  if (arrival == arrivals_.end())
+  {
+    return false;
+  }
+  *time = arrival->second;
+  arrivals_.erase(arrival);
+  return true;
+}
+
+bool DeviceEventMonitor::isRemoved(const std::string& serial) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return removed_.count(serial) > 0;
+}
+
+void DeviceEventMonitor::onArrival(const std::string& serial)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    arrivals_[serial] = Clock::now();
+    removed_.erase(serial);
+  }
+  arrival_cv_.notify_all();
+}
+
+void DeviceEventMonitor::onRemoval(const std::string& serial)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  arrivals_.erase(serial);
+  removed_.insert(serial);
+}
+}  // namespace any_spinnaker_camera_driver
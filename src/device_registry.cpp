@@ -0,0 +1,206 @@
+/**
+Software License Agreement (BSD)
+
+\file      device_registry.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/device_registry.h"
+
+#include <ros/ros.h>
+
+namespace any_spinnaker_camera_driver
+{
+std::shared_ptr<DeviceRegistry> DeviceRegistry::instance()
+{
+  static std::mutex instance_mutex;
+  static std::weak_ptr<DeviceRegistry> instance;
+
+  std::lock_guard<std::mutex> lock(instance_mutex);
+  std::shared_ptr<DeviceRegistry> registry = instance.lock();
+  if (!registry)
+  {
+    registry.reset(new DeviceRegistry());
+    instance = registry;
+  }
+  return registry;
+}
+
+DeviceRegistry::DeviceRegistry() : system_(Spinnaker::System::GetInstance())
+{
+  try
+  {
+    device_events_.reset(new DeviceEventMonitor(system_));
+  }
+  catch (const Spinnaker::Exception& e)
+  {
+    ROS_WARN_STREAM("[DeviceRegistry]: Device events are not available, polling for cameras instead: " << e.what());
+  }
+
+  rescan();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ROS_DEBUG_STREAM_ONCE("[DeviceRegistry]: Number of cameras detected: " << cameras_.GetSize());
+}
+
+DeviceRegistry::~DeviceRegistry()
+{
+  // @note The destructor of system_ handles the teardown once all cameras are released.
+  cameras_.Clear();
+  device_events_.reset();
+}
+
+Spinnaker::CameraPtr DeviceRegistry::find(const std::string& serial, bool rescan)
+{
+  if (rescan)
+  {
+    this->rescan();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Spinnaker::CameraList cameras = cameras_;
+  if (device_events_)
+  {
+    try
+    {
+      // Without updating, the SDK returns the camera lists its interfaces keep current through the events.
+      cameras = system_->GetCameras(false, false);
+    }
+    catch (const Spinnaker::Exception& e)
+    {
+      ROS_DEBUG_STREAM("[DeviceRegistry::find] Failed to get the cached cameras: " << e.what());
+    }
+  }
+
+  try
+  {
+    if (!serial.empty())
+    {
+      Spinnaker::CameraPtr camera = cameras.GetBySerial(serial);
+      if (camera && camera->IsValid())
+      {
+        devices_[serial].last_seen = Clock::now();
+        return camera;
+      }
+    }
+    else
+    {
+      for (unsigned int i = 0; i < cameras.GetSize(); ++i)
+      {
+        Spinnaker::CameraPtr camera = cameras.GetByIndex(i);
+        if (!camera || !camera->IsValid())
+        {
+          continue;
+        }
+        DeviceState& device = devices_[serialOf(camera)];
+        device.last_seen = Clock::now();
+        if (!device.claimed)
+        {
+          return camera;
+        }
+      }
+    }
+  }
+  catch (const Spinnaker::Exception& e)
+  {
+    ROS_DEBUG_STREAM("[DeviceRegistry::find] Camera " << (serial.empty() ? "any" : serial)
+                                                      << " not available: " << e.what());
+  }
+  return static_cast<int>(NULL);
+}
+
+void DeviceRegistry::rescan()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  const uint64_t wanted = rescans_started_ + 1;
+  while (rescans_finished_ < wanted)
+  {
+    if (rescanning_)
+    {
+      rescan_cv_.wait(lock);
+      continue;
+    }
+
+    rescanning_ = true;
+    ++rescans_started_;
+    lock.unlock();
+    Spinnaker::CameraList cameras;
+    bool enumerated = false;
+    try
+    {
+      cameras = system_->GetCameras();
+      enumerated = true;
+    }
+    catch (const Spinnaker::Exception& e)
+    {
+      ROS_WARN_STREAM("[DeviceRegistry::rescan] Failed to enumerate the cameras: " << e.what());
+    }
+    lock.lock();
+    if (enumerated)
+    {
+      cameras_ = cameras;
+    }
+    rescanning_ = false;
+    ++rescans_finished_;
+    rescan_cv_.notify_all();
+  }
+}
+
+bool DeviceRegistry::claim(const std::string& serial)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  DeviceState& device = devices_[serial];
+  if (device.claimed)
+  {
+    return false;
+  }
+  device.claimed = true;
+  ++device.claims;
+  return true;
+}
+
+void DeviceRegistry::release(const std::string& serial)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto device = devices_.find(serial);
+  if (device != devices_.end())
+  {
+    device->second.claimed = false;
+  }
+}
+
+DeviceRegistry::DeviceState DeviceRegistry::getDeviceState(const std::string& serial) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto device = devices_.find(serial);
+  return device != devices_.end() ? device->second : DeviceState();
+}
+
+uint64_t DeviceRegistry::getRescanCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rescans_finished_;
+}
+
+std::string DeviceRegistry::serialOf(Spinnaker::CameraPtr camera)
+{
+  return std::string(camera->TLDevice.DeviceSerialNumber.GetValue().c_str());
+}
+}  // namespace any_spinnaker_camera_driver
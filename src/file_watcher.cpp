@@ -0,0 +1,190 @@
+/**
+Software License Agreement (BSD)
+
+\file      file_watcher.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/file_watcher.h"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+/// Upper bound of a single wait, the path and the stop condition are checked at least this often.
+constexpr int kMaxWaitMs = 100;
+
+bool exists(const std::string& path)
+{
+  struct stat info;
+  return ::stat(path.c_str(), &info) == 0;
+}
+
+/// Closest existing directory above the path.
+std::string existingParent(const std::string& path)
+{
+  std::string dir = path;
+  while (true)
+  {
+    const size_t slash = dir.find_last_of('/');
+    if (slash == std::string::npos)
+    {
+      return ".";
+    }
+    if (slash == 0)
+    {
+      return "/";
+    }
+    dir.erase(slash);
+    if (exists(dir))
+    {
+      return dir;
+    }
+  }
+}
+
+/// Owns an inotify instance and a watch on one directory at a time.
+class DirectoryWatch
+{
+public:
+  DirectoryWatch() : fd_(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+  {
+  }
+
+  ~DirectoryWatch()
+  {
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+    }
+  }
+
+  bool isValid() const
+  {
+    return fd_ >= 0;
+  }
+
+  /// Moves the watch to the directory, if it does not watch it already.
+  void watch(const std::string& dir)
+  {
+    if (dir == dir_ && wd_ >= 0)
+    {
+      return;
+    }
+    if (wd_ >= 0)
+    {
+      ::inotify_rm_watch(fd_, wd_);
+    }
+    dir_ = dir;
+    wd_ = ::inotify_add_watch(fd_, dir.c_str(), IN_CREATE | IN_MOVED_TO | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF);
+  }
+
+  /// Waits for events and consumes them.
+  void wait(int timeout_ms)
+  {
+    pollfd pfd{ fd_, POLLIN, 0 };
+    if (::poll(&pfd, 1, timeout_ms) <= 0)
+    {
+      return;
+    }
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = ::read(fd_, buffer, sizeof(buffer))) > 0)
+    {
+      for (ssize_t offset = 0; offset < length;)
+      {
+        const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+        // The kernel dropped the watch, e.g. because the directory was removed.
+        if (event->wd == wd_ && (event->mask & IN_IGNORED))
+        {
+          wd_ = -1;
+        }
+        offset += sizeof(inotify_event) + event->len;
+      }
+    }
+  }
+
+private:
+  int fd_;
+  int wd_{ -1 };
+  std::string dir_;
+};
+}  // namespace
+
+bool waitForFile(const std::string& path, double timeout, const std::function<bool()>& stop)
+{
+  if (exists(path))
+  {
+    return true;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point deadline =
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::max(timeout, 0.0)));
+
+  // Without inotify this falls back to checking the path periodically.
+  DirectoryWatch watch;
+  while (true)
+  {
+    if (watch.isValid())
+    {
+      watch.watch(existingParent(path));
+    }
+    // Checked after arming the watch, so that a file created in between is not missed.
+    if (exists(path))
+    {
+      return true;
+    }
+    if (stop && stop())
+    {
+      return false;
+    }
+
+    int wait_ms = kMaxWaitMs;
+    if (timeout > 0.0)
+    {
+      const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+      if (remaining <= 0)
+      {
+        return false;
+      }
+      wait_ms = static_cast<int>(std::min<long long>(wait_ms, remaining));
+    }
+
+    if (watch.isValid())
+    {
+      watch.wait(wait_ms);
+    }
+    else
+    {
+      ::usleep(static_cast<useconds_t>(wait_ms) * 1000);
+    }
+  }
+}
+}  // namespace any_spinnaker_camera_driver
@@ -0,0 +1,86 @@
+/**
+Software License Agreement (BSD)
+
+\file      frame_decimator.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/frame_decimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+/// Weight of a new period measurement in the moving average.
+constexpr double PERIOD_FILTER_GAIN = 0.1;
+}  // namespace
+
+FrameDecimator::FrameDecimator(unsigned int factor) : factor_(std::max(1u, factor))
+{
+}
+
+bool FrameDecimator::select(uint64_t stamp_ns)
+{
+  if (last_stamp_ns_ == 0 || stamp_ns <= last_stamp_ns_)
+  {
+    // First frame, or the camera clock was reset (e.g. after a reconnect).
+    last_stamp_ns_ = stamp_ns;
+    last_selected_ns_ = stamp_ns;
+    return true;
+  }
+
+  // Frames missing in between are accounted for, so that drops do not inflate the period estimate.
+  const double delta_ns = static_cast<double>(stamp_ns - last_stamp_ns_);
+  last_stamp_ns_ = stamp_ns;
+  if (period_ns_ <= 0.0)
+  {
+    period_ns_ = delta_ns;
+  }
+  else
+  {
+    const double frames = std::max(1.0, std::round(delta_ns / period_ns_));
+    period_ns_ += PERIOD_FILTER_GAIN * (delta_ns / frames - period_ns_);
+  }
+
+  if (factor_ == 1)
+  {
+    return true;
+  }
+
+  // Half a period of tolerance keeps stamp jitter from pushing the selection to the next frame.
+  const double due_ns = static_cast<double>(last_selected_ns_) + (static_cast<double>(factor_) - 0.5) * period_ns_;
+  if (static_cast<double>(stamp_ns) < due_ns)
+  {
+    return false;
+  }
+  last_selected_ns_ = stamp_ns;
+  return true;
+}
+
+void FrameDecimator::reset()
+{
+  last_stamp_ns_ = 0;
+  last_selected_ns_ = 0;
+  period_ns_ = 0.0;
+}
+}  // namespace any_spinnaker_camera_driver
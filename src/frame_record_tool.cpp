@@ -0,0 +1,212 @@
+/**
+Software License Agreement (BSD)
+
+\file      frame_record_tool.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+   @file frame_record_tool.cpp
+   @brief Command line tool to list and extract frames from a flight recorder file.
+*/
+
+#include "any_spinnaker_camera_driver/frame_recorder.h"
+#include "any_spinnaker_camera_driver/raw_codec.h"
+
+#include <sensor_msgs/image_encodings.h>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+void printUsage()
+{
+  std::cerr << "Usage:" << std::endl
+            << "  frame_record_tool list <recording>" << std::endl
+            << "  frame_record_tool extract <recording> <output_directory> [first] [count]" << std::endl
+            << std::endl
+            << "Frames with an 8 or 16 bit encoding are written as PNG (Bayer frames as raw mosaic), all other frames"
+            << std::endl
+            << "as .raw files containing the unmodified frame buffer. Frames recorded with the raw codec are decoded"
+            << std::endl
+            << "first." << std::endl;
+}
+
+void printMetadata(const any_spinnaker_camera_driver::FrameRecordMetadata& metadata)
+{
+  std::printf("%10lu  %20lu  %20lu  %10lu  %5ux%-5u  %-14s  %9u  %8.2f  %10.1f\n",
+              static_cast<unsigned long>(metadata.sequence), static_cast<unsigned long>(metadata.stamp_ns),
+              static_cast<unsigned long>(metadata.hardware_stamp_ns), static_cast<unsigned long>(metadata.frame_id),
+              metadata.width, metadata.height, metadata.encoding, metadata.data_size, metadata.gain,
+              metadata.exposure_time);
+}
+
+int list(const any_spinnaker_camera_driver::FrameRecordReader& reader)
+{
+  const any_spinnaker_camera_driver::FrameRecordFileHeader& header = reader.getHeader();
+  std::printf("Frames: %zu (sequence %lu to %lu), data segment: %lu bytes, index capacity: %lu, closed: %s\n",
+              reader.size(), static_cast<unsigned long>(header.first_sequence),
+              static_cast<unsigned long>(header.next_sequence), static_cast<unsigned long>(header.data_size),
+              static_cast<unsigned long>(header.index_capacity), reader.wasClosed() ? "yes" : "no");
+  std::printf("%10s  %20s  %20s  %10s  %11s  %-14s  %9s  %8s  %10s\n", "sequence", "stamp [ns]", "hw stamp [ns]",
+              "frame id", "size", "encoding", "bytes", "gain", "exposure");
+
+  for (size_t i = 0; i < reader.size(); ++i)
+  {
+    any_spinnaker_camera_driver::FrameRecordMetadata metadata;
+    const uint8_t* data = nullptr;
+    if (!reader.getFrame(i, &metadata, &data))
+    {
+      std::fprintf(stderr, "Frame %zu is corrupt or was overwritten.\n", i);
+      continue;
+    }
+    printMetadata(metadata);
+  }
+  return 0;
+}
+
+bool writeImage(const std::string& file_name, const any_spinnaker_camera_driver::FrameRecordMetadata& metadata,
+                const uint8_t* data)
+{
+  namespace enc = sensor_msgs::image_encodings;
+  int depth;
+  int channels;
+  try
+  {
+    depth = enc::bitDepth(metadata.encoding);
+    channels = enc::numChannels(metadata.encoding);
+  }
+  catch (const std::runtime_error&)
+  {
+    return false;
+  }
+  if ((depth != 8 && depth != 16) || (channels != 1 && channels != 3) ||
+      static_cast<size_t>(metadata.step) * metadata.height > metadata.data_size)
+  {
+    return false;
+  }
+
+  const int type = CV_MAKETYPE(depth == 8 ? CV_8U : CV_16U, channels);
+  const cv::Mat image(metadata.height, metadata.width, type, const_cast<uint8_t*>(data), metadata.step);
+  if (channels == 3 && std::string(metadata.encoding).find("rgb") == 0)
+  {
+    cv::Mat bgr;
+    cv::cvtColor(image, bgr, cv::COLOR_RGB2BGR);
+    return cv::imwrite(file_name + ".png", bgr);
+  }
+  return cv::imwrite(file_name + ".png", image);
+}
+
+int extract(const any_spinnaker_camera_driver::FrameRecordReader& reader, const std::string& output_directory,
+            size_t first, size_t count)
+{
+  size_t extracted = 0;
+  for (size_t i = first; i < reader.size() && extracted < count; ++i)
+  {
+    any_spinnaker_camera_driver::FrameRecordMetadata metadata;
+    const uint8_t* data = nullptr;
+    if (!reader.getFrame(i, &metadata, &data))
+    {
+      std::fprintf(stderr, "Frame %zu is corrupt or was overwritten.\n", i);
+      continue;
+    }
+
+    std::vector<uint8_t> decoded;
+    if (metadata.flags & any_spinnaker_camera_driver::FRAME_RECORD_FLAG_RAW_CODEC)
+    {
+      any_spinnaker_camera_driver::RawCodecHeader header;
+      try
+      {
+        any_spinnaker_camera_driver::RawCodec::decode(data, metadata.data_size, &header, &decoded);
+      }
+      catch (const std::runtime_error& e)
+      {
+        std::fprintf(stderr, "Frame %zu cannot be decoded: %s\n", i, e.what());
+        continue;
+      }
+      data = decoded.data();
+      metadata.step = static_cast<uint32_t>(decoded.size() / std::max<uint32_t>(1, header.height));
+      metadata.data_size = static_cast<uint32_t>(decoded.size());
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "frame_%010lu", static_cast<unsigned long>(metadata.sequence));
+    const std::string file_name = output_directory + "/" + name;
+    if (!writeImage(file_name, metadata, data))
+    {
+      std::ofstream raw_file(file_name + ".raw", std::ios::binary);
+      raw_file.write(reinterpret_cast<const char*>(data), metadata.data_size);
+      if (!raw_file)
+      {
+        std::fprintf(stderr, "Unable to write %s.raw\n", file_name.c_str());
+        return 1;
+      }
+    }
+    printMetadata(metadata);
+    extracted++;
+  }
+  std::printf("Extracted %zu frames to %s\n", extracted, output_directory.c_str());
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage();
+    return 1;
+  }
+
+  const std::string command(argv[1]);
+  try
+  {
+    const any_spinnaker_camera_driver::FrameRecordReader reader(argv[2]);
+    if (command == "list")
+    {
+      return list(reader);
+    }
+    else if (command == "extract" && argc >= 4)
+    {
+      const size_t first = argc >= 5 ? std::stoul(argv[4]) : 0;
+      const size_t count = argc >= 6 ? std::stoul(argv[5]) : reader.size();
+      return extract(reader, argv[3], first, count);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  printUsage();
+  return 1;
+}
@@ -0,0 +1,317 @@
+/**
+Software License Agreement (BSD)
+
+\file      frame_recorder.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/frame_recorder.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+const char FRAME_RECORD_MAGIC[8] = { 'S', 'P', 'N', 'K', 'R', 'E', 'C', '\0' };
+
+size_t alignUp(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t pageSize()
+{
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+/// msync() requires a page aligned start address.
+void syncRange(uint8_t* begin, size_t length)
+{
+  if (length == 0)
+    return;
+  const uintptr_t address = reinterpret_cast<uintptr_t>(begin);
+  const uintptr_t aligned = address / pageSize() * pageSize();
+  msync(reinterpret_cast<void*>(aligned), length + (address - aligned), MS_SYNC);
+}
+
+std::string errnoString()
+{
+  return std::string(std::strerror(errno));
+}
+}  // namespace
+
+FrameRecorder::FrameRecorder(const std::string& path, size_t file_size, size_t index_capacity, double flush_period)
+  : path_(path), flush_period_(flush_period)
+{
+  if (index_capacity == 0)
+  {
+    throw std::runtime_error("[FrameRecorder] The frame index needs a capacity of at least one frame.");
+  }
+
+  const size_t header_size = pageSize();
+  const size_t index_size = alignUp(index_capacity * sizeof(FrameIndexEntry), pageSize());
+  const size_t data_offset = header_size + index_size;
+  if (file_size <= data_offset + RECORD_ALIGNMENT)
+  {
+    throw std::runtime_error("[FrameRecorder] File size of " + std::to_string(file_size) +
+                             " bytes is too small for an index of " + std::to_string(index_capacity) + " frames.");
+  }
+  map_size_ = alignUp(file_size, pageSize());
+
+  fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0)
+  {
+    throw std::runtime_error("[FrameRecorder] Unable to open '" + path_ + "': " + errnoString());
+  }
+
+  // Reserve the blocks now, so that recording never has to wait for the file system to allocate space.
+  const int fallocate_error = posix_fallocate(fd_, 0, static_cast<off_t>(map_size_));
+  if (fallocate_error != 0)
+  {
+    close(fd_);
+    throw std::runtime_error("[FrameRecorder] Unable to allocate " + std::to_string(map_size_) + " bytes for '" +
+                             path_ + "': " + std::strerror(fallocate_error));
+  }
+
+  // Pre-fault the mapping, the acquisition thread must not take page faults on the first lap.
+  void* map = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, 0);
+  if (map == MAP_FAILED)
+  {
+    close(fd_);
+    throw std::runtime_error("[FrameRecorder] Unable to map '" + path_ + "': " + errnoString());
+  }
+  map_ = static_cast<uint8_t*>(map);
+
+  header_ = reinterpret_cast<FrameRecordFileHeader*>(map_);
+  index_ = reinterpret_cast<FrameIndexEntry*>(map_ + header_size);
+  data_ = map_ + data_offset;
+
+  std::memset(map_, 0, data_offset);
+  std::memcpy(header_->magic, FRAME_RECORD_MAGIC, sizeof(FRAME_RECORD_MAGIC));
+  header_->version = VERSION;
+  header_->header_size = static_cast<uint32_t>(header_size);
+  header_->file_size = map_size_;
+  header_->index_offset = header_size;
+  header_->index_capacity = index_capacity;
+  header_->data_offset = data_offset;
+  header_->data_size = (map_size_ - data_offset) / RECORD_ALIGNMENT * RECORD_ALIGNMENT;
+  syncRange(map_, data_offset);
+
+  flush_thread_ = std::thread(&FrameRecorder::flushLoop, this);
+}
+
+FrameRecorder::~FrameRecorder()
+{
+  {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    running_ = false;
+  }
+  flush_cv_.notify_all();
+  if (flush_thread_.joinable())
+    flush_thread_.join();
+
+  flush();
+  header_->closed = 1;
+  syncRange(map_, header_->header_size);
+
+  munmap(map_, map_size_);
+  close(fd_);
+}
+
+bool FrameRecorder::record(const FrameRecordMetadata& metadata, const uint8_t* data, size_t size)
+{
+  const uint64_t data_size = header_->data_size;
+  const uint64_t capacity = header_->index_capacity;
+  const uint64_t record_size = alignUp(sizeof(FrameRecordMetadata) + size, RECORD_ALIGNMENT);
+  if (record_size > data_size)
+  {
+    dropped_frames_++;
+    return false;
+  }
+
+  // Records never wrap around the end of the data segment, the remainder is left as a gap.
+  uint64_t offset = write_offset_;
+  uint64_t gap = 0;
+  if (offset + record_size > data_size)
+  {
+    gap = data_size - offset;
+    offset = 0;
+  }
+
+  // Drop the oldest records from the index as long as they are about to be overwritten, or their index slot is reused.
+  while (first_sequence_ < next_sequence_)
+  {
+    const FrameIndexEntry& oldest = index_[first_sequence_ % capacity];
+    const bool index_full = next_sequence_ - first_sequence_ >= capacity;
+    const bool behind_gap = gap > 0 && oldest.offset >= write_offset_;
+    const bool overlaps = oldest.offset < offset + record_size && offset < oldest.offset + oldest.size;
+    if (!index_full && !behind_gap && !overlaps)
+      break;
+    ++first_sequence_;
+  }
+  header_->first_sequence = first_sequence_;
+  std::atomic_thread_fence(std::memory_order_release);
+
+  FrameRecordMetadata record_metadata = metadata;
+  record_metadata.sequence = next_sequence_;
+  record_metadata.data_size = static_cast<uint32_t>(size);
+  std::memcpy(data_ + offset, &record_metadata, sizeof(FrameRecordMetadata));
+  std::memcpy(data_ + offset + sizeof(FrameRecordMetadata), data, size);
+
+  FrameIndexEntry& entry = index_[next_sequence_ % capacity];
+  entry.sequence = next_sequence_;
+  entry.offset = offset;
+  entry.size = record_size;
+  entry.stamp_ns = metadata.stamp_ns;
+  std::atomic_thread_fence(std::memory_order_release);
+
+  ++next_sequence_;
+  write_offset_ = offset + record_size;
+  header_->next_sequence = next_sequence_;
+  header_->write_offset = write_offset_;
+
+  written_bytes_.fetch_add(gap + record_size, std::memory_order_release);
+  recorded_frames_++;
+  return true;
+}
+
+void FrameRecorder::flushLoop()
+{
+  std::unique_lock<std::mutex> lock(flush_mutex_);
+  while (running_)
+  {
+    flush_cv_.wait_for(lock, std::chrono::duration<double>(flush_period_), [this] { return !running_; });
+    lock.unlock();
+    flush();
+    lock.lock();
+  }
+}
+
+void FrameRecorder::flush()
+{
+  // The data segment is written sequentially, so everything between the last flush and the current write position is
+  // dirty. Positions are counted in bytes since the start of the recording and map onto the ring modulo its size.
+  const uint64_t written = written_bytes_.load(std::memory_order_acquire);
+  const uint64_t data_size = header_->data_size;
+  const uint64_t length = written - flushed_bytes_;
+  if (length >= data_size)
+  {
+    syncRange(data_, data_size);
+  }
+  else if (length > 0)
+  {
+    const uint64_t start = flushed_bytes_ % data_size;
+    const uint64_t head = std::min(length, data_size - start);
+    syncRange(data_ + start, head);
+    syncRange(data_, length - head);
+  }
+  flushed_bytes_ = written;
+
+  // Header and index
+  syncRange(map_, header_->data_offset);
+}
+
+FrameRecordReader::FrameRecordReader(const std::string& path)
+{
+  fd_ = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0)
+  {
+    throw std::runtime_error("[FrameRecordReader] Unable to open '" + path + "': " + errnoString());
+  }
+
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(FrameRecordFileHeader))
+  {
+    close(fd_);
+    throw std::runtime_error("[FrameRecordReader] '" + path + "' is not a frame recording.");
+  }
+  map_size_ = static_cast<size_t>(file_stat.st_size);
+
+  void* map = mmap(nullptr, map_size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (map == MAP_FAILED)
+  {
+    close(fd_);
+    throw std::runtime_error("[FrameRecordReader] Unable to map '" + path + "': " + errnoString());
+  }
+  map_ = static_cast<const uint8_t*>(map);
+  std::memcpy(&header_, map_, sizeof(FrameRecordFileHeader));
+
+  const bool valid = std::memcmp(header_.magic, FRAME_RECORD_MAGIC, sizeof(FRAME_RECORD_MAGIC)) == 0 &&
+                     header_.version == FrameRecorder::VERSION && header_.index_capacity > 0 &&
+                     header_.index_offset + header_.index_capacity * sizeof(FrameIndexEntry) <= header_.data_offset &&
+                     header_.data_offset + header_.data_size <= map_size_ &&
+                     header_.first_sequence <= header_.next_sequence;
+  if (!valid)
+  {
+    munmap(const_cast<uint8_t*>(map_), map_size_);
+    close(fd_);
+    throw std::runtime_error("[FrameRecordReader] '" + path + "' is not a valid frame recording (version " +
+                             std::to_string(FrameRecorder::VERSION) + ").");
+  }
+
+  index_ = reinterpret_cast<const FrameIndexEntry*>(map_ + header_.index_offset);
+  data_ = map_ + header_.data_offset;
+}
+
+FrameRecordReader::~FrameRecordReader()
+{
+  munmap(const_cast<uint8_t*>(map_), map_size_);
+  close(fd_);
+}
+
+size_t FrameRecordReader::size() const
+{
+  return static_cast<size_t>(header_.next_sequence - header_.first_sequence);
+}
+
+bool FrameRecordReader::getFrame(size_t i, FrameRecordMetadata* metadata, const uint8_t** data) const
+{
+  if (i >= size())
+    return false;
+
+  const uint64_t sequence = header_.first_sequence + i;
+  const FrameIndexEntry& entry = index_[sequence % header_.index_capacity];
+  if (entry.sequence != sequence || entry.size < sizeof(FrameRecordMetadata) ||
+      entry.offset + entry.size > header_.data_size)
+  {
+    return false;
+  }
+
+  std::memcpy(metadata, data_ + entry.offset, sizeof(FrameRecordMetadata));
+  if (metadata->sequence != sequence || sizeof(FrameRecordMetadata) + metadata->data_size > entry.size)
+  {
+    return false;
+  }
+  *data = data_ + entry.offset + sizeof(FrameRecordMetadata);
+  return true;
+}
+}  // namespace any_spinnaker_camera_driver
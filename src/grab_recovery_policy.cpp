@@ -0,0 +1,120 @@
+/**
+Software License Agreement (BSD)
+
+\file      grab_recovery_policy.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/grab_recovery_policy.h"
+
+#include <algorithm>
+
+namespace any_spinnaker_camera_driver
+{
+GrabRecoveryPolicy::GrabRecoveryPolicy() = default;
+
+GrabRecoveryPolicy::GrabRecoveryPolicy(const Config& config) : config_(config)
+{
+}
+
+void GrabRecoveryPolicy::setConfig(const Config& config)
+{
+  config_ = config;
+}
+
+GrabRecoveryPolicy::Tier GrabRecoveryPolicy::onFailure(Clock::time_point now, bool device_lost)
+{
+  if (!in_incident_)
+  {
+    in_incident_ = true;
+    failures_ = 0;
+    tier_ = Tier::NONE;
+    incident_start_ = now;
+  }
+
+  if (device_lost)
+  {
+    failures_ = config_.retries + config_.rearms + config_.reinits;
+  }
+  const unsigned int failure = failures_++;
+  Tier tier = Tier::RECONNECT;
+  if (failure < config_.retries)
+  {
+    tier = Tier::RETRY;
+  }
+  else if (failure < config_.retries + config_.rearms)
+  {
+    tier = Tier::REARM;
+  }
+  else if (failure < config_.retries + config_.rearms + config_.reinits)
+  {
+    tier = Tier::REINIT;
+  }
+  else
+  {
+    // The reconnect is retried until it succeeds, start counting from it to not overflow.
+    failures_ = config_.retries + config_.rearms + config_.reinits;
+  }
+  tier_ = std::max(tier_, tier);
+  return tier;
+}
+
+bool GrabRecoveryPolicy::onSuccess(Clock::time_point now)
+{
+  if (!in_incident_)
+  {
+    return false;
+  }
+  in_incident_ = false;
+
+  const double downtime_ms = std::chrono::duration<double, std::milli>(now - incident_start_).count();
+  std::lock_guard<std::mutex> lock(statistics_mutex_);
+  statistics_.incidents++;
+  statistics_.last_downtime_ms = downtime_ms;
+  statistics_.max_downtime_ms = std::max(statistics_.max_downtime_ms, downtime_ms);
+  statistics_.last_tier = tier_;
+  statistics_.incidents_per_tier[static_cast<size_t>(tier_)]++;
+  return true;
+}
+
+GrabRecoveryPolicy::Statistics GrabRecoveryPolicy::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(statistics_mutex_);
+  return statistics_;
+}
+
+std::string GrabRecoveryPolicy::toString(Tier tier)
+{
+  switch (tier)
+  {
+    case Tier::NONE:
+      return "none";
+    case Tier::RETRY:
+      return "retry";
+    case Tier::REARM:
+      return "re-arm";
+    case Tier::REINIT:
+      return "re-init";
+    case Tier::RECONNECT:
+      return "reconnect";
+  }
+  return "unknown";
+}
+}  // namespace any_spinnaker_camera_driver
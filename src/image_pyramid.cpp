@@ -0,0 +1,247 @@
+/**
+Software License Agreement (BSD)
+
+\file      image_pyramid.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/image_pyramid.h"
+
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+
+#include <stdexcept>
+
+// The row kernels are built for AVX2 and the baseline, the dynamic loader picks the variant supported by the CPU.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define PYRAMID_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define PYRAMID_KERNEL
+#endif
+
+#if defined(__GNUC__)
+#define PYRAMID_INLINE inline __attribute__((always_inline))
+#else
+#define PYRAMID_INLINE inline
+#endif
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+/// How a source is reduced to half resolution.
+struct Format
+{
+  bool superpixel{ false };  ///< Bayer cells to RGB pixels instead of a box filter.
+  BayerDemosaicer::Pattern pattern{ BayerDemosaicer::Pattern::RGGB };
+  unsigned int bytes{ 1 };     ///< Bytes per channel, 1 or 2.
+  unsigned int channels{ 1 };  ///< Channels of the source, 1 for Bayer images.
+
+  unsigned int reducedChannels() const
+  {
+    return superpixel ? 3 : channels;
+  }
+};
+
+bool parseFormat(const std::string& encoding, Format* format)
+{
+  unsigned int bit_depth;
+  if (BayerDemosaicer::parseEncoding(encoding, &format->pattern, &bit_depth))
+  {
+    format->superpixel = true;
+    format->bytes = bit_depth / 8;
+    format->channels = 1;
+    return true;
+  }
+  format->superpixel = false;
+  if (encoding == "mono8" || encoding == "mono16")
+  {
+    format->channels = 1;
+  }
+  else if (encoding == "rgb8" || encoding == "bgr8" || encoding == "rgb16" || encoding == "bgr16")
+  {
+    format->channels = 3;
+  }
+  else
+  {
+    return false;
+  }
+  format->bytes = encoding.back() == '6' ? 2 : 1;
+  return true;
+}
+
+/** Averages 2 x 2 pixels of two rows. */
+template <typename T, unsigned int Channels>
+PYRAMID_INLINE void boxRow(const T* __restrict row0, const T* __restrict row1, size_t out_width, T* __restrict out)
+{
+  for (size_t x = 0; x < out_width; ++x)
+  {
+    for (unsigned int c = 0; c < Channels; ++c)
+    {
+      const size_t i = 2 * x * Channels + c;
+      out[x * Channels + c] =
+          static_cast<T>((row0[i] + row0[i + Channels] + row1[i] + row1[i + Channels] + 2) >> 2);
+    }
+  }
+}
+
+/**
+ * Turns the Bayer cells of two rows into RGB pixels, averaging the two greens.
+ * Red and Blue are the positions in the cell: 0 top left, 1 top right, 2 bottom left, 3 bottom right.
+ */
+template <typename T, unsigned int Red, unsigned int Blue>
+PYRAMID_INLINE void superpixelRow(const T* __restrict row0, const T* __restrict row1, size_t out_width,
+                                  T* __restrict out)
+{
+  for (size_t x = 0; x < out_width; ++x)
+  {
+    const unsigned int cell[4] = { row0[2 * x], row0[2 * x + 1], row1[2 * x], row1[2 * x + 1] };
+    const unsigned int greens = cell[0] + cell[1] + cell[2] + cell[3] - cell[Red] - cell[Blue];
+    out[3 * x] = static_cast<T>(cell[Red]);
+    out[3 * x + 1] = static_cast<T>((greens + 1) >> 1);
+    out[3 * x + 2] = static_cast<T>(cell[Blue]);
+  }
+}
+
+template <typename T>
+PYRAMID_INLINE void superpixelRow(BayerDemosaicer::Pattern pattern, const T* row0, const T* row1, size_t out_width,
+                                  T* out)
+{
+  switch (pattern)
+  {
+    case BayerDemosaicer::Pattern::RGGB:
+      superpixelRow<T, 0, 3>(row0, row1, out_width, out);
+      break;
+    case BayerDemosaicer::Pattern::GRBG:
+      superpixelRow<T, 1, 2>(row0, row1, out_width, out);
+      break;
+    case BayerDemosaicer::Pattern::GBRG:
+      superpixelRow<T, 2, 1>(row0, row1, out_width, out);
+      break;
+    case BayerDemosaicer::Pattern::BGGR:
+      superpixelRow<T, 3, 0>(row0, row1, out_width, out);
+      break;
+  }
+}
+
+template <typename T>
+PYRAMID_INLINE void boxRow(unsigned int channels, const T* row0, const T* row1, size_t out_width, T* out)
+{
+  if (channels == 3)
+  {
+    boxRow<T, 3>(row0, row1, out_width, out);
+  }
+  else
+  {
+    boxRow<T, 1>(row0, row1, out_width, out);
+  }
+}
+
+/** Reduces two rows of the given format to one row at half resolution. */
+PYRAMID_KERNEL void reduceRow(const Format& format, const uint8_t* row0, const uint8_t* row1, size_t out_width,
+                              uint8_t* out)
+{
+  if (format.bytes == 1)
+  {
+    if (format.superpixel)
+    {
+      superpixelRow<uint8_t>(format.pattern, row0, row1, out_width, out);
+    }
+    else
+    {
+      boxRow<uint8_t>(format.channels, row0, row1, out_width, out);
+    }
+    return;
+  }
+  const auto* wide_row0 = reinterpret_cast<const uint16_t*>(row0);
+  const auto* wide_row1 = reinterpret_cast<const uint16_t*>(row1);
+  auto* wide_out = reinterpret_cast<uint16_t*>(out);
+  if (format.superpixel)
+  {
+    superpixelRow<uint16_t>(format.pattern, wide_row0, wide_row1, out_width, wide_out);
+  }
+  else
+  {
+    boxRow<uint16_t>(format.channels, wide_row0, wide_row1, out_width, wide_out);
+  }
+}
+}  // namespace
+
+bool ImagePyramid::getReducedEncoding(const std::string& encoding, std::string* reduced_encoding)
+{
+  Format format;
+  if (!parseFormat(encoding, &format))
+  {
+    return false;
+  }
+  *reduced_encoding = format.superpixel ? (format.bytes == 1 ? "rgb8" : "rgb16") : encoding;
+  return true;
+}
+
+size_t ImagePyramid::getReducedPixelSize(const std::string& encoding)
+{
+  Format format;
+  if (!parseFormat(encoding, &format))
+  {
+    return 0;
+  }
+  return format.reducedChannels() * format.bytes;
+}
+
+void ImagePyramid::reduce(const void* src, size_t width, size_t height, size_t src_step, const std::string& encoding,
+                          void* half, size_t half_step, void* quarter, size_t quarter_step)
+{
+  Format format;
+  if (!parseFormat(encoding, &format))
+  {
+    throw std::runtime_error("[ImagePyramid::reduce] Images with encoding " + encoding + " cannot be reduced.");
+  }
+  if (half == nullptr && quarter == nullptr)
+  {
+    return;
+  }
+
+  const size_t half_width = width / 2;
+  const size_t half_height = height / 2;
+  const size_t half_row_size = half_width * format.reducedChannels() * format.bytes;
+  if (half == nullptr && scratch_.size() < 2 * half_row_size)
+  {
+    scratch_.resize(2 * half_row_size);
+  }
+  // The quarter resolution is a box filter on the RGB half resolution.
+  Format half_format = format;
+  half_format.superpixel = false;
+  half_format.channels = format.reducedChannels();
+
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+  auto* half_bytes = static_cast<uint8_t*>(half);
+  auto* quarter_bytes = static_cast<uint8_t*>(quarter);
+  for (size_t y = 0; y < half_height; ++y)
+  {
+    uint8_t* half_row = half_bytes != nullptr ? half_bytes + y * half_step : scratch_.data() + (y & 1) * half_row_size;
+    reduceRow(format, src_bytes + 2 * y * src_step, src_bytes + (2 * y + 1) * src_step, half_width, half_row);
+    if (quarter_bytes != nullptr && (y & 1) != 0)
+    {
+      const uint8_t* previous_half_row = half_bytes != nullptr ? half_bytes + (y - 1) * half_step : scratch_.data();
+      reduceRow(half_format, previous_half_row, half_row, half_width / 2, quarter_bytes + (y / 2) * quarter_step);
+    }
+  }
+}
+}  // namespace any_spinnaker_camera_driver
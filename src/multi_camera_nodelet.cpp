@@ -0,0 +1,477 @@
+/**
+Software License Agreement (BSD)
+
+\file      multi_camera_nodelet.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// ROS and associated nodelet interface and PLUGINLIB declaration header
+#include "ros/ros.h"
+#include <pluginlib/class_list_macros.h>
+#include <nodelet/nodelet.h>
+
+#include "any_spinnaker_camera_driver/SpinnakerCamera.h"
+#include "any_spinnaker_camera_driver/camera_exceptions.h"
+#include "any_spinnaker_camera_driver/frame_synchronizer.h"
+#include "any_spinnaker_camera_driver/grab_recovery_policy.h"
+
+#include <camera_info_manager/camera_info_manager.h>
+#include <image_transport/image_transport.h>
+#include <sensor_msgs/CameraInfo.h>
+#include <sensor_msgs/Image.h>
+
+#include <diagnostic_updater/diagnostic_updater.h>
+
+#include <dynamic_reconfigure/server.h>
+
+#include <boost/thread.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace any_spinnaker_camera_driver
+{
+/**
+ * Drives several cameras on a shared hardware trigger from one nodelet and publishes their frames as synchronized
+ * sets.
+ *
+ * The frames are paired by camera time stamp, or by frame counter once the counter offsets are known, see
+ * FrameSynchronizer. All images and CameraInfos of a set are published with the same stamp, so that consumers like
+ * stereo_image_proc can use exact time synchronization. Frames without partners are dropped.
+ * All cameras share one dynamic_reconfigure configuration.
+ */
+class SpinnakerMultiCameraNodelet : public nodelet::Nodelet
+{
+public:
+  SpinnakerMultiCameraNodelet()
+  {
+  }
+
+  ~SpinnakerMultiCameraNodelet()
+  {
+    for (auto& camera : cameras_)
+    {
+      if (camera->thread)
+      {
+        camera->thread->interrupt();
+        camera->thread->join();
+      }
+      try
+      {
+        camera->driver.stop();
+        camera->driver.disconnect();
+      }
+      catch (const std::runtime_error& e)
+      {
+        NODELET_ERROR("%s", e.what());
+      }
+    }
+  }
+
+private:
+  using Synchronizer = FrameSynchronizer<sensor_msgs::ImagePtr>;
+
+  /// A camera of the synchronized set.
+  struct CameraStream
+  {
+    std::string name;
+    std::string frame_id;
+    SpinnakerCamera driver;
+    std::shared_ptr<camera_info_manager::CameraInfoManager> cinfo;
+    image_transport::CameraPublisher publisher;
+    std::shared_ptr<boost::thread> thread;  ///< Grabs the frames of this camera.
+    bool connected{ false };                ///< Connected and configured, guarded by config_mutex_.
+    GrabRecoveryPolicy recovery;            ///< Escalates the recovery from failed grabs, used by the grab thread.
+    /// Binning times decimation of the last grabbed frame, as applied by the camera and the driver.
+    std::atomic<unsigned int> binning_x{ 1 };
+    std::atomic<unsigned int> binning_y{ 1 };
+  };
+
+  void onInit()
+  {
+    ros::NodeHandle& nh = getMTNodeHandle();
+    ros::NodeHandle& pnh = getMTPrivateNodeHandle();
+
+    std::vector<std::string> names;
+    pnh.param<std::vector<std::string>>("cameras", names, std::vector<std::string>());
+    if (names.size() < 2)
+    {
+      NODELET_ERROR("At least two cameras have to be listed in the cameras parameter.");
+      return;
+    }
+
+    Synchronizer::Config sync_config;
+    pnh.param<double>("sync/tolerance", sync_config.tolerance, 0.005);
+    int queue_size;
+    pnh.param<int>("sync/queue_size", queue_size, 4);
+    sync_config.queue_size = static_cast<size_t>(std::max(1, queue_size));
+    pnh.param<bool>("sync/shared_clock", sync_config.shared_clock, false);
+    pnh.param<bool>("sync/use_frame_ids", sync_config.use_frame_ids, false);
+    pnh.param<double>("sync/min_pairing_rate", min_pairing_rate_, 0.9);
+    synchronizer_.reset(new Synchronizer(names.size(), sync_config));
+
+    pnh.param<double>("timeout", timeout_, 1.0);
+
+    // Recovery from failed grabs, as in the single camera driver: retries, re-arms, re-initializations, reconnects.
+    GrabRecoveryPolicy::Config recovery_config;
+    int recovery_retries, recovery_rearms, recovery_reinits;
+    pnh.param<int>("recovery/retries", recovery_retries, 2);
+    pnh.param<int>("recovery/rearms", recovery_rearms, 1);
+    pnh.param<int>("recovery/reinits", recovery_reinits, 1);
+    recovery_config.retries = static_cast<unsigned int>(std::max(0, recovery_retries));
+    recovery_config.rearms = static_cast<unsigned int>(std::max(0, recovery_rearms));
+    recovery_config.reinits = static_cast<unsigned int>(std::max(0, recovery_reinits));
+
+    it_.reset(new image_transport::ImageTransport(nh));
+    for (const std::string& name : names)
+    {
+      std::unique_ptr<CameraStream> camera(new CameraStream);
+      camera->name = name;
+      int serial;
+      pnh.param<int>(name + "/serial", serial, 0);
+      if (serial == 0)
+      {
+        NODELET_ERROR("No serial given for camera %s, all cameras of a synchronized set need one.", name.c_str());
+        return;
+      }
+      camera->driver.setDesiredCamera(static_cast<uint32_t>(serial));
+      camera->recovery.setConfig(recovery_config);
+      pnh.param<std::string>(name + "/frame_id", camera->frame_id, name);
+      std::string camera_info_url;
+      pnh.param<std::string>(name + "/camera_info_url", camera_info_url, "");
+      ros::NodeHandle camera_nh(nh, name);
+      camera->cinfo.reset(new camera_info_manager::CameraInfoManager(camera_nh, std::to_string(serial), camera_info_url));
+      camera->publisher = it_->advertiseCamera(name + "/image_raw", 5);
+      cameras_.push_back(std::move(camera));
+    }
+
+    updater_.setHardwareID(nh.getNamespace());
+    updater_.add("Synchronization", this, &SpinnakerMultiCameraNodelet::getSyncState);
+    diagnostics_timer_ =
+        nh.createWallTimer(ros::WallDuration(1.0), &SpinnakerMultiCameraNodelet::diagnosticsTimerCb, this);
+
+    // The callback stores the configuration, the grab threads apply it when they connect.
+    srv_ = std::make_shared<dynamic_reconfigure::Server<any_spinnaker_camera_driver::SpinnakerConfig>>(pnh);
+    dynamic_reconfigure::Server<any_spinnaker_camera_driver::SpinnakerConfig>::CallbackType f =
+        boost::bind(&SpinnakerMultiCameraNodelet::paramCallback, this, _1, _2);
+    srv_->setCallback(f);
+
+    for (size_t i = 0; i < cameras_.size(); ++i)
+    {
+      cameras_[i]->thread.reset(new boost::thread(boost::bind(&SpinnakerMultiCameraNodelet::grabLoop, this, i)));
+    }
+  }
+
+  void paramCallback(const any_spinnaker_camera_driver::SpinnakerConfig& config, uint32_t level)
+  {
+    std::lock_guard<std::mutex> scopedLock(config_mutex_);
+    config_ = config;
+    configured_ = true;
+    for (auto& camera : cameras_)
+    {
+      if (!camera->connected)
+      {
+        continue;
+      }
+      try
+      {
+        camera->driver.setNewConfiguration(config, level);
+      }
+      catch (const std::runtime_error& e)
+      {
+        NODELET_ERROR("Reconfiguring camera %s failed with error: %s", camera->name.c_str(), e.what());
+      }
+    }
+  }
+
+  /*!
+  * \brief Connects to one camera and hands its frames to the synchronizer until the nodelet shuts down.
+  *
+  * \param index Index of the camera in cameras_.
+  */
+  void grabLoop(size_t index)
+  {
+    CameraStream& camera = *cameras_[index];
+    while (!boost::this_thread::interruption_requested())
+    {
+      try
+      {
+        if (!camera.connected)
+        {
+          if (!camera.driver.connect())
+          {
+            throw std::runtime_error("Failed to connect to camera " + camera.name + ".");
+          }
+          {
+            std::lock_guard<std::mutex> scopedLock(config_mutex_);
+            if (configured_)
+            {
+              camera.driver.restoreConfiguration(config_, true);
+            }
+            camera.connected = true;
+          }
+          camera.driver.setTimeout(timeout_);
+          camera.driver.start();
+          NODELET_INFO("Camera %s started.", camera.name.c_str());
+        }
+
+        sensor_msgs::ImagePtr image(new sensor_msgs::Image);
+        FrameInfo frame_info;
+        bool grabbed;
+        try
+        {
+          grabbed = camera.driver.grabImage(image.get(), camera.frame_id, &frame_info);
+        }
+        catch (const CameraTimeoutException&)
+        {
+          throw;
+        }
+        catch (const std::runtime_error& e)
+        {
+          NODELET_ERROR("Camera %s: %s", camera.name.c_str(), e.what());
+          grabbed = false;
+        }
+        if (!grabbed)
+        {
+          recoverFromGrabFailure(camera);
+          continue;
+        }
+        if (camera.recovery.onSuccess())
+        {
+          const GrabRecoveryPolicy::Statistics recovery = camera.recovery.getStatistics();
+          NODELET_INFO("Camera %s recovered from grab failures after %.1f ms, recovery tier reached: %s.",
+                       camera.name.c_str(), recovery.last_downtime_ms,
+                       GrabRecoveryPolicy::toString(recovery.last_tier).c_str());
+        }
+        camera.binning_x = frame_info.binning_x;
+        camera.binning_y = frame_info.binning_y;
+        Synchronizer::Frame frame;
+        frame.hardware_stamp_ns = frame_info.hardware_stamp_ns;
+        frame.frame_id = frame_info.frame_id;
+        frame.receive_stamp_ns = ros::Time::now().toNSec();
+        frame.payload = image;
+        addFrame(index, std::move(frame));
+      }
+      catch (const CameraTimeoutException& e)
+      {
+        // The trigger may just be paused.
+        NODELET_DEBUG("Camera %s: %s", camera.name.c_str(), e.what());
+      }
+      catch (const std::runtime_error& e)
+      {
+        NODELET_ERROR("Camera %s: %s", camera.name.c_str(), e.what());
+        disconnectCamera(camera);
+        ros::Duration(1.0).sleep();
+      }
+    }
+  }
+
+  /*!
+  * \brief Releases a camera, the grab thread connects to it again.
+  */
+  void disconnectCamera(CameraStream& camera)
+  {
+    {
+      std::lock_guard<std::mutex> scopedLock(config_mutex_);
+      camera.connected = false;
+    }
+    try
+    {
+      camera.driver.stop();
+      camera.driver.disconnect();
+    }
+    catch (const std::runtime_error& e)
+    {
+      NODELET_ERROR("Camera %s: %s", camera.name.c_str(), e.what());
+    }
+  }
+
+  /*!
+  * \brief Takes the recovery action for a failed grab that the recovery policy of the camera chooses.
+  *
+  * Transient failures are handled in place, only repeated ones lead to a reconnect.
+  */
+  void recoverFromGrabFailure(CameraStream& camera)
+  {
+    // A removed camera will not come back by retrying, reconnect once it arrived again.
+    const bool device_lost = camera.driver.wasRemoved();
+    const GrabRecoveryPolicy::Tier tier = camera.recovery.onFailure(GrabRecoveryPolicy::Clock::now(), device_lost);
+    try
+    {
+      switch (tier)
+      {
+        case GrabRecoveryPolicy::Tier::RETRY:
+          break;
+        case GrabRecoveryPolicy::Tier::REARM:
+          NODELET_WARN("Re-arming camera %s after repeated grab failures.", camera.name.c_str());
+          camera.driver.stop();
+          camera.driver.start();
+          break;
+        case GrabRecoveryPolicy::Tier::REINIT:
+          NODELET_WARN("Re-initializing camera %s after repeated grab failures.", camera.name.c_str());
+          camera.driver.reinitialize();
+          {
+            std::lock_guard<std::mutex> scopedLock(config_mutex_);
+            if (configured_)
+            {
+              camera.driver.restoreConfiguration(config_, true);
+            }
+          }
+          camera.driver.start();
+          break;
+        default:
+          NODELET_WARN("Reconnecting to camera %s after repeated grab failures.", camera.name.c_str());
+          disconnectCamera(camera);
+          break;
+      }
+    }
+    catch (const std::runtime_error& e)
+    {
+      // The next grab fails as well and escalates further.
+      NODELET_ERROR("Recovery (%s) of camera %s failed: %s", GrabRecoveryPolicy::toString(tier).c_str(),
+                    camera.name.c_str(), e.what());
+    }
+  }
+
+  /*!
+  * \brief Adds a frame to the synchronizer and publishes the set it completes.
+  */
+  void addFrame(size_t index, Synchronizer::Frame frame)
+  {
+    Synchronizer::Set set;
+    uint64_t sequence;
+    {
+      std::lock_guard<std::mutex> scopedLock(sync_mutex_);
+      if (!synchronizer_->add(index, std::move(frame), &set))
+      {
+        return;
+      }
+      sequence = next_set_++;
+    }
+
+    // The grab threads publish the sets in the order they were completed, so that the stamps never go backwards.
+    std::unique_lock<std::mutex> lock(publish_mutex_);
+    publish_cv_.wait(lock, [&] { return next_publish_ == sequence; });
+    try
+    {
+      publishSet(set);
+    }
+    catch (const std::exception& e)
+    {
+      NODELET_ERROR_THROTTLE(1.0, "Failed to publish a synchronized set: %s", e.what());
+    }
+    ++next_publish_;
+    publish_cv_.notify_all();
+  }
+
+  /*!
+  * \brief Publishes the images of a synchronized set with a common stamp.
+  */
+  void publishSet(const Synchronizer::Set& set)
+  {
+    ros::Time stamp;
+    stamp.fromNSec(set.stamp_ns);
+    for (size_t i = 0; i < cameras_.size(); ++i)
+    {
+      CameraStream& camera = *cameras_[i];
+      const sensor_msgs::ImagePtr& image = set.frames[i].payload;
+      image->header.stamp = stamp;
+      image->header.frame_id = camera.frame_id;
+
+      sensor_msgs::CameraInfoPtr ci(new sensor_msgs::CameraInfo(camera.cinfo->getCameraInfo()));
+      ci->header = image->header;
+      // No separate param in CameraInfo for binning/decimation
+      ci->binning_x = camera.binning_x;
+      ci->binning_y = camera.binning_y;
+      camera.publisher.publish(image, ci);
+    }
+  }
+
+  void diagnosticsTimerCb(const ros::WallTimerEvent& /*event*/)
+  {
+    updater_.update();
+  }
+
+  /*!
+  * \brief Reports the pairing rate and the skew between the cameras.
+  */
+  void getSyncState(diagnostic_updater::DiagnosticStatusWrapper& stat)
+  {
+    Synchronizer::Statistics statistics;
+    {
+      std::lock_guard<std::mutex> scopedLock(sync_mutex_);
+      statistics = synchronizer_->getStatistics();
+    }
+    const double pairing_rate = statistics.getPairingRate(cameras_.size());
+    if (statistics.frames == 0)
+    {
+      stat.summary(diagnostic_msgs::DiagnosticStatus::WARN, "No frames received yet");
+    }
+    else if (pairing_rate < min_pairing_rate_)
+    {
+      stat.summaryf(diagnostic_msgs::DiagnosticStatus::WARN, "Only %.1f %% of the frames are paired",
+                    100.0 * pairing_rate);
+    }
+    else
+    {
+      stat.summary(diagnostic_msgs::DiagnosticStatus::OK, "Cameras synchronized");
+    }
+    stat.add("Cameras", cameras_.size());
+    stat.add("Frames", statistics.frames);
+    stat.add("Synchronized sets", statistics.sets);
+    stat.add("Dropped frames", statistics.dropped);
+    stat.addf("Pairing rate [%]", "%.1f", 100.0 * pairing_rate);
+    stat.addf("Last skew [ms]", "%.3f", statistics.last_skew_ms);
+    stat.addf("Mean skew [ms]", "%.3f", statistics.mean_skew_ms);
+    stat.addf("Max skew [ms]", "%.3f", statistics.max_skew_ms);
+  }
+
+  std::vector<std::unique_ptr<CameraStream>> cameras_;
+  double timeout_{ 1.0 };
+
+  std::shared_ptr<image_transport::ImageTransport> it_;
+  std::shared_ptr<dynamic_reconfigure::Server<any_spinnaker_camera_driver::SpinnakerConfig>> srv_;
+
+  std::mutex config_mutex_;  ///< Guards config_, configured_ and the connected flags of the cameras.
+  any_spinnaker_camera_driver::SpinnakerConfig config_;
+  bool configured_{ false };  ///< The dynamic_reconfigure server delivered the first configuration.
+
+  std::mutex sync_mutex_;
+  std::unique_ptr<Synchronizer> synchronizer_;
+  uint64_t next_set_{ 0 };          ///< Sequence number of the next completed set, guarded by sync_mutex_.
+  double min_pairing_rate_{ 0.9 };  ///< Pairing rate below which the diagnostics warn.
+
+  std::mutex publish_mutex_;
+  std::condition_variable publish_cv_;  ///< Notifies the grab threads that the previous set was published.
+  uint64_t next_publish_{ 0 };          ///< Sequence number of the next set to publish, guarded by publish_mutex_.
+
+  diagnostic_updater::Updater updater_;
+  ros::WallTimer diagnostics_timer_;
+};
+
+PLUGINLIB_EXPORT_CLASS(any_spinnaker_camera_driver::SpinnakerMultiCameraNodelet,
+                       nodelet::Nodelet)  // Needed for Nodelet declaration
+}  // namespace any_spinnaker_camera_driver
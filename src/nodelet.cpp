@@ -52,7 +52,23 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <nodelet/nodelet.h>
 
 #include "any_spinnaker_camera_driver/SpinnakerCamera.h"  // The actual standalone library for the Spinnakers
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+#include "any_spinnaker_camera_driver/compression_pool.h"
 #include "any_spinnaker_camera_driver/diagnostics.h"
+#include "any_spinnaker_camera_driver/file_watcher.h"
+#include "any_spinnaker_camera_driver/frame_decimator.h"
+#include "any_spinnaker_camera_driver/frame_recorder.h"
+#include "any_spinnaker_camera_driver/grab_recovery_policy.h"
+#include "any_spinnaker_camera_driver/image_pyramid.h"
+#include "any_spinnaker_camera_driver/raw_codec.h"
+#include "any_spinnaker_camera_driver/replay_source.h"
+#include "any_spinnaker_camera_driver/seqlock.h"
+#include "any_spinnaker_camera_driver/shared_frame_ring.h"
+#include "any_spinnaker_camera_driver/software_binning.h"
+#include "any_spinnaker_camera_driver/startup_orchestrator.h"
+#include "any_spinnaker_camera_driver/startup_profiler.h"
+#include "any_spinnaker_camera_driver/thread_config.h"
+#include <any_spinnaker_camera_driver/SharedFrameDescriptor.h>
 
 #include <image_transport/image_transport.h>          // ROS library that allows sending compressed images
 #include <camera_info_manager/camera_info_manager.h>  // ROS library that publishes CameraInfo topics
@@ -68,8 +84,17 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <dynamic_reconfigure/server.h>  // Needed for the dynamic_reconfigure gui service to run
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <fstream>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace any_spinnaker_camera_driver
 {
@@ -82,6 +107,19 @@ public:
 
   ~SpinnakerCameraNodelet()
   {
+    // Joined before taking the connect mutex, initialize() takes it as well.
+    if (initThread_)
+    {
+      initThread_->interrupt();
+      initThread_->join();
+    }
+
+    if (startup_orchestrator_)
+    {
+      // The other cameras of the process do not wait for this one anymore.
+      startup_orchestrator_->unregisterCamera(camera_name_);
+    }
+
     std::lock_guard<std::mutex> scopedLock(connect_mutex_);
 
     // Support that nodelets are shut down smoothly. Explicit tear down of ROS infrastructure
@@ -117,6 +155,25 @@ public:
   }
 
 private:
+  /// Configuration of the camera attached to every frame.
+  struct FrameMetadata
+  {
+    double gain{ 0.0 };
+    uint16_t wb_blue{ 0 };
+    uint16_t wb_red{ 0 };
+    double exposure_time{ -1.0 };  ///< Exposure time in microseconds, negative if controlled by the camera.
+
+    // Parameters for cameraInfo
+    uint32_t binning_x{ 1 };     ///< Camera Info pixel binning along the image x axis.
+    uint32_t binning_y{ 1 };     ///< Camera Info pixel binning along the image y axis.
+    uint32_t roi_x_offset{ 0 };  ///< Camera Info ROI x offset
+    uint32_t roi_y_offset{ 0 };  ///< Camera Info ROI y offset
+    uint32_t roi_height{ 0 };    ///< Camera Info ROI height
+    uint32_t roi_width{ 0 };     ///< Camera Info ROI width
+    bool do_rectify{ false };  ///< Whether or not to rectify as if part of an image.  Set to false if whole image, and
+                               /// true if in ROI mode.
+  };
+
  /*!
   * \brief Timer to periodically update the status of the sensor interface in ros diagnostics and in a dedicated topic
   *
@@ -162,6 +219,10 @@ private:
        interface_status_level = diagnostic_msgs::DiagnosticStatus::OK;
        interface_status_message = "OK - Camera grabbing images";
        break;
+     case PAUSED:
+       interface_status_level = diagnostic_msgs::DiagnosticStatus::OK;
+       interface_status_message = "OK - Camera acquisition paused, no subscribers";
+       break;
      default:
        interface_status_level = diagnostic_msgs::DiagnosticStatus::WARN;
        interface_status_message = "WARN - Unknown camera connection state";
@@ -181,45 +242,20 @@ private:
 
   void paramCallback(const any_spinnaker_camera_driver::SpinnakerConfig& config, uint32_t level)
   {
+    // Held while applying, so that the acquisition thread never applies an older configuration after this one.
+    std::lock_guard<std::mutex> configLock(config_mutex_);
     config_ = config;
 
     try
     {
       NODELET_DEBUG_ONCE("Dynamic reconfigure callback with level: %u", level);
-      spinnaker_.setNewConfiguration(config, level);
-
-      // Store needed parameters for the metadata message
-      gain_ = config.gain;
-      wb_blue_ = config.white_balance_blue_ratio;
-      wb_red_ = config.white_balance_red_ratio;
-
-      // No separate param in CameraInfo for binning/decimation
-      binning_x_ = config.image_format_x_binning * config.image_format_x_decimation;
-      binning_y_ = config.image_format_y_binning * config.image_format_y_decimation;
-
-      // Store CameraInfo RegionOfInterest information
-      // TODO(mhosmar): Not compliant with CameraInfo message: "A particular ROI always denotes the
-      //                same window of pixels on the camera sensor, regardless of binning settings."
-      //                These values are in the post binned frame.
-      if ((config.image_format_roi_width + config.image_format_roi_height) > 0 &&
-          (config.image_format_roi_width < spinnaker_.getWidthMax() ||
-           config.image_format_roi_height < spinnaker_.getHeightMax()))
-      {
-        roi_x_offset_ = config.image_format_x_offset;
-        roi_y_offset_ = config.image_format_y_offset;
-        roi_width_ = config.image_format_roi_width;
-        roi_height_ = config.image_format_roi_height;
-        do_rectify_ = true;  // Set to true if an ROI is used.
-      }
-      else
+      // There is no camera to configure when replaying recorded frames. With a deferred setup, devicePoll applies
+      // the configuration once after connecting.
+      if (!replay_source_ && (!deferCameraSetup() || camera_configured_))
       {
-        // Zeros mean the full resolution was captured.
-        roi_x_offset_ = 0;
-        roi_y_offset_ = 0;
-        roi_height_ = 0;
-        roi_width_ = 0;
-        do_rectify_ = false;  // Set to false if the whole image is captured.
+        spinnaker_.setNewConfiguration(config, level);
       }
+      updateConfigParameters(config);
     }
     catch (std::runtime_error& e)
     {
@@ -227,13 +263,50 @@ private:
     }
   }
 
+  /*!
+  * \brief Stores the parameters of a configuration needed for the published messages.
+  *
+  * \param config The configuration applied to the camera.
+  */
+  void updateConfigParameters(const any_spinnaker_camera_driver::SpinnakerConfig& config)
+  {
+    // Published as a whole, so that no frame is published with a partially updated configuration.
+    FrameMetadata metadata;
+    // Store needed parameters for the metadata message
+    metadata.gain = config.gain;
+    metadata.wb_blue = config.white_balance_blue_ratio;
+    metadata.wb_red = config.white_balance_red_ratio;
+    metadata.exposure_time = config.exposure_auto == "Off" ? config.exposure_time : -1.0;
+
+    // No separate param in CameraInfo for binning/decimation. Replaced by what was applied to every grabbed frame, which
+    // differs if the camera or the driver could not apply the configuration.
+    metadata.binning_x = config.image_format_x_binning * config.image_format_x_decimation;
+    metadata.binning_y = config.image_format_y_binning * config.image_format_y_decimation;
+
+    // Store CameraInfo RegionOfInterest information
+    // TODO(mhosmar): Not compliant with CameraInfo message: "A particular ROI always denotes the
+    //                same window of pixels on the camera sensor, regardless of binning settings."
+    //                These values are in the post binned frame.
+    if ((config.image_format_roi_width + config.image_format_roi_height) > 0 &&
+        (config.image_format_roi_width < spinnaker_.getWidthMax() ||
+         config.image_format_roi_height < spinnaker_.getHeightMax()))
+    {
+      metadata.roi_x_offset = config.image_format_x_offset;
+      metadata.roi_y_offset = config.image_format_y_offset;
+      metadata.roi_width = config.image_format_roi_width;
+      metadata.roi_height = config.image_format_roi_height;
+      metadata.do_rectify = true;  // Set to true if an ROI is used.
+    }
+    // Zeros and no rectification (the defaults) mean the full resolution was captured.
+    frame_metadata_.store(metadata);
+  }
+
   void diagCb()
   {
     if (!diagThread_)  // We need to connect
     {
       // Start the thread to loop through and publish messages
-      diagThread_.reset(
-          new boost::thread(boost::bind(&any_spinnaker_camera_driver::SpinnakerCameraNodelet::diagPoll, this)));
+      startDiagThread();
     }
     NODELET_DEBUG_STREAM("Connect diagCb callback! The number of diagnostics subscribers: " << diagnostics_pub_->getNumSubscribers());
     if (diagnostics_pub_->getNumSubscribers() == 0)
@@ -248,8 +321,7 @@ private:
     else if(!diagThread_)     // We need to connect
     {
       // Start the thread to loop through and publish messages
-      diagThread_.reset(
-          new boost::thread(boost::bind(&any_spinnaker_camera_driver::SpinnakerCameraNodelet::diagPoll, this)));
+      startDiagThread();
     }
     else
     {
@@ -269,8 +341,9 @@ private:
     if (!pubThread_)  // We need to connect
     {
       // Start the thread to loop through and publish messages
-      pubThread_.reset(new boost::thread(boost::bind(&any_spinnaker_camera_driver::SpinnakerCameraNodelet::devicePoll, this)));
+      startPollThread();
     }
+    updateOutputDemand();
 
     // todo(GZ): the node will get stuck if subscribing/unsubscribing to the image topic too frequently.
     /*
@@ -323,6 +396,98 @@ private:
      */
   }
 
+  /*!
+  * \brief Checks if anything consumes the images, without locking.
+  *
+  * Reports subscribers until onInit has advertised all topics.
+  * \return True if there is a subscriber on any of the image topics.
+  */
+  bool hasSubscribers() const
+  {
+    return has_subscribers_;
+  }
+
+  /*!
+  * \brief Caches the images the subscribed topics need and wakes up a paused acquisition if there are any.
+  *
+  * The connect mutex has to be locked. Called by connectCb and once onInit has advertised all topics.
+  */
+  void updateOutputDemand()
+  {
+    if (!pub_)
+    {
+      return;
+    }
+    bool full_rate = false;
+    const OutputDemand demand = readOutputDemand(&full_rate);
+    output_demand_.store(demand);
+    output_demand_changed_ = true;
+    full_rate_subscribers_ = full_rate;
+    {
+      std::lock_guard<std::mutex> lock(subscribers_mutex_);
+      const bool has_subscribers = demand.raw || demand.color || demand.mono;
+      if (has_subscribers && !has_subscribers_)
+      {
+        // The resume time is measured from the subscription.
+        subscription_time_ = std::chrono::steady_clock::now();
+      }
+      has_subscribers_ = has_subscribers;
+      subscribers_changed_ = true;
+    }
+    subscribers_cv_.notify_all();
+  }
+
+  /*!
+  * \brief Reads the images the subscribed topics need.
+  *
+  * The connect mutex has to be locked and the topics advertised.
+  * \param full_rate Set to true if a topic other than the decimated outputs has subscribers.
+  */
+  OutputDemand readOutputDemand(bool* full_rate)
+  {
+    OutputDemand demand;
+    demand.color = demosaicer_ && color_pub_.getNumSubscribers() > 0;
+    demand.mono = demosaicer_ && mono_pub_.getNumSubscribers() > 0;
+    demand.raw = it_pub_.getNumSubscribers() > 0 || pub_->getPublisher().getNumSubscribers() > 0 ||
+                 (shared_memory_ && shared_frame_pub_.getNumSubscribers() > 0) || half_pub_.getNumSubscribers() > 0 ||
+                 quarter_pub_.getNumSubscribers() > 0 ||
+                 (compression_pool_ && compressed_pub_.getNumSubscribers() > 0) ||
+                 raw_codec_pub_.getNumSubscribers() > 0;
+    *full_rate = demand.raw || demand.color || demand.mono;
+    for (const auto& output : decimated_outputs_)
+    {
+      demand.raw = demand.raw || output.publisher.getNumSubscribers() > 0;
+    }
+    return demand;
+  }
+
+  /*!
+  * \brief Reconfigures the camera if the subscribed topics are served by a more compact pixel format.
+  *
+  * Only has an effect with the "auto" image_format_color_coding. Called by the acquisition thread at most once a
+  * second, as every change of the format restarts the acquisition.
+  */
+  void renegotiatePixelFormat()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (!output_demand_changed_ || now - last_negotiation_ < std::chrono::seconds(1))
+    {
+      return;
+    }
+    output_demand_changed_ = false;
+    last_negotiation_ = now;
+    OutputDemand demand = output_demand_.load();
+    // The flight recorder keeps the frames as the camera sends them.
+    demand.raw = demand.raw || recorder_;
+    if (spinnaker_.setOutputDemand(demand))
+    {
+      NODELET_INFO("The subscribed topics are served by another pixel format, reconfiguring the camera.");
+      // Serialized with paramCallback, which applies the configuration on the dynamic_reconfigure thread.
+      std::lock_guard<std::mutex> configLock(config_mutex_);
+      spinnaker_.setNewConfiguration(config_, SpinnakerCamera::LEVEL_RECONFIGURE_STOP);
+    }
+  }
+
   /*!
   * \brief Serves as a psuedo constructor for nodelets.
   *
@@ -363,14 +528,69 @@ private:
     NODELET_DEBUG_ONCE("Camera serial path %s", camera_serial_path.c_str());
     // If serial has been provided directly as a param, ignore the path
     // to read in the serial from.
-    while (serial == 0 && !camera_serial_path.empty())
+    if (serial == 0 && !camera_serial_path.empty())
+    {
+      // The serial file appears when udev has set up the camera, wait for it without blocking the nodelet manager.
+      double camera_serial_timeout;
+      pnh.param<double>("camera_serial_timeout", camera_serial_timeout, 0.0);
+      initThread_.reset(new boost::thread(
+          boost::bind(&SpinnakerCameraNodelet::waitForSerial, this, camera_serial_path, camera_serial_timeout)));
+      return;
+    }
+
+    initialize(serial);
+  }
+
+  /*!
+  * \brief Waits until the serial file exists, then reads the serial from it and initializes the nodelet.
+  *
+  * Runs on initThread_.
+  * \param camera_serial_path The file to read the serial from.
+  * \param timeout Maximum time to wait in seconds, 0 to wait forever.
+  */
+  void waitForSerial(const std::string& camera_serial_path, double timeout)
+  {
+    const auto interrupted = [] { return boost::this_thread::interruption_requested() || !ros::ok(); };
+    const ros::WallTime deadline = ros::WallTime::now() + ros::WallDuration(timeout);
+    int serial = 0;
+    while (serial == 0)
     {
+      const double remaining = timeout > 0.0 ? (deadline - ros::WallTime::now()).toSec() : 0.0;
+      if (timeout > 0.0 && remaining <= 0.0)
+      {
+        state = State::ERROR;
+        NODELET_ERROR("Camera serial path %s did not become available within %.1f s.", camera_serial_path.c_str(),
+                      timeout);
+        return;
+      }
+      NODELET_WARN_ONCE("Waiting for camera serial path to become available");
+      if (!waitForFile(camera_serial_path, timeout > 0.0 ? remaining : 0.0, interrupted))
+      {
+        if (interrupted())
+        {
+          return;
+        }
+        continue;
+      }
       serial = readSerialAsHexFromFile(camera_serial_path);
-      if (serial == 0) {
-        NODELET_WARN_ONCE("Waiting for camera serial path to become available");
-        ros::Duration(1.0).sleep();  // Sleep for 1 second, wait for serial device path to become available
+      if (serial == 0)
+      {
+        // The file exists but has no content yet.
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
       }
     }
+    initialize(serial);
+  }
+
+  /*!
+  * \brief Sets up the driver for the camera with the given serial.
+  *
+  * \param serial The serial of the camera, 0 for the first camera found.
+  */
+  void initialize(int serial)
+  {
+    ros::NodeHandle& nh = getMTNodeHandle();
+    ros::NodeHandle& pnh = getMTPrivateNodeHandle();
 
     NODELET_DEBUG_ONCE("Using camera serial %d", serial);
 
@@ -395,11 +615,159 @@ private:
     pnh.param<bool>("auto_packet_size", auto_packet_size_, true);
     pnh.param<int>("packet_delay", packet_delay_, 4000);
 
+    // Apply the configuration once after connecting instead of on every dynamic_reconfigure callback during startup.
+    pnh.param<bool>("fast_start", fast_start_, false);
+    spinnaker_.setStartupProfiler(&startup_profiler_);
+
+    // Keep the configuration in a UserSet of the camera and load it with one command on reconnects, empty to disable.
+    std::string user_set;
+    pnh.param<std::string>("user_set", user_set, "");
+    spinnaker_.setUserSet(user_set);
+
+    // Unpack 12-bit packed pixel formats to 16 bit, or publish them packed with encodings like "mono12p".
+    bool unpack_12bit;
+    pnh.param<bool>("unpack_12bit", unpack_12bit, true);
+    spinnaker_.setUnpack12Bit(unpack_12bit);
+
+    // Threads decompressing the frames if the camera compresses them (compression_mode), see SpinnakerCamera.
+    int decompression_threads;
+    pnh.param<int>("decompression_threads", decompression_threads, 2);
+    spinnaker_.setDecompressionThreads(static_cast<unsigned int>(std::max(1, decompression_threads)));
+
+    // How the driver combines the pixels it bins because the camera model cannot, "sum" or "average".
+    std::string software_binning_mode;
+    pnh.param<std::string>("software_binning_mode", software_binning_mode, "average");
+    SoftwareBinning::Mode binning_mode;
+    if (!SoftwareBinning::parseMode(software_binning_mode, &binning_mode))
+    {
+      NODELET_WARN("Unknown software_binning_mode %s, using average.", software_binning_mode.c_str());
+      binning_mode = SoftwareBinning::Mode::AVERAGE;
+    }
+    spinnaker_.setSoftwareBinningMode(binning_mode);
+
+    // Scheduling of the acquisition and diagnostics threads, see thread_config.h.
+    acquisition_thread_config_ = readThreadConfig(pnh, "acquisition_thread");
+    diagnostics_thread_config_ = readThreadConfig(pnh, "diagnostics_thread");
+    bool lock_memory;
+    pnh.param<bool>("lock_memory", lock_memory, false);
+    if (lock_memory)
+    {
+      std::string error;
+      if (lockProcessMemory(&error))
+      {
+        NODELET_INFO("Locked the process memory.");
+      }
+      else
+      {
+        NODELET_WARN("Failed to lock the process memory, continuing without: %s", error.c_str());
+      }
+    }
+
+    // Recovery from failed grabs: retries, then re-arms, then re-initializations before a full reconnect.
+    GrabRecoveryPolicy::Config recovery_config;
+    int recovery_retries, recovery_rearms, recovery_reinits;
+    pnh.param<int>("recovery/retries", recovery_retries, 2);
+    pnh.param<int>("recovery/rearms", recovery_rearms, 1);
+    pnh.param<int>("recovery/reinits", recovery_reinits, 1);
+    recovery_config.retries = static_cast<unsigned int>(std::max(0, recovery_retries));
+    recovery_config.rearms = static_cast<unsigned int>(std::max(0, recovery_rearms));
+    recovery_config.reinits = static_cast<unsigned int>(std::max(0, recovery_reinits));
+    recovery_.setConfig(recovery_config);
+
+    // Let the driver allocate the stream buffers, so that stream restarts do not allocate.
+    bool user_buffers;
+    pnh.param<bool>("stream_buffers/user_allocated", user_buffers, false);
+    if (user_buffers)
+    {
+      int buffer_count;
+      pnh.param<int>("stream_buffers/count", buffer_count, 1);
+      bool huge_pages;
+      pnh.param<bool>("stream_buffers/huge_pages", huge_pages, false);
+      bool lock_buffers;
+      pnh.param<bool>("stream_buffers/lock", lock_buffers, false);
+      spinnaker_.setUserBuffers(static_cast<unsigned int>(std::max(1, buffer_count)), huge_pages, lock_buffers);
+    }
+
+    // Stop the acquisition while nobody subscribes, the camera stays connected and configured.
+    pnh.param<bool>("lazy_acquisition", lazy_acquisition_, false);
+
+    // Optional flight recorder, writing the raw frames into a memory-mapped segment file.
+    bool record_frames;
+    pnh.param<bool>("flight_recorder/enable", record_frames, false);
+    if (record_frames)
+    {
+      std::string recorder_path;
+      pnh.param<std::string>("flight_recorder/path", recorder_path, "/tmp/spinnaker_" + cinfo_name.str() + ".rec");
+      int recorder_size_mb;
+      pnh.param<int>("flight_recorder/size_mb", recorder_size_mb, 2048);
+      int recorder_index_capacity;
+      pnh.param<int>("flight_recorder/index_capacity", recorder_index_capacity, 65536);
+      double recorder_flush_period;
+      pnh.param<double>("flight_recorder/flush_period", recorder_flush_period, 0.5);
+      try
+      {
+        recorder_.reset(new FrameRecorder(recorder_path, static_cast<size_t>(recorder_size_mb) << 20,
+                                          static_cast<size_t>(recorder_index_capacity), recorder_flush_period));
+        NODELET_INFO("Recording raw frames to %s (%d MB).", recorder_path.c_str(), recorder_size_mb);
+      }
+      catch (const std::runtime_error& e)
+      {
+        NODELET_ERROR("Failed to start the flight recorder: %s", e.what());
+      }
+    }
+
+    // Optional shared memory frame ring for consumers in other processes, only descriptors are sent over ROS.
+    pnh.param<bool>("shared_memory/enable", shared_memory_, false);
+    if (shared_memory_)
+    {
+      pnh.param<std::string>("shared_memory/name", shared_ring_name_, "spinnaker_" + cinfo_name.str());
+      pnh.param<int>("shared_memory/slots", shared_ring_slots_, 8);
+      // 0 sizes the slots to the first frame.
+      pnh.param<int>("shared_memory/slot_size_mb", shared_ring_slot_size_mb_, 0);
+      ros::SubscriberStatusCallback shared_frame_cb = boost::bind(&SpinnakerCameraNodelet::connectCb, this);
+      shared_frame_pub_ = nh.advertise<any_spinnaker_camera_driver::SharedFrameDescriptor>("image_shm", 5,
+                                                                                          shared_frame_cb,
+                                                                                          shared_frame_cb);
+    }
+
     // Get the location of our camera config yaml
     std::string camera_info_url;
     pnh.param<std::string>("camera_info_url", camera_info_url, "");
     // Get the desired frame_id, set to 'camera' if not found
     pnh.param<std::string>("frame_id", frame_id_, "camera");
+
+    // Replay recorded frames instead of grabbing them from the camera
+    pnh.param<std::string>("replay/file", replay_file_, "");
+    if (!replay_file_.empty())
+    {
+      std::string replay_topic;
+      pnh.param<std::string>("replay/topic", replay_topic, "image_raw");
+      // 1.0 replays at the recorded timing, 2.0 twice as fast, 0.0 as fast as possible.
+      pnh.param<double>("replay/rate", replay_rate_, 1.0);
+      pnh.param<bool>("replay/loop", replay_loop_, false);
+      pnh.param<bool>("replay/use_recorded_stamps", replay_use_recorded_stamps_, false);
+      try
+      {
+        replay_source_ = ReplaySource::create(replay_file_, replay_topic);
+      }
+      catch (const std::runtime_error& e)
+      {
+        NODELET_ERROR("Failed to open the replay file: %s", e.what());
+        state = State::ERROR;
+        return;
+      }
+    }
+    // Bring up all cameras of the process concurrently, on at most max_parallel at a time (0 for no limit).
+    bool parallel_startup;
+    pnh.param<bool>("parallel_startup/enable", parallel_startup, false);
+    if (parallel_startup && !replay_source_)
+    {
+      int max_parallel;
+      pnh.param<int>("parallel_startup/max_parallel", max_parallel, 0);
+      startup_orchestrator_ = StartupOrchestrator::instance();
+      startup_orchestrator_->setMaxParallel(static_cast<unsigned int>(std::max(0, max_parallel)));
+      startup_orchestrator_->registerCamera(camera_name_);
+    }
     // Do not call the connectCb function until after we are done initializing.
     std::lock_guard<std::mutex> scopedLock(connect_mutex_);
 
@@ -411,7 +779,11 @@ private:
     // Set state to ERROR to catch the driver looping during initialization in case that no camera is connected
     state = State::ERROR;
 
-    srv_->setCallback(f);
+    {
+      // Without fast start this connects to and configures the camera.
+      ScopedStartupPhase phase(&startup_profiler_, "dynamic_reconfigure");
+      srv_->setCallback(f);
+    }
 
     // Reset state to NONE if camera is correctly initialized
     state = State::NONE;
@@ -424,18 +796,120 @@ private:
     // SubscriberStatusCallback: http://docs.ros.org/melodic/api/roscpp/html/classros_1_1NodeHandle.html#ae4711ef282892176ba145d02f8f45f8d
     // cb will be called every time a new subscriber is connected to.
     image_transport::SubscriberStatusCallback cb = boost::bind(&SpinnakerCameraNodelet::connectCb, this);
-    // Start devicePoll first to trigger image streaming. This is needed because:
-    // When we launch this camera driver together with other nodes which subscribe to image_color or image_color_rect topic, if the other nodes
-    // are loaded first, subscribing to the image_color or image_color_rect topic, cb will not be triggered when the camera driver is loaded.
-    // As a result, we will not get image_color or image_color_rect streaming even when explicitly subscribing to these topics additionally (fishy).
-    // One solution is to unsubscribe to these topics from these nodes and cb will be triggered so that the camera will start image streaming.
-    // Another solution will be to explicit start the devicePoll thread to make the camera stream when launching the driver, which is what we do below.
-    if (!pubThread_)
+
+    // Additional image_raw/every_<n> topics publishing every n-th frame, e.g. [15, 30].
+    std::vector<int> decimation_factors;
+    pnh.param<std::vector<int>>("decimated_outputs", decimation_factors, std::vector<int>());
+    for (const int factor : decimation_factors)
     {
-      // Start the thread to loop through and publish messages
-      pubThread_.reset(
-          new boost::thread(boost::bind(&any_spinnaker_camera_driver::SpinnakerCameraNodelet::devicePoll, this)));
+      if (factor < 2)
+      {
+        NODELET_WARN("Ignoring decimated output with factor %d, it has to be at least 2.", factor);
+        continue;
+      }
+      const std::string topic = "image_raw/every_" + std::to_string(factor);
+      decimated_outputs_.emplace_back(static_cast<unsigned int>(factor), it_->advertise(topic, 5, cb, cb));
+      NODELET_INFO("Publishing every %d. frame on %s.", factor, topic.c_str());
+    }
+
+    // Publish image_color and image_mono converted by the driver, replacing an image_proc/debayer nodelet.
+    bool demosaic;
+    pnh.param<bool>("demosaic/enable", demosaic, false);
+    // With the "auto" pixel format the camera sends Bayer frames also for color topics, they are converted here.
+    std::string color_coding;
+    pnh.param<std::string>("image_format_color_coding", color_coding, "");
+    if (demosaic || color_coding == AUTO_PIXEL_FORMAT)
+    {
+      std::string method_name;
+      pnh.param<std::string>("demosaic/method", method_name, "bilinear");
+      int demosaic_threads;
+      pnh.param<int>("demosaic/threads", demosaic_threads, 2);
+      BayerDemosaicer::Method method;
+      if (!BayerDemosaicer::parseMethod(method_name, &method))
+      {
+        NODELET_WARN("Unknown demosaicing method '%s', using bilinear.", method_name.c_str());
+        method = BayerDemosaicer::Method::BILINEAR;
+      }
+      demosaicer_.reset(new BayerDemosaicer(method, static_cast<unsigned int>(std::max(1, demosaic_threads))));
+      color_pub_ = it_->advertise("image_color", 5, cb, cb);
+      mono_pub_ = it_->advertise("image_mono", 5, cb, cb);
+      NODELET_INFO("Demosaicing %s on %u threads with %s kernels.", BayerDemosaicer::toString(method).c_str(),
+                   demosaicer_->getThreads(), BayerDemosaicer::getKernelName().c_str());
+    }
+
+    // Half and quarter resolution images with their CameraInfo, in the namespaces half and quarter.
+    bool pyramid_half;
+    bool pyramid_quarter;
+    pnh.param<bool>("pyramid/half", pyramid_half, false);
+    pnh.param<bool>("pyramid/quarter", pyramid_quarter, false);
+    if (pyramid_half || pyramid_quarter)
+    {
+      pyramid_.reset(new ImagePyramid());
+      if (pyramid_half)
+      {
+        half_pub_ = it_->advertiseCamera("half/image_raw", 5, cb, cb);
+      }
+      if (pyramid_quarter)
+      {
+        quarter_pub_ = it_->advertiseCamera("quarter/image_raw", 5, cb, cb);
+      }
+    }
+
+    // Compress image_raw once on a worker pool for all subscribers of image_raw/compressed, instead of once per
+    // subscriber on this thread by the compressed plugin of image_transport.
+    bool compression;
+    pnh.param<bool>("compression/enable", compression, false);
+    if (compression)
+    {
+      CompressionPool::Config compression_config;
+      int threads;
+      int queue_size;
+      pnh.param<std::string>("compression/format", compression_config.format, "jpeg");
+      pnh.param<int>("compression/jpeg_quality", compression_config.jpeg_quality, 80);
+      pnh.param<int>("compression/png_level", compression_config.png_level, 3);
+      pnh.param<int>("compression/threads", threads, 2);
+      pnh.param<int>("compression/queue_size", queue_size, 2);
+      compression_config.threads = static_cast<unsigned int>(std::max(1, threads));
+      compression_config.queue_size = static_cast<size_t>(std::max(1, queue_size));
+      if (compression_config.format != "jpeg" && compression_config.format != "png")
+      {
+        NODELET_WARN("Unknown compression format '%s', using jpeg.", compression_config.format.c_str());
+        compression_config.format = "jpeg";
+      }
+
+      // Keep the plugin from advertising the same topic.
+      nh.setParam(nh.resolveName("image_raw") + "/disable_pub_plugins",
+                  std::vector<std::string>{ "image_transport/compressed" });
+      ros::SubscriberStatusCallback compressed_cb = boost::bind(&SpinnakerCameraNodelet::connectCb, this);
+      compressed_pub_ =
+          nh.advertise<sensor_msgs::CompressedImage>("image_raw/compressed", 5, compressed_cb, compressed_cb);
+      compression_pool_.reset(new CompressionPool(
+          compression_config, [this](const sensor_msgs::CompressedImageConstPtr& compressed) {
+            compressed_pub_.publish(compressed);
+          }));
+      NODELET_INFO("Compressing image_raw to %s on %u threads.", compression_config.format.c_str(),
+                   compression_config.threads);
+    }
+
+    // Lossless codec for raw Bayer and mono frames, published on image_raw/rawcodec and/or used by the flight recorder.
+    bool raw_codec_publish;
+    int raw_codec_threads;
+    pnh.param<bool>("raw_codec/publish", raw_codec_publish, false);
+    pnh.param<bool>("raw_codec/record", raw_codec_record_, false);
+    pnh.param<int>("raw_codec/threads", raw_codec_threads, 2);
+    raw_codec_record_ = raw_codec_record_ && recorder_;
+    if (raw_codec_publish || raw_codec_record_)
+    {
+      raw_codec_.reset(new RawCodec(static_cast<unsigned int>(std::max(1, raw_codec_threads))));
+      if (raw_codec_publish)
+      {
+        ros::SubscriberStatusCallback raw_codec_cb = boost::bind(&SpinnakerCameraNodelet::connectCb, this);
+        raw_codec_pub_ =
+            nh.advertise<sensor_msgs::CompressedImage>("image_raw/rawcodec", 5, raw_codec_cb, raw_codec_cb);
+      }
+      NODELET_INFO("Encoding raw frames losslessly on %u threads.", raw_codec_->getThreads());
     }
+
     it_pub_ = it_->advertiseCamera("image_raw", 5, cb, cb);
 
     // Set up diagnostics
@@ -465,6 +939,8 @@ private:
                           &min_freq_, &max_freq_, freq_tolerance, window_size),
             diagnostic_updater::TimeStampStatusParam(min_acceptable,
                                                      max_acceptable)));
+    // All image topics are advertised, from now on connectCb keeps the demand up to date.
+    updateOutputDemand();
 
     // Set up diagnostics aggregator publisher and diagnostics manager
     ros::SubscriberStatusCallback diag_cb =
@@ -484,6 +960,45 @@ private:
     // Power consumption is 3 W maximum.
     diag_man->addDiagnostic("PowerSupplyCurrent", false, std::make_pair(0.4f, 0.6f), 0.3f, 1.0f);
     diag_man->addDiagnostic<int>("DeviceUptime");
+
+    // Start the poll thread only now that the publishers, codecs and diagnostics it uses are set up, replayPoll
+    // publishes right away. Starting devicePoll here also triggers image streaming. This is needed because:
+    // When we launch this camera driver together with other nodes which subscribe to image_color or image_color_rect topic, if the other nodes
+    // are loaded first, subscribing to the image_color or image_color_rect topic, cb will not be triggered when the camera driver is loaded.
+    // As a result, we will not get image_color or image_color_rect streaming even when explicitly subscribing to these topics additionally (fishy).
+    // One solution is to unsubscribe to these topics from these nodes and cb will be triggered so that the camera will start image streaming.
+    // Another solution will be to explicit start the devicePoll thread to make the camera stream when launching the driver, which is what we do below.
+    if (!pubThread_)
+    {
+      // Start the thread to loop through and publish messages
+      startPollThread();
+    }
+    if (replay_source_)
+    {
+      // Nothing below applies without a camera.
+      return;
+    }
+    // With a deferred setup, devicePoll sets up the camera once it is connected.
+    if (!deferCameraSetup())
+    {
+      std::call_once(camera_setup_flag_, &SpinnakerCameraNodelet::setupConnectedCamera, this);
+    }
+  }
+
+  /*!
+  * \brief Whether the configuration and setupConnectedCamera() wait for devicePoll to connect, instead of connecting
+  * from onInit.
+  */
+  bool deferCameraSetup() const
+  {
+    return fast_start_ || startup_orchestrator_;
+  }
+
+  /*!
+  * \brief Sets up the diagnostics and GigE parameters that need a connected camera.
+  */
+  void setupConnectedCamera()
+  {
     // Get DeviceType
     try {
       Spinnaker::GenApi::INodeMap& genTLNodeMap = spinnaker_.getTLDeviceNodeMap();
@@ -537,11 +1052,12 @@ private:
 
   void diagPoll()
   {
+    prefaultStack(diagnostics_thread_config_.prefault_stack_size);
     while (!boost::this_thread::interruption_requested())  // Block until we need
                                                            // to stop this// thread.
     {
       // Add this catch block so that the driver will not die when we unplug the camera and subscribe to the /diagnostics.
-      if (state>=CONNECTED) {
+      if (state>=CONNECTED && !replay_source_) {
         try {
           diag_man->processDiagnostics(&spinnaker_);
         } catch (...) {
@@ -561,6 +1077,7 @@ private:
   void devicePoll()
   {
     ROS_DEBUG_ONCE("Device poll starting...");
+    prefaultStack(acquisition_thread_config_.prefault_stack_size);
     state = DISCONNECTED;
     previous_state = NONE;
 
@@ -617,14 +1134,51 @@ private:
           // Try connecting to the camera
           try
           {
-            NODELET_DEBUG("Connecting to camera.");
-
-            spinnaker_.connect();
-
-            NODELET_DEBUG("Connected to camera.");
-
-            // Set last configuration, forcing the reconfigure level to stop
-            spinnaker_.setNewConfiguration(config_, SpinnakerCamera::LEVEL_RECONFIGURE_STOP);
+            const auto bring_up = [this]() {
+              NODELET_DEBUG("Connecting to camera.");
+
+              spinnaker_.connect();
+
+              NODELET_DEBUG("Connected to camera.");
+
+              // With a deferred setup, the dynamic_reconfigure callbacks only stored the configuration until now.
+              {
+                std::lock_guard<std::mutex> configLock(config_mutex_);
+                camera_configured_ = true;
+                ScopedStartupPhase phase(&startup_profiler_, "configure");
+                // With fast start, write the configuration once, before the acquisition is started for the first
+                // time. Otherwise set last configuration, from the UserSet if it is unchanged since it was stored.
+                spinnaker_.restoreConfiguration(config_, !fast_start_);
+                if (deferCameraSetup())
+                {
+                  updateConfigParameters(config_);
+                }
+              }
+              if (deferCameraSetup())
+              {
+                // Waits for onInit to finish setting up the diagnostics.
+                std::lock_guard<std::mutex> scopedLock(connect_mutex_);
+                std::call_once(camera_setup_flag_, &SpinnakerCameraNodelet::setupConnectedCamera, this);
+              }
+            };
+            if (startup_orchestrator_)
+            {
+              // An absent camera waits for its arrival without a slot, so that it does not hold back the others.
+              if (!spinnaker_.waitForCamera())
+              {
+                throw std::runtime_error("[SpinnakerCameraNodelet::devicePoll] Camera " + camera_name_ +
+                                         " was not found.");
+              }
+              // Waits for a free bring-up slot, the other cameras of the process are brought up concurrently.
+              if (startup_orchestrator_->run(camera_name_, bring_up))
+              {
+                NODELET_INFO("All cameras of the process are up: %s", startup_orchestrator_->toString().c_str());
+              }
+            }
+            else
+            {
+              bring_up();
+            }
 
             // Set the timeout for grabbing images.
             try
@@ -660,11 +1214,20 @@ private:
 
           break;
         case CONNECTED:
+          if (lazy_acquisition_ && !hasSubscribers())
+          {
+            NODELET_INFO("No subscribers, not starting the acquisition.");
+            state = PAUSED;
+            break;
+          }
           // Try starting the camera
           try
           {
             NODELET_DEBUG("Starting camera.");
-            spinnaker_.start();
+            {
+              ScopedStartupPhase phase(&startup_profiler_, "begin_acquisition");
+              spinnaker_.start();
+            }
             NODELET_DEBUG("Started camera.");
             NODELET_DEBUG("Attention: if nothing subscribes to the camera topic, the camera_info is not published "
                           "on the correspondent topic.");
@@ -679,116 +1242,797 @@ private:
 
           break;
         case STARTED:
+          if (lazy_acquisition_ && !hasSubscribers())
+          {
+            try
+            {
+              NODELET_INFO("No subscribers left, pausing the acquisition.");
+              spinnaker_.stop();
+              state = PAUSED;
+            }
+            catch (std::runtime_error& e)
+            {
+              NODELET_ERROR("Failed to pause with error: %s", e.what());
+              state = ERROR;
+            }
+            break;
+          }
           // This try catch block cannot catch the issue if wfov_image->image is empty.
           try
           {
             wfov_camera_msgs::WFOVImagePtr wfov_image(new wfov_camera_msgs::WFOVImage);
+            renegotiatePixelFormat();
             // Get the image from the camera library
             NODELET_DEBUG_ONCE("Starting a new grab from camera with serial {%d}.", spinnaker_.getSerial());
             // It still works even if wfov_image->image has no data.
-            const auto grab_success = spinnaker_.grabImage(&wfov_image->image, frame_id_);
+            FrameInfo frame_info;
+            // Without full rate subscribers, the frames the decimated outputs skip are not even copied.
+            const bool decimated_only = !full_rate_subscribers_ && !recorder_;
+            FrameFilter filter;
+            if (!decimated_outputs_.empty())
+            {
+              filter = [this, decimated_only](const FrameInfo& info) {
+                return selectDecimatedFrame(info.hardware_stamp_ns) || !decimated_only;
+              };
+            }
+            const auto grab_success = spinnaker_.grabImage(&wfov_image->image, frame_id_, &frame_info, filter);
             if (!grab_success)
             {
               NODELET_WARN("Failed to grab an image.");
-              // Try to reconnect the camera. We will still publish the image without data.
-              state = ERROR;
+              recoverFromGrabFailure();
+              break;
+            }
+            std::chrono::steady_clock::time_point arrival_time;
+            if (spinnaker_.takeArrivalTime(&arrival_time))
+            {
+              last_arrival_to_frame_ms_ =
+                  std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - arrival_time).count();
+              NODELET_INFO("First frame %.1f ms after the camera arrived.", last_arrival_to_frame_ms_.load());
+            }
+            if (recovery_.onSuccess())
+            {
+              const GrabRecoveryPolicy::Statistics recovery = recovery_.getStatistics();
+              NODELET_INFO("Recovered from grab failures after %.1f ms, recovery tier reached: %s.",
+                           recovery.last_downtime_ms, GrabRecoveryPolicy::toString(recovery.last_tier).c_str());
+            }
+            if (frame_info.skipped)
+            {
+              // Counted for the frequency diagnostics of the acquisition.
+              pub_->tick(ros::Time::now());
               break;
             }
-            // Set other values
-            wfov_image->header.frame_id = frame_id_;
-
-            wfov_image->gain = gain_;
-            wfov_image->white_balance_blue = wb_blue_;
-            wfov_image->white_balance_red = wb_red_;
-
             // wfov_image->temperature = spinnaker_.getCameraTemperature();
-            ros::Time time = ros::Time::now();
-            try {
-              NODELET_DEBUG_THROTTLE(1, "The measured image frame rate is: %f (throttled: 1s)", 1 / (time - prevImgRosTime_).toSec());
-            } catch (std::runtime_error& e){
-              NODELET_ERROR("Cannot calculate the image frame rate! %s", e.what());
+            // One consistent snapshot of the configuration per frame, with the binning actually applied to it.
+            FrameMetadata metadata = frame_metadata_.load();
+            metadata.binning_x = frame_info.binning_x;
+            metadata.binning_y = frame_info.binning_y;
+            // The frame was grabbed, failures from here on are on the host and say nothing about the camera.
+            try
+            {
+              publishImage(wfov_image, ros::Time::now(), metadata);
+              if (!startup_finished_)
+              {
+                startup_profiler_.finish("first_frame");
+                startup_finished_ = true;
+                NODELET_INFO("First frame %.1f ms after startup: %s", startup_profiler_.getTotalMs(),
+                             startup_profiler_.toString().c_str());
+              }
+              if (resume_pending_)
+              {
+                const double resume_time_ms =
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - resume_start_)
+                        .count();
+                last_resume_time_ms_ = resume_time_ms;
+                max_resume_time_ms_ = std::max(max_resume_time_ms_.load(), resume_time_ms);
+                resume_pending_ = false;
+                NODELET_INFO("Resumed the acquisition, first frame after %.1f ms.", resume_time_ms);
+              }
+
+              // Recording only copies into the mapped file, the disk is written by the recorder's own thread.
+              if (recorder_)
+              {
+                recordFrame(wfov_image->image, frame_info, metadata);
+              }
             }
-            prevImgRosTime_ = time;
-            wfov_image->header.stamp = time;
-            wfov_image->image.header.stamp = time;
-
-            // Set the CameraInfo message
-            ci_.reset(new sensor_msgs::CameraInfo(cinfo_->getCameraInfo()));
-            ci_->header.stamp = wfov_image->image.header.stamp;
-            ci_->header.frame_id = wfov_image->header.frame_id;
-            // The height, width, distortion model, and parameters are all filled in by camera info manager.
-            ci_->binning_x = binning_x_;
-            ci_->binning_y = binning_y_;
-            ci_->roi.x_offset = roi_x_offset_;
-            ci_->roi.y_offset = roi_y_offset_;
-            ci_->roi.height = roi_height_;
-            ci_->roi.width = roi_width_;
-            ci_->roi.do_rectify = do_rectify_;
-
-            wfov_image->info = *ci_;
-
-            // Publish the full message
-            pub_->publish(wfov_image);
-
-            // Publish the message using standard image transport
-            if (it_pub_.getNumSubscribers() > 0)
+            catch (const std::runtime_error& e)
             {
-              sensor_msgs::ImagePtr image(new sensor_msgs::Image(wfov_image->image));
-              it_pub_.publish(image, ci_);
+              publish_failures_++;
+              NODELET_ERROR_THROTTLE(1, "Failed to publish a frame: %s (throttled: 1s)", e.what());
             }
           }
           catch (CameraTimeoutException& e)
           {
             NODELET_WARN("%s", e.what());
-            state = ERROR;
+            recoverFromGrabFailure();
           }
 
           catch (std::runtime_error& e)
           {
             NODELET_ERROR("%s", e.what());
-            state = ERROR;
+            recoverFromGrabFailure();
           }
 
           break;
+        case PAUSED:
+        {
+          // The camera is connected and configured, only the acquisition is stopped.
+          {
+            // Times out only to check for the interruption of the thread.
+            std::unique_lock<std::mutex> lock(subscribers_mutex_);
+            subscribers_cv_.wait_for(lock, std::chrono::milliseconds(100),
+                                     [this] { return subscribers_changed_.load(); });
+            subscribers_changed_ = false;
+            if (!has_subscribers_)
+            {
+              break;
+            }
+            resume_start_ = subscription_time_;
+          }
+          try
+          {
+            spinnaker_.start();
+            resume_pending_ = true;
+            resumes_++;
+            state = STARTED;
+          }
+          catch (std::runtime_error& e)
+          {
+            NODELET_ERROR("Failed to resume with error: %s", e.what());
+            state = ERROR;
+          }
+          break;
+        }
         default:
           state = State::ERROR;
           NODELET_ERROR("Unknown camera state %d!", state.load());
           break;
       }
 
-      // Update diagnostics
-      updater_.update();
+      // Update diagnostics, the publish frequency is not expected to be met while paused.
+      if (state != PAUSED)
+      {
+        updater_.update();
+      }
     }
 
     ROS_DEBUG_ONCE("Device poll finished.");
     NODELET_DEBUG_ONCE("Leaving thread.");
   }
 
-  void gainWBCallback(const image_exposure_msgs::ExposureSequence& msg)
+  /*!
+   * \brief Copies a grabbed frame and the configuration in effect into the flight recorder.
+   *
+   * \param image The grabbed image.
+   * \param frame_info Camera time stamp and frame counter of the image.
+   * \param frame_metadata The configuration the image was published with.
+   */
+  void recordFrame(const sensor_msgs::Image& image, const FrameInfo& frame_info, const FrameMetadata& frame_metadata)
   {
-    try
+    FrameRecordMetadata metadata;
+    metadata.stamp_ns = image.header.stamp.toNSec();
+    metadata.hardware_stamp_ns = frame_info.hardware_stamp_ns;
+    metadata.frame_id = frame_info.frame_id;
+    metadata.width = image.width;
+    metadata.height = image.height;
+    metadata.step = image.step;
+    std::strncpy(metadata.encoding, image.encoding.c_str(), sizeof(metadata.encoding) - 1);
+    metadata.gain = frame_metadata.gain;
+    metadata.exposure_time = frame_metadata.exposure_time;
+    metadata.white_balance_blue = frame_metadata.wb_blue;
+    metadata.white_balance_red = frame_metadata.wb_red;
+    metadata.binning_x = frame_metadata.binning_x;
+    metadata.binning_y = frame_metadata.binning_y;
+    metadata.roi_x_offset = frame_metadata.roi_x_offset;
+    metadata.roi_y_offset = frame_metadata.roi_y_offset;
+    const uint8_t* data = image.data.data();
+    size_t size = image.data.size();
+    // Frames with encodings the codec does not support are recorded raw.
+    sensor_msgs::CompressedImageConstPtr encoded;
+    if (raw_codec_record_)
     {
-      NODELET_DEBUG_ONCE("Gain callback:  Setting gain to %f and white balances to %u, %u", msg.gain,
-                         msg.white_balance_blue, msg.white_balance_red);
-      gain_ = msg.gain;
-
-      spinnaker_.setGain(static_cast<float>(gain_));
-      wb_blue_ = msg.white_balance_blue;
-      wb_red_ = msg.white_balance_red;
-
-      // TODO(mhosmar):
-      // spinnaker_.setBRWhiteBalance(false, wb_blue_, wb_red_);
+      encoded = raw_encoded_ ? raw_encoded_ : encodeRaw(image);
     }
-    catch (std::runtime_error& e)
+    if (encoded)
     {
-      NODELET_ERROR("gainWBCallback failed with error: %s", e.what());
+      data = encoded->data.data();
+      size = encoded->data.size();
+      metadata.flags |= FRAME_RECORD_FLAG_RAW_CODEC;
+    }
+    if (!recorder_->record(metadata, data, size))
+    {
+      NODELET_WARN_THROTTLE(10, "Frame of %zu bytes does not fit into the flight recorder. (throttled: 10s)", size);
     }
   }
 
   /*!
-   * \brief Function that calculates the interface diagnostic status.
-   *
-   * This function reads the driver internal `state` variable and determines the interface status based on it.
+  * \brief Rebuilds the cached CameraInfo if the calibration, the ROI or the binning changed.
+  *
+  * CameraInfoManager has no notification for calibrations set through set_camera_info and copies the calibration under
+  * its lock, so it is only compared once a second.
+  * \param metadata Snapshot of the configuration for the image to publish.
+  */
+  void updateCameraInfo(const FrameMetadata& metadata)
+  {
+    bool changed = !camera_info_;
+    const auto now = std::chrono::steady_clock::now();
+    if (changed || now - last_calibration_check_ >= std::chrono::seconds(1))
+    {
+      last_calibration_check_ = now;
+      sensor_msgs::CameraInfo calibration = cinfo_->getCameraInfo();
+      if (changed || !isSameCalibration(calibration, calibration_))
+      {
+        calibration_ = std::move(calibration);
+        changed = true;
+      }
+    }
+    changed = changed || metadata.binning_x != camera_info_metadata_.binning_x ||
+              metadata.binning_y != camera_info_metadata_.binning_y ||
+              metadata.roi_x_offset != camera_info_metadata_.roi_x_offset ||
+              metadata.roi_y_offset != camera_info_metadata_.roi_y_offset ||
+              metadata.roi_height != camera_info_metadata_.roi_height ||
+              metadata.roi_width != camera_info_metadata_.roi_width ||
+              metadata.do_rectify != camera_info_metadata_.do_rectify;
+    if (!changed)
+    {
+      return;
+    }
+
+    // The height, width, distortion model, and parameters are all filled in by camera info manager.
+    sensor_msgs::CameraInfoPtr camera_info(new sensor_msgs::CameraInfo(calibration_));
+    camera_info->header = std_msgs::Header();
+    camera_info->binning_x = metadata.binning_x;
+    camera_info->binning_y = metadata.binning_y;
+    camera_info->roi.x_offset = metadata.roi_x_offset;
+    camera_info->roi.y_offset = metadata.roi_y_offset;
+    camera_info->roi.height = metadata.roi_height;
+    camera_info->roi.width = metadata.roi_width;
+    camera_info->roi.do_rectify = metadata.do_rectify;
+    camera_info_ = camera_info;
+    camera_info_metadata_ = metadata;
+  }
+
+  /*!
+  * \brief Compares the parts of two CameraInfo messages that set_camera_info can change.
+  */
+  static bool isSameCalibration(const sensor_msgs::CameraInfo& a, const sensor_msgs::CameraInfo& b)
+  {
+    return a.height == b.height && a.width == b.width && a.distortion_model == b.distortion_model && a.D == b.D &&
+           a.K == b.K && a.R == b.R && a.P == b.P && a.binning_x == b.binning_x && a.binning_y == b.binning_y &&
+           a.roi.x_offset == b.roi.x_offset && a.roi.y_offset == b.roi.y_offset && a.roi.height == b.roi.height &&
+           a.roi.width == b.roi.width && a.roi.do_rectify == b.roi.do_rectify;
+  }
+
+  /*!
+  * \brief Stamps an image, attaches the CameraInfo and publishes it on all image topics.
+  *
+  * Shared by the live acquisition and the replay, so that both exercise the same publish path.
+  * \param wfov_image The message to publish, its image field has to be filled already.
+  * \param stamp The time stamp to publish the image with.
+  * \param metadata Snapshot of the configuration for the image.
+  */
+  void publishImage(const wfov_camera_msgs::WFOVImagePtr& wfov_image, const ros::Time& stamp,
+                    const FrameMetadata& metadata)
+  {
+    raw_encoded_.reset();
+
+    // Set other values
+    wfov_image->header.frame_id = frame_id_;
+    wfov_image->image.header.frame_id = frame_id_;
+
+    wfov_image->gain = metadata.gain;
+    wfov_image->white_balance_blue = metadata.wb_blue;
+    wfov_image->white_balance_red = metadata.wb_red;
+
+    try {
+      NODELET_DEBUG_THROTTLE(1, "The measured image frame rate is: %f (throttled: 1s)", 1 / (stamp - prevImgRosTime_).toSec());
+    } catch (std::runtime_error& e){
+      NODELET_ERROR("Cannot calculate the image frame rate! %s", e.what());
+    }
+    prevImgRosTime_ = stamp;
+    wfov_image->header.stamp = stamp;
+    wfov_image->image.header.stamp = stamp;
+
+    // Set the CameraInfo message. The WFOVImage owns the only per frame copy, image_raw shares it through an alias.
+    updateCameraInfo(metadata);
+    wfov_image->info = *camera_info_;
+    wfov_image->info.header.stamp = wfov_image->image.header.stamp;
+    wfov_image->info.header.frame_id = wfov_image->header.frame_id;
+    ci_ = sensor_msgs::CameraInfoConstPtr(wfov_image, &wfov_image->info);
+
+    // Publish the full message
+    pub_->publish(wfov_image);
+
+    // Publish the message using standard image transport
+    sensor_msgs::ImagePtr image;
+    if (it_pub_.getNumSubscribers() > 0)
+    {
+      image.reset(new sensor_msgs::Image(wfov_image->image));
+      it_pub_.publish(image, ci_);
+    }
+
+    // Selected frames share the image_raw message.
+    for (auto& output : decimated_outputs_)
+    {
+      if (!output.selected || output.publisher.getNumSubscribers() == 0)
+      {
+        continue;
+      }
+      if (!image)
+      {
+        image.reset(new sensor_msgs::Image(wfov_image->image));
+      }
+      output.publisher.publish(image);
+    }
+
+    if (demosaicer_)
+    {
+      publishDemosaiced(wfov_image->image, image);
+    }
+
+    if (pyramid_)
+    {
+      publishPyramid(wfov_image->image);
+    }
+
+    if (compression_pool_ && compressed_pub_.getNumSubscribers() > 0)
+    {
+      // The published message is not modified anymore, the workers share its image instead of a copy.
+      compression_pool_->submit(sensor_msgs::ImageConstPtr(wfov_image, &wfov_image->image));
+    }
+
+    if (raw_codec_pub_.getNumSubscribers() > 0)
+    {
+      if (const sensor_msgs::CompressedImageConstPtr encoded = encodeRaw(wfov_image->image))
+      {
+        raw_codec_pub_.publish(encoded);
+      }
+    }
+
+    if (shared_memory_ && shared_frame_pub_.getNumSubscribers() > 0)
+    {
+      publishSharedFrame(wfov_image->image);
+    }
+  }
+
+  /*!
+  * \brief Encodes an image with the raw codec, the result is kept for the flight recorder until the next frame.
+  *
+  * \param image The image to encode, stamped already.
+  * \return The encoded image with the format "<encoding>; rawcodec", null if the codec does not support the encoding.
+  */
+  sensor_msgs::CompressedImageConstPtr encodeRaw(const sensor_msgs::Image& image)
+  {
+    if (!RawCodec::isSupported(image.encoding))
+    {
+      NODELET_WARN_THROTTLE(10, "The raw codec does not support the encoding %s. (throttled: 10s)",
+                            image.encoding.c_str());
+      return nullptr;
+    }
+    sensor_msgs::CompressedImagePtr encoded(new sensor_msgs::CompressedImage);
+    encoded->header = image.header;
+    encoded->format = image.encoding + "; rawcodec";
+    const auto start = std::chrono::steady_clock::now();
+    raw_codec_->encode(image.data.data(), image.width, image.height, image.step, image.encoding, &encoded->data);
+    const double encoding_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const double raw_size = static_cast<double>(image.width) * image.height * (image.encoding.back() == '6' ? 2 : 1);
+    last_raw_codec_ms_ = encoding_ms;
+    raw_codec_ratio_ = raw_size / static_cast<double>(encoded->data.size());
+    raw_codec_throughput_ = encoding_ms > 0.0 ? raw_size / encoding_ms * 1e-3 : 0.0;
+    raw_encoded_ = encoded;
+    return raw_encoded_;
+  }
+
+  /*!
+  * \brief Publishes image_color and image_mono converted from the image, like image_proc/debayer.
+  *
+  * Bayer images are demosaiced directly from the acquired frame. Mono images are published unchanged on both topics,
+  * color images only on image_color.
+  * \param image The image to convert, stamped already.
+  * \param raw The image_raw message if it was created already, shared by the topics of unconverted images.
+  */
+  void publishDemosaiced(const sensor_msgs::Image& image, sensor_msgs::ImagePtr raw)
+  {
+    const bool publish_color = color_pub_.getNumSubscribers() > 0;
+    const bool publish_mono = mono_pub_.getNumSubscribers() > 0;
+    if (!publish_color && !publish_mono)
+    {
+      return;
+    }
+
+    BayerDemosaicer::Pattern pattern;
+    unsigned int bit_depth;
+    if (!BayerDemosaicer::parseEncoding(image.encoding, &pattern, &bit_depth))
+    {
+      if (!raw)
+      {
+        raw.reset(new sensor_msgs::Image(image));
+      }
+      // Packed 12-bit frames passed through are neither.
+      if (publish_color && (sensor_msgs::image_encodings::isColor(image.encoding) ||
+                            sensor_msgs::image_encodings::isMono(image.encoding)))
+      {
+        color_pub_.publish(raw);
+      }
+      if (publish_mono && sensor_msgs::image_encodings::isMono(image.encoding))
+      {
+        mono_pub_.publish(raw);
+      }
+      return;
+    }
+
+    const auto makeOutput = [&image](const std::string& encoding, unsigned int channels, unsigned int bytes) {
+      sensor_msgs::ImagePtr output(new sensor_msgs::Image);
+      output->header = image.header;
+      output->height = image.height;
+      output->width = image.width;
+      output->encoding = encoding;
+      output->is_bigendian = image.is_bigendian;
+      output->step = image.width * channels * bytes;
+      output->data.resize(static_cast<size_t>(output->step) * image.height);
+      return output;
+    };
+    const unsigned int bytes = bit_depth / 8;
+    sensor_msgs::ImagePtr color;
+    sensor_msgs::ImagePtr mono;
+    if (publish_color)
+    {
+      color = makeOutput(bit_depth == 8 ? sensor_msgs::image_encodings::RGB8 : sensor_msgs::image_encodings::RGB16,
+                         3, bytes);
+    }
+    if (publish_mono)
+    {
+      mono = makeOutput(bit_depth == 8 ? sensor_msgs::image_encodings::MONO8 : sensor_msgs::image_encodings::MONO16,
+                        1, bytes);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    demosaicer_->process(image.data.data(), image.width, image.height, image.step, pattern, bit_depth,
+                         color ? color->data.data() : nullptr, color ? color->step : 0,
+                         mono ? mono->data.data() : nullptr, mono ? mono->step : 0);
+    last_demosaic_ms_ =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (color)
+    {
+      color_pub_.publish(color);
+    }
+    if (mono)
+    {
+      mono_pub_.publish(mono);
+    }
+  }
+
+  /*!
+  * \brief Selects the frames of the decimated outputs.
+  *
+  * Has to be called for every frame in acquisition order, before it is published.
+  * \param stamp_ns Camera time stamp of the frame.
+  * \return True if any decimated output selected the frame.
+  */
+  bool selectDecimatedFrame(uint64_t stamp_ns)
+  {
+    bool selected = false;
+    for (auto& output : decimated_outputs_)
+    {
+      output.selected = output.decimator.select(stamp_ns);
+      selected = selected || output.selected;
+    }
+    return selected;
+  }
+
+  /*!
+  * \brief Publishes the half and quarter resolution images, reduced from the image in one pass.
+  *
+  * Bayer images are reduced to RGB. Has to be called after ci_ was updated for the image.
+  * \param image The full resolution image, stamped already.
+  */
+  void publishPyramid(const sensor_msgs::Image& image)
+  {
+    const bool publish_half = half_pub_.getNumSubscribers() > 0;
+    const bool publish_quarter = quarter_pub_.getNumSubscribers() > 0;
+    if (!publish_half && !publish_quarter)
+    {
+      return;
+    }
+    std::string encoding;
+    if (!ImagePyramid::getReducedEncoding(image.encoding, &encoding))
+    {
+      NODELET_WARN_THROTTLE(10, "Cannot reduce the resolution of %s images.", image.encoding.c_str());
+      return;
+    }
+
+    const size_t pixel_size = ImagePyramid::getReducedPixelSize(image.encoding);
+    const auto makeLevel = [&](uint32_t factor, sensor_msgs::ImagePtr* level, sensor_msgs::CameraInfoPtr* info) {
+      level->reset(new sensor_msgs::Image);
+      (*level)->header = image.header;
+      (*level)->height = image.height / factor;
+      (*level)->width = image.width / factor;
+      (*level)->encoding = encoding;
+      (*level)->is_bigendian = image.is_bigendian;
+      (*level)->step = static_cast<uint32_t>((*level)->width * pixel_size);
+      (*level)->data.resize(static_cast<size_t>((*level)->step) * (*level)->height);
+      // Following REP 104, K and the image size stay at the calibration resolution and the binning scales them.
+      info->reset(new sensor_msgs::CameraInfo(*ci_));
+      (*info)->binning_x = std::max<uint32_t>(1, ci_->binning_x) * factor;
+      (*info)->binning_y = std::max<uint32_t>(1, ci_->binning_y) * factor;
+    };
+    sensor_msgs::ImagePtr half;
+    sensor_msgs::ImagePtr quarter;
+    sensor_msgs::CameraInfoPtr half_info;
+    sensor_msgs::CameraInfoPtr quarter_info;
+    if (publish_half)
+    {
+      makeLevel(2, &half, &half_info);
+    }
+    if (publish_quarter)
+    {
+      makeLevel(4, &quarter, &quarter_info);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    pyramid_->reduce(image.data.data(), image.width, image.height, image.step, image.encoding,
+                     half ? half->data.data() : nullptr, half ? half->step : 0,
+                     quarter ? quarter->data.data() : nullptr, quarter ? quarter->step : 0);
+    last_pyramid_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (half)
+    {
+      half_pub_.publish(half, half_info);
+    }
+    if (quarter)
+    {
+      quarter_pub_.publish(quarter, quarter_info);
+    }
+  }
+
+  /*!
+  * \brief Copies an image into the shared memory frame ring and publishes its descriptor.
+  *
+  * The ring is created on the first frame, so that its slots can be sized to the frames if no slot size is given.
+  * \param image The image to share, stamped already.
+  */
+  void publishSharedFrame(const sensor_msgs::Image& image)
+  {
+    if (!shared_ring_)
+    {
+      const size_t slot_size = shared_ring_slot_size_mb_ > 0 ? static_cast<size_t>(shared_ring_slot_size_mb_) << 20
+                                                             : image.data.size();
+      try
+      {
+        shared_ring_.reset(new SharedFrameRing(shared_ring_name_, static_cast<uint32_t>(shared_ring_slots_), slot_size));
+        NODELET_INFO("Sharing frames in shared memory '%s' (%d slots of %zu bytes).", shared_ring_name_.c_str(),
+                     shared_ring_slots_, shared_ring_->getSlotSize());
+      }
+      catch (const std::runtime_error& e)
+      {
+        NODELET_ERROR("Failed to create the shared memory frame ring, disabling it: %s", e.what());
+        shared_memory_ = false;
+        return;
+      }
+    }
+
+    any_spinnaker_camera_driver::SharedFrameDescriptorPtr descriptor(
+        new any_spinnaker_camera_driver::SharedFrameDescriptor());
+    if (!shared_ring_->write(image.data.data(), image.data.size(), &descriptor->slot, &descriptor->sequence))
+    {
+      NODELET_WARN_THROTTLE(10, "Dropped a frame for shared memory, all slots are in use or the frame is too large. "
+                                "(throttled: 10s)");
+      return;
+    }
+    descriptor->header = image.header;
+    descriptor->ring_name = shared_ring_->getName();
+    descriptor->ring_id = shared_ring_->getRingId();
+    descriptor->size = static_cast<uint32_t>(image.data.size());
+    descriptor->height = image.height;
+    descriptor->width = image.width;
+    descriptor->encoding = image.encoding;
+    descriptor->is_bigendian = image.is_bigendian;
+    descriptor->step = image.step;
+    descriptor->info = *ci_;
+    shared_frame_pub_.publish(descriptor);
+  }
+
+  /*!
+  * \brief Takes the recovery action for a failed grab that the recovery policy chooses.
+  *
+  * Transient failures are handled in place, only repeated ones lead to the ERROR state and a full reconnect.
+  */
+  void recoverFromGrabFailure()
+  {
+    // A removed camera will not come back by retrying, reconnect once it arrived again.
+    const bool device_lost = spinnaker_.wasRemoved();
+    if (device_lost)
+    {
+      NODELET_WARN("The camera was removed.");
+    }
+    const GrabRecoveryPolicy::Tier tier = recovery_.onFailure(GrabRecoveryPolicy::Clock::now(), device_lost);
+    try
+    {
+      switch (tier)
+      {
+        case GrabRecoveryPolicy::Tier::RETRY:
+          break;
+        case GrabRecoveryPolicy::Tier::REARM:
+          NODELET_WARN("Re-arming the acquisition after repeated grab failures.");
+          spinnaker_.stop();
+          spinnaker_.start();
+          break;
+        case GrabRecoveryPolicy::Tier::REINIT:
+          NODELET_WARN("Re-initializing the camera after repeated grab failures.");
+          spinnaker_.reinitialize();
+          {
+            std::lock_guard<std::mutex> configLock(config_mutex_);
+            spinnaker_.restoreConfiguration(config_, true);
+          }
+          spinnaker_.start();
+          break;
+        default:
+          NODELET_WARN("Reconnecting to the camera after repeated grab failures.");
+          state = ERROR;
+          break;
+      }
+    }
+    catch (const std::runtime_error& e)
+    {
+      // The next grab fails as well and escalates further.
+      NODELET_ERROR("Recovery (%s) failed: %s", GrabRecoveryPolicy::toString(tier).c_str(), e.what());
+    }
+  }
+
+  /*!
+  * \brief Function for the boost::thread to read recorded images and publish them.
+  *
+  * Replaces devicePoll() when a replay file is given. Frames are published at their recorded timing scaled by the
+  * replay rate, or as fast as possible if the rate is not positive.
+  */
+  void replayPoll()
+  {
+    NODELET_INFO("Replaying frames from %s.", replay_file_.c_str());
+    prefaultStack(acquisition_thread_config_.prefault_stack_size);
+    state = STARTED;
+
+    ros::Time first_recorded_stamp;
+    ros::WallTime first_wall_time;
+    size_t frames_since_rewind = 0;
+    while (!boost::this_thread::interruption_requested())
+    {
+      wfov_camera_msgs::WFOVImagePtr wfov_image(new wfov_camera_msgs::WFOVImage);
+      if (!replay_source_->next(&wfov_image->image))
+      {
+        if (!replay_loop_ || frames_since_rewind == 0)
+        {
+          NODELET_INFO("Replay finished after %lu frames.", static_cast<unsigned long>(replayed_frames_.load()));
+          state = STOPPED;
+          break;
+        }
+        replay_source_->rewind();
+        frames_since_rewind = 0;
+        continue;
+      }
+
+      const ros::Time recorded_stamp = wfov_image->image.header.stamp;
+      if (frames_since_rewind == 0)
+      {
+        first_recorded_stamp = recorded_stamp;
+        first_wall_time = ros::WallTime::now();
+      }
+      else if (replay_rate_ > 0.0)
+      {
+        const ros::WallTime due =
+            first_wall_time + ros::WallDuration((recorded_stamp - first_recorded_stamp).toSec() / replay_rate_);
+        const ros::WallDuration wait = due - ros::WallTime::now();
+        if (wait > ros::WallDuration(0.0))
+        {
+          // Interruptible, so that the nodelet can be unloaded during long gaps in the recording.
+          boost::this_thread::sleep_for(boost::chrono::nanoseconds(wait.toNSec()));
+        }
+      }
+      frames_since_rewind++;
+
+      // The decimators see every frame, only their frames are published without full rate subscribers.
+      const bool selected = selectDecimatedFrame(wfov_image->image.header.stamp.toNSec());
+      if (!selected && !decimated_outputs_.empty() && !full_rate_subscribers_)
+      {
+        continue;
+      }
+      publishImage(wfov_image, replay_use_recorded_stamps_ ? recorded_stamp : ros::Time::now(),
+                   frame_metadata_.load());
+      replayed_frames_++;
+
+      // Update diagnostics
+      updater_.update();
+    }
+  }
+
+  /*!
+  * \brief Starts the thread that produces the images, reading them from the camera or from a replay file.
+  */
+  void startPollThread()
+  {
+    if (replay_source_)
+    {
+      pubThread_.reset(
+          new boost::thread(boost::bind(&any_spinnaker_camera_driver::SpinnakerCameraNodelet::replayPoll, this)));
+    }
+    else
+    {
+      pubThread_.reset(
+          new boost::thread(boost::bind(&any_spinnaker_camera_driver::SpinnakerCameraNodelet::devicePoll, this)));
+    }
+    configureThread(pubThread_.get(), acquisition_thread_config_, "acquisition", &acquisition_thread_scheduling_);
+  }
+
+  /*!
+  * \brief Starts the thread that processes the camera diagnostics.
+  */
+  void startDiagThread()
+  {
+    diagThread_.reset(
+        new boost::thread(boost::bind(&any_spinnaker_camera_driver::SpinnakerCameraNodelet::diagPoll, this)));
+    configureThread(diagThread_.get(), diagnostics_thread_config_, "diagnostics", &diagnostics_thread_scheduling_);
+  }
+
+  /*!
+  * \brief Reads the scheduling config of a thread from the parameters in the given namespace.
+  */
+  ThreadConfig readThreadConfig(ros::NodeHandle& pnh, const std::string& ns)
+  {
+    ThreadConfig config;
+    pnh.param<std::string>(ns + "/policy", config.policy, "other");
+    pnh.param<int>(ns + "/priority", config.priority, 0);
+    pnh.param<std::vector<int>>(ns + "/cpus", config.cpus, std::vector<int>());
+    int prefault_stack_kb;
+    pnh.param<int>(ns + "/prefault_stack_kb", prefault_stack_kb, 0);
+    config.prefault_stack_size = static_cast<size_t>(std::max(0, prefault_stack_kb)) * 1024;
+    return config;
+  }
+
+  /*!
+  * \brief Applies a scheduling config to a driver thread and stores the result for the diagnostics.
+  */
+  void configureThread(boost::thread* thread, const ThreadConfig& config, const std::string& name,
+                       std::string* scheduling)
+  {
+    const ThreadConfigResult result = applyThreadConfig(thread->native_handle(), config);
+    if (result.complete)
+    {
+      NODELET_INFO("Running the %s thread with %s.", name.c_str(), result.toString().c_str());
+    }
+    else
+    {
+      NODELET_WARN("Running the %s thread with %s.", name.c_str(), result.toString().c_str());
+    }
+    std::lock_guard<std::mutex> scopedLock(thread_config_mutex_);
+    *scheduling = result.toString();
+  }
+
+  void gainWBCallback(const image_exposure_msgs::ExposureSequence& msg)
+  {
+    try
+    {
+      NODELET_DEBUG_ONCE("Gain callback:  Setting gain to %f and white balances to %u, %u", msg.gain,
+                         msg.white_balance_blue, msg.white_balance_red);
+      spinnaker_.setGain(static_cast<float>(msg.gain));
+      frame_metadata_.modify([&msg](FrameMetadata* metadata) {
+        metadata->gain = msg.gain;
+        metadata->wb_blue = msg.white_balance_blue;
+        metadata->wb_red = msg.white_balance_red;
+      });
+
+      // TODO(mhosmar):
+      // spinnaker_.setBRWhiteBalance(false, msg.white_balance_blue, msg.white_balance_red);
+    }
+    catch (std::runtime_error& e)
+    {
+      NODELET_ERROR("gainWBCallback failed with error: %s", e.what());
+    }
+  }
+
+  /*!
+   * \brief Function that calculates the interface diagnostic status.
+   *
+   * This function reads the driver internal `state` variable and determines the interface status based on it.
    * It is added to the _interface_diag_updater and gets called on every _interface_diag_updater.update()
    * \param stat  diagnostic_updater::DiagnosticStatusWrapper the diagnostic status that will be published by the interface diagnostic
    * updater
@@ -799,6 +2043,135 @@ private:
     std::string interface_status_message{};
     getROSDiagnosticsInfo(interface_status_level, interface_status_message);
     stat.summary(interface_status_level, interface_status_message);
+
+    if (replay_source_)
+    {
+      stat.add("Replay file", replay_file_);
+      stat.add("Replay rate", replay_rate_);
+      stat.add("Replayed frames", replayed_frames_.load());
+    }
+    if (recorder_)
+    {
+      stat.add("Flight recorder file", recorder_->getPath());
+      stat.add("Recorded frames", recorder_->getRecordedFrames());
+      stat.add("Frames too large to record", recorder_->getDroppedFrames());
+    }
+    {
+      std::lock_guard<std::mutex> scopedLock(thread_config_mutex_);
+      stat.add("Acquisition thread scheduling", acquisition_thread_scheduling_);
+      stat.add("Diagnostics thread scheduling", diagnostics_thread_scheduling_);
+    }
+    stat.add("Fast start", fast_start_);
+    stat.add("Startup phases", startup_profiler_.toString());
+    if (startup_orchestrator_)
+    {
+      const StartupOrchestrator::CameraTiming timing = startup_orchestrator_->getTiming(camera_name_);
+      stat.add("Bring-up attempts", timing.attempts);
+      stat.add("Bring-up [ms]", timing.bring_up_ms);
+      stat.add("Bring-up slot wait [ms]", timing.wait_ms);
+      stat.add("Parallel startup", startup_orchestrator_->toString());
+    }
+    if (!replay_source_)
+    {
+      const GrabRecoveryPolicy::Statistics recovery = recovery_.getStatistics();
+      stat.add("Recovered grab failure incidents", recovery.incidents);
+      stat.add("Last recovery downtime [ms]", recovery.last_downtime_ms);
+      stat.add("Max recovery downtime [ms]", recovery.max_downtime_ms);
+      stat.add("Last recovery tier", GrabRecoveryPolicy::toString(recovery.last_tier));
+      std::stringstream per_tier;
+      for (size_t tier = 1; tier < GrabRecoveryPolicy::TIER_COUNT; ++tier)
+      {
+        per_tier << (tier > 1 ? ", " : "") << GrabRecoveryPolicy::toString(static_cast<GrabRecoveryPolicy::Tier>(tier))
+                 << ": " << recovery.incidents_per_tier[tier];
+      }
+      stat.add("Recovered incidents per tier", per_tier.str());
+      stat.add("Frames failed to publish", publish_failures_.load());
+      stat.add("Last device arrival to first frame [ms]", last_arrival_to_frame_ms_.load());
+    }
+    if (const StreamBufferPool* buffer_pool = spinnaker_.getStreamBufferPool())
+    {
+      stat.add("Stream buffers", std::to_string(buffer_pool->bufferCount()) + " x " +
+                                     std::to_string(buffer_pool->bufferSize()) + " bytes, user allocated");
+      stat.add("Stream buffers huge page backed", buffer_pool->isHugePageBacked());
+      stat.add("Stream buffers locked", buffer_pool->isLocked());
+      stat.add("Stream buffer allocations", buffer_pool->getAllocations());
+    }
+    if (lazy_acquisition_)
+    {
+      stat.add("Acquisition paused", state == PAUSED);
+      stat.add("Acquisition resumes", resumes_.load());
+      stat.add("Last resume time to first frame [ms]", last_resume_time_ms_.load());
+      stat.add("Max resume time to first frame [ms]", max_resume_time_ms_.load());
+    }
+    if (shared_ring_)
+    {
+      stat.add("Shared memory ring", shared_ring_->getName());
+      stat.add("Frames dropped for shared memory", shared_ring_->getDroppedFrames());
+      stat.add("Shared memory references reclaimed", shared_ring_->getReclaimedReferences());
+    }
+    if (demosaicer_)
+    {
+      stat.add("Demosaicing", BayerDemosaicer::toString(demosaicer_->getMethod()) + " on " +
+                                  std::to_string(demosaicer_->getThreads()) + " threads, " +
+                                  BayerDemosaicer::getKernelName() + " kernels");
+      stat.add("Last demosaicing time [ms]", last_demosaic_ms_.load());
+    }
+    if (pyramid_)
+    {
+      stat.add("Last pyramid time [ms]", last_pyramid_ms_.load());
+    }
+    if (compression_pool_)
+    {
+      const CompressionPool::Statistics compression = compression_pool_->getStatistics();
+      stat.add("Compressed frames", compression.compressed);
+      stat.add("Compressed frames dropped", compression.dropped);
+      stat.add("Compression failures", compression.failed);
+      if (!compression.last_error.empty())
+      {
+        stat.add("Last compression failure", compression.last_error);
+      }
+      stat.add("Last compression time [ms]", compression.last_compression_ms);
+      stat.add("Last compression latency [ms]", compression.last_latency_ms);
+      stat.add("Max compression latency [ms]", compression.max_latency_ms);
+    }
+    if (raw_codec_)
+    {
+      stat.add("Raw codec compression ratio", raw_codec_ratio_.load());
+      stat.add("Last raw codec encoding time [ms]", last_raw_codec_ms_.load());
+      stat.add("Raw codec throughput [MB/s]", raw_codec_throughput_.load());
+    }
+    DecompressionPool::Statistics decompression;
+    if (spinnaker_.getDecompressionStatistics(&decompression))
+    {
+      stat.add("Decompressed frames", decompression.decompressed);
+      stat.add("Decompression failures", decompression.failed);
+      if (!decompression.last_error.empty())
+      {
+        stat.add("Last decompression failure", decompression.last_error);
+      }
+      stat.add("On-camera compression ratio", decompression.compression_ratio);
+      stat.add("Last decompression time [ms]", decompression.last_decompression_ms);
+      stat.add("Max decompression time [ms]", decompression.max_decompression_ms);
+      stat.add("Link payload rate [MB/s]", decompression.payload_rate_mb_s);
+      stat.add("Link utilization [%]", 100.0 * decompression.link_utilization);
+    }
+    PixelFormatChoice pixel_format;
+    if (spinnaker_.getPixelFormatChoice(&pixel_format))
+    {
+      stat.add("Negotiated pixel format", pixel_format.pixel_format);
+      stat.add("Link savings [%]", 100.0 * pixel_format.getSavings());
+      stat.add("Link savings compared with", pixel_format.reference_format);
+    }
+    ImageFormatFactors software_binning;
+    spinnaker_.getSoftwareBinning(&software_binning);
+    if (software_binning.binning_x != 1 || software_binning.binning_y != 1 || software_binning.decimation_x != 1 ||
+        software_binning.decimation_y != 1)
+    {
+      stat.add("Host binning", std::to_string(software_binning.binning_x) + "x" +
+                                   std::to_string(software_binning.binning_y));
+      stat.add("Host decimation", std::to_string(software_binning.decimation_x) + "x" +
+                                      std::to_string(software_binning.decimation_y));
+    }
   }
 
   /*!
@@ -849,27 +2222,119 @@ private:
   double max_freq_;
 
   SpinnakerCamera spinnaker_;      ///< Instance of the SpinnakerCamera library, used to interface with the hardware.
-  sensor_msgs::CameraInfoPtr ci_;  ///< Camera Info message.
+  sensor_msgs::CameraInfoConstPtr ci_;  ///< Camera Info message of the last image, part of its WFOVImage.
   std::string frame_id_;           ///< Frame id for the camera messages, defaults to 'camera'
   ros::Time prevImgRosTime_;
   std::shared_ptr<boost::thread> pubThread_;  ///< The thread that reads and publishes the images.
   std::shared_ptr<boost::thread> diagThread_;  ///< The thread that reads and publishes the diagnostics.
+  std::shared_ptr<boost::thread> initThread_;  ///< The thread that waits for the serial file before initializing.
 
-  std::unique_ptr<DiagnosticsManager> diag_man;
+  // Scheduling of the threads above:
+  ThreadConfig acquisition_thread_config_;
+  ThreadConfig diagnostics_thread_config_;
+  std::mutex thread_config_mutex_;
+  std::string acquisition_thread_scheduling_;  ///< Scheduling actually applied, for the diagnostics.
+  std::string diagnostics_thread_scheduling_;
 
-  double gain_;
-  uint16_t wb_blue_;
-  uint16_t wb_red_;
+  std::unique_ptr<DiagnosticsManager> diag_man;
+  std::unique_ptr<FrameRecorder> recorder_;  ///< Flight recorder for the raw frames, null if disabled.
+  GrabRecoveryPolicy recovery_;              ///< Chooses how to recover from failed grabs.
+  std::atomic<uint64_t> publish_failures_{ 0 };  ///< Grabbed frames that failed in the publish path.
+
+  // Startup:
+  StartupProfiler startup_profiler_;  ///< Phases from the construction of the nodelet to the first frame.
+  bool startup_finished_{ false };    ///< Set by the publishing thread once the first frame was published.
+  bool fast_start_{ false };
+  /// Brings up the cameras of the process concurrently, null if disabled.
+  std::shared_ptr<StartupOrchestrator> startup_orchestrator_;
+  std::atomic<bool> camera_configured_{ false };  ///< With a deferred setup, set once devicePoll configured the camera.
+  std::once_flag camera_setup_flag_;              ///< setupConnectedCamera() runs once.
+  std::atomic<double> last_arrival_to_frame_ms_{ 0.0 };  ///< Time from the camera arriving to its first frame.
+
+  /// Topic publishing every n-th frame.
+  struct DecimatedOutput
+  {
+    DecimatedOutput(unsigned int factor, const image_transport::Publisher& publisher)
+      : decimator(factor), publisher(publisher)
+    {
+    }
 
-  // Parameters for cameraInfo
-  size_t binning_x_;     ///< Camera Info pixel binning along the image x axis.
-  size_t binning_y_;     ///< Camera Info pixel binning along the image y axis.
-  size_t roi_x_offset_;  ///< Camera Info ROI x offset
-  size_t roi_y_offset_;  ///< Camera Info ROI y offset
-  size_t roi_height_;    ///< Camera Info ROI height
-  size_t roi_width_;     ///< Camera Info ROI width
-  bool do_rectify_;  ///< Whether or not to rectify as if part of an image.  Set to false if whole image, and true if in
-                     /// ROI mode.
+    FrameDecimator decimator;
+    image_transport::Publisher publisher;
+    bool selected{ false };  ///< The decimator selected the current frame.
+  };
+  std::vector<DecimatedOutput> decimated_outputs_;
+
+  // Demosaicing in the driver instead of image_proc/debayer:
+  std::unique_ptr<BayerDemosaicer> demosaicer_;  ///< Null if disabled.
+  image_transport::Publisher color_pub_;         ///< image_color, RGB.
+  image_transport::Publisher mono_pub_;          ///< image_mono.
+  std::atomic<double> last_demosaic_ms_{ 0.0 };
+
+  // Reduced resolution outputs:
+  std::unique_ptr<ImagePyramid> pyramid_;  ///< Null if neither level is enabled.
+  image_transport::CameraPublisher half_pub_;
+  image_transport::CameraPublisher quarter_pub_;
+  std::atomic<double> last_pyramid_ms_{ 0.0 };
+
+  // Compression of image_raw shared by all subscribers:
+  ros::Publisher compressed_pub_;                     ///< image_raw/compressed.
+  std::unique_ptr<CompressionPool> compression_pool_;  ///< Null if disabled, declared after its publisher.
+
+  // Lossless raw codec:
+  std::unique_ptr<RawCodec> raw_codec_;  ///< Null if neither published nor recorded.
+  ros::Publisher raw_codec_pub_;         ///< image_raw/rawcodec.
+  bool raw_codec_record_{ false };       ///< The flight recorder stores the encoded frames.
+  sensor_msgs::CompressedImageConstPtr raw_encoded_;  ///< The current frame if it was encoded already.
+  std::atomic<double> last_raw_codec_ms_{ 0.0 };
+  std::atomic<double> raw_codec_ratio_{ 0.0 };
+  std::atomic<double> raw_codec_throughput_{ 0.0 };  ///< Raw megabytes encoded per second of encoding time.
+
+  // Lazy acquisition, stopping the acquisition while nobody subscribes:
+  bool lazy_acquisition_{ false };
+  std::mutex subscribers_mutex_;
+  std::condition_variable subscribers_cv_;  ///< Notified by connectCb to resume a paused acquisition.
+  /// Cached by connectCb, so that the acquisition does not lock the connect mutex for every frame.
+  std::atomic<bool> has_subscribers_{ true };
+  /// Any subscriber other than the decimated outputs, which need only their frames to be turned into messages.
+  std::atomic<bool> full_rate_subscribers_{ true };
+  std::atomic<bool> subscribers_changed_{ false };           ///< Set by connectCb, guarded by subscribers_mutex_.
+  std::chrono::steady_clock::time_point subscription_time_;  ///< When the last subscriber arrived after none.
+  std::chrono::steady_clock::time_point resume_start_;
+  bool resume_pending_{ false };  ///< True until the first frame after a resume was published.
+  std::atomic<uint64_t> resumes_{ 0 };
+  std::atomic<double> last_resume_time_ms_{ 0.0 };
+  std::atomic<double> max_resume_time_ms_{ 0.0 };
+
+  // Pixel format negotiation for the "auto" image_format_color_coding:
+  SeqLock<OutputDemand> output_demand_;  ///< Images the subscribed topics need, updated by connectCb.
+  std::atomic<bool> output_demand_changed_{ false };  ///< Set by connectCb, the acquisition thread negotiates again.
+  std::chrono::steady_clock::time_point last_negotiation_;
+
+  // Shared memory frame ring for consumers outside of this process:
+  bool shared_memory_{ false };
+  std::string shared_ring_name_;
+  int shared_ring_slots_{ 8 };
+  int shared_ring_slot_size_mb_{ 0 };
+  std::unique_ptr<SharedFrameRing> shared_ring_;  ///< Created on the first shared frame.
+  ros::Publisher shared_frame_pub_;                ///< Publishes the SharedFrameDescriptor messages.
+
+  // Replay of recorded frames instead of the camera:
+  std::unique_ptr<ReplaySource> replay_source_;  ///< Source of the recorded frames, null when using the camera.
+  std::string replay_file_;
+  double replay_rate_{ 1.0 };  ///< Multiple of the recorded frame timing, not positive to replay as fast as possible.
+  bool replay_loop_{ false };
+  bool replay_use_recorded_stamps_{ false };
+  std::atomic<uint64_t> replayed_frames_{ 0 };
+
+  /// Written by the configuration callbacks, read once per frame by the publishing thread without locking.
+  SeqLock<FrameMetadata> frame_metadata_;
+
+  // CameraInfo cached by the publishing thread, rebuilt only if the calibration, the ROI or the binning changed:
+  sensor_msgs::CameraInfo calibration_;         ///< Calibration as last read from the CameraInfoManager.
+  sensor_msgs::CameraInfoConstPtr camera_info_;  ///< Calibration with the ROI and binning applied, without header.
+  FrameMetadata camera_info_metadata_;           ///< Metadata that camera_info_ was built for.
+  std::chrono::steady_clock::time_point last_calibration_check_;
 
   // For GigE cameras:
   /// If true, GigE packet size is automatically determined, otherwise packet_size_ is used:
@@ -881,6 +2346,9 @@ private:
 
   /// Configuration:
   any_spinnaker_camera_driver::SpinnakerConfig config_;
+  /// Guards config_ and is held while it is applied to the camera, written by dynamic_reconfigure and read by the
+  /// acquisition thread.
+  std::mutex config_mutex_;
   enum State
   {
     NONE,
@@ -888,7 +2356,8 @@ private:
     STOPPED,
     DISCONNECTED,
     CONNECTED,
-    STARTED
+    STARTED,
+    PAUSED  ///< Connected and configured, but not acquiring because nothing subscribes.
   };
   std::atomic<State> state;
   std::atomic<State> previous_state;
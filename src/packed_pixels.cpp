@@ -0,0 +1,132 @@
+/**
+Software License Agreement (BSD)
+
+\file      packed_pixels.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/packed_pixels.h"
+
+#include <stdexcept>
+
+// The unpack kernel is built for AVX2 and the baseline, the dynamic loader picks the variant supported by the CPU.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define UNPACK_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define UNPACK_KERNEL
+#endif
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+bool endsWith(const std::string& text, const std::string& suffix)
+{
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/** Unpacks one row, the loop over the pixel pairs is vectorized by the compiler. */
+template <bool MsbPacked>
+inline void unpackRow(const uint8_t* __restrict src, size_t width, uint16_t* __restrict dst)
+{
+  const size_t pairs = width / 2;
+  for (size_t i = 0; i < pairs; ++i)
+  {
+    const unsigned int byte0 = src[3 * i];
+    const unsigned int byte1 = src[3 * i + 1];
+    const unsigned int byte2 = src[3 * i + 2];
+    if (MsbPacked)
+    {
+      dst[2 * i] = static_cast<uint16_t>((byte0 << 8) | ((byte1 & 0x0f) << 4));
+      dst[2 * i + 1] = static_cast<uint16_t>((byte2 << 8) | (byte1 & 0xf0));
+    }
+    else
+    {
+      dst[2 * i] = static_cast<uint16_t>(((byte1 & 0x0f) << 12) | (byte0 << 4));
+      dst[2 * i + 1] = static_cast<uint16_t>((byte2 << 8) | (byte1 & 0xf0));
+    }
+  }
+  if (width % 2 != 0)
+  {
+    // The last pixel of an odd row only fills a byte and a half.
+    const unsigned int byte0 = src[3 * pairs];
+    const unsigned int byte1 = src[3 * pairs + 1];
+    dst[width - 1] = static_cast<uint16_t>(MsbPacked ? (byte0 << 8) | ((byte1 & 0x0f) << 4) :
+                                                       ((byte1 & 0x0f) << 12) | (byte0 << 4));
+  }
+}
+
+UNPACK_KERNEL void unpackRows(const uint8_t* src, size_t width, size_t height, size_t src_step, bool msb_packed,
+                              uint16_t* dst, size_t dst_step)
+{
+  for (size_t y = 0; y < height; ++y)
+  {
+    const uint8_t* src_row = src + y * src_step;
+    uint16_t* dst_row = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(dst) + y * dst_step);
+    if (msb_packed)
+    {
+      unpackRow<true>(src_row, width, dst_row);
+    }
+    else
+    {
+      unpackRow<false>(src_row, width, dst_row);
+    }
+  }
+}
+}  // namespace
+
+PackedLayout getPackedLayout(const std::string& pixel_format)
+{
+  if (endsWith(pixel_format, "12p"))
+  {
+    return PackedLayout::LSB_PACKED;
+  }
+  if (endsWith(pixel_format, "12Packed"))
+  {
+    return PackedLayout::MSB_PACKED;
+  }
+  return PackedLayout::NONE;
+}
+
+std::string getPackedEncoding(const std::string& unpacked_encoding, PackedLayout layout)
+{
+  if (layout == PackedLayout::NONE || !endsWith(unpacked_encoding, "16"))
+  {
+    throw std::runtime_error("[getPackedEncoding] No packed encoding for " + unpacked_encoding + ".");
+  }
+  const std::string suffix = layout == PackedLayout::LSB_PACKED ? "12p" : "12packed";
+  return unpacked_encoding.substr(0, unpacked_encoding.size() - 2) + suffix;
+}
+
+void unpack12(const uint8_t* src, size_t width, size_t height, size_t src_step, PackedLayout layout, uint16_t* dst,
+              size_t dst_step)
+{
+  if (layout == PackedLayout::NONE)
+  {
+    throw std::runtime_error("[unpack12] The source is not packed.");
+  }
+  if (src_step < getPackedRowSize(width) || dst_step < 2 * width)
+  {
+    throw std::runtime_error("[unpack12] The row steps are too small for a width of " + std::to_string(width) + ".");
+  }
+  unpackRows(src, width, height, src_step, layout == PackedLayout::MSB_PACKED, dst, dst_step);
+}
+}  // namespace any_spinnaker_camera_driver
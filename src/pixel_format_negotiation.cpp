@@ -0,0 +1,125 @@
+/**
+Software License Agreement (BSD)
+
+\file      pixel_format_negotiation.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/pixel_format_negotiation.h"
+
+#include <algorithm>
+
+namespace any_spinnaker_camera_driver
+{
+const char* const AUTO_PIXEL_FORMAT = "auto";
+
+namespace
+{
+bool startsWith(const std::string& text, const std::string& prefix)
+{
+  return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool endsWith(const std::string& text, const std::string& suffix)
+{
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/** The first of the candidates the camera offers, empty if none. */
+std::string findFirst(const std::vector<std::string>& available_formats, const std::vector<std::string>& candidates)
+{
+  for (const std::string& candidate : candidates)
+  {
+    if (std::find(available_formats.begin(), available_formats.end(), candidate) != available_formats.end())
+    {
+      return candidate;
+    }
+  }
+  return "";
+}
+}  // namespace
+
+double getBytesPerPixel(const std::string& pixel_format)
+{
+  if (endsWith(pixel_format, "12p") || endsWith(pixel_format, "12Packed") || pixel_format == "YUV411Packed" ||
+      pixel_format == "YCbCr411_8")
+  {
+    return 1.5;
+  }
+  if (pixel_format == "YUV422Packed" || pixel_format == "YCbCr422_8")
+  {
+    return 2.0;
+  }
+  if (pixel_format == "RGB8" || pixel_format == "RGB8Packed" || pixel_format == "BGR8" ||
+      pixel_format == "YUV444Packed" || pixel_format == "YCbCr8")
+  {
+    return 3.0;
+  }
+  if (pixel_format == "BGRa8" || pixel_format == "RGBa8")
+  {
+    return 4.0;
+  }
+  if (startsWith(pixel_format, "Mono") || startsWith(pixel_format, "Bayer"))
+  {
+    if (endsWith(pixel_format, "16"))
+    {
+      return 2.0;
+    }
+    if (endsWith(pixel_format, "8"))
+    {
+      return 1.0;
+    }
+  }
+  return 0.0;
+}
+
+PixelFormatChoice negotiatePixelFormat(const std::vector<std::string>& available_formats, const OutputDemand& demand)
+{
+  const std::string bayer = findFirst(available_formats, { "BayerRG8", "BayerGB8", "BayerGR8", "BayerBG8" });
+  const std::string mono = findFirst(available_formats, { "Mono8" });
+
+  PixelFormatChoice choice;
+  if (!bayer.empty())
+  {
+    const bool mono_only = demand.mono && !demand.color && !demand.raw;
+    choice.pixel_format = mono_only && !mono.empty() ? mono : bayer;
+    if (demand.color)
+    {
+      choice.reference_format = findFirst(available_formats, { "RGB8", "RGB8Packed", "BGR8", "BGRa8" });
+    }
+    else if (mono_only && !mono.empty())
+    {
+      choice.reference_format = mono;
+    }
+  }
+  else
+  {
+    choice.pixel_format = mono;
+  }
+  if (choice.reference_format.empty())
+  {
+    choice.reference_format = choice.pixel_format;
+  }
+  choice.bytes_per_pixel = getBytesPerPixel(choice.pixel_format);
+  choice.reference_bytes_per_pixel = getBytesPerPixel(choice.reference_format);
+  return choice;
+}
+}  // namespace any_spinnaker_camera_driver
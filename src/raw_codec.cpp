@@ -0,0 +1,749 @@
+/**
+Software License Agreement (BSD)
+
+\file      raw_codec.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/raw_codec.h"
+
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// The row kernels are built for AVX2 and the baseline, the dynamic loader picks the variant supported by the CPU.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define RAW_CODEC_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define RAW_CODEC_KERNEL
+#endif
+
+#if defined(__GNUC__)
+#define RAW_CODEC_INLINE inline __attribute__((always_inline))
+#else
+#define RAW_CODEC_INLINE inline
+#endif
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+const char MAGIC[4] = { 'R', 'A', 'W', 'C' };
+constexpr size_t BLOCK_SIZE = 32;      ///< Residuals sharing a Rice parameter.
+constexpr unsigned int K_BITS = 5;     ///< Bits of the Rice parameter in front of every block.
+constexpr unsigned int MAX_K = 16;
+constexpr unsigned int ESCAPE = 16;    ///< Quotients from here on are coded as ESCAPE followed by the raw residual.
+/// Upper bound of the bits of a residual: escape, raw residual of a 16-bit pixel and its share of the block header.
+constexpr size_t MAX_RESIDUAL_BITS = ESCAPE + 1 + 17 + K_BITS;
+
+/** Arrangement of the color planes in a frame, 2 x 2 for Bayer frames and 1 x 1 for mono frames. */
+struct Geometry
+{
+  size_t width;
+  size_t height;
+  size_t planes_x;
+  size_t planes_y;
+
+  size_t planeWidth(size_t plane_x) const
+  {
+    return width > plane_x ? (width - plane_x + planes_x - 1) / planes_x : 0;
+  }
+
+  /** Rows of the tallest plane, the stripes split them. */
+  size_t planeRows() const
+  {
+    return (height + planes_y - 1) / planes_y;
+  }
+
+  size_t stripeBegin(size_t stripe, size_t stripes) const
+  {
+    return stripe * planeRows() / stripes;
+  }
+};
+
+/** Parses the encoding, returns false if it is not supported. */
+bool parseGeometry(const std::string& encoding, unsigned int* bit_depth, size_t* planes)
+{
+  BayerDemosaicer::Pattern pattern;
+  if (BayerDemosaicer::parseEncoding(encoding, &pattern, bit_depth))
+  {
+    *planes = 2;
+    return true;
+  }
+  *planes = 1;
+  if (encoding == "mono8")
+  {
+    *bit_depth = 8;
+    return true;
+  }
+  if (encoding == "mono16")
+  {
+    *bit_depth = 16;
+    return true;
+  }
+  return false;
+}
+
+/** Writes bits least significant first. */
+class BitWriter
+{
+public:
+  explicit BitWriter(uint8_t* data) : begin_(data), data_(data)
+  {
+  }
+
+  /** Appends the lowest length bits, the bits above have to be 0. length is at most 32. */
+  RAW_CODEC_INLINE void put(uint32_t bits, unsigned int length)
+  {
+    buffer_ |= static_cast<uint64_t>(bits) << count_;
+    count_ += length;
+    if (count_ >= 32)
+    {
+      data_[0] = static_cast<uint8_t>(buffer_);
+      data_[1] = static_cast<uint8_t>(buffer_ >> 8);
+      data_[2] = static_cast<uint8_t>(buffer_ >> 16);
+      data_[3] = static_cast<uint8_t>(buffer_ >> 24);
+      data_ += 4;
+      buffer_ >>= 32;
+      count_ -= 32;
+    }
+  }
+
+  /** Writes the remaining bits and returns the size of the stream (bytes). */
+  size_t finish()
+  {
+    for (; count_ > 0; count_ = count_ > 8 ? count_ - 8 : 0)
+    {
+      *data_++ = static_cast<uint8_t>(buffer_);
+      buffer_ >>= 8;
+    }
+    return static_cast<size_t>(data_ - begin_);
+  }
+
+private:
+  uint8_t* begin_;
+  uint8_t* data_;
+  uint64_t buffer_{ 0 };
+  unsigned int count_{ 0 };
+};
+
+/** Reads the bits written by BitWriter, throws if the stream is corrupt. */
+class BitReader
+{
+public:
+  BitReader(const uint8_t* data, size_t size) : data_(data), end_(data + size)
+  {
+    refill();
+  }
+
+  /** Reads length bits, length is at most 32. */
+  RAW_CODEC_INLINE uint32_t get(unsigned int length)
+  {
+    if (count_ < length)
+    {
+      refill();
+    }
+    const uint32_t bits = static_cast<uint32_t>(buffer_ & ((uint64_t{ 1 } << length) - 1));
+    buffer_ >>= length;
+    count_ -= length;
+    return bits;
+  }
+
+  /** Reads a unary quotient up to ESCAPE. */
+  RAW_CODEC_INLINE unsigned int getQuotient()
+  {
+    if (count_ < ESCAPE + 1)
+    {
+      refill();
+    }
+    if ((buffer_ & ((uint64_t{ 1 } << (ESCAPE + 1)) - 1)) == 0)
+    {
+      throw std::runtime_error("[RawCodec::decode] Corrupt stripe.");
+    }
+    const unsigned int quotient = static_cast<unsigned int>(__builtin_ctzll(buffer_));
+    buffer_ >>= quotient + 1;
+    count_ -= quotient + 1;
+    return quotient;
+  }
+
+  /** True if more bits were read than the stream holds. */
+  bool overran() const
+  {
+    return padding_ * 8 > count_;
+  }
+
+private:
+  void refill()
+  {
+    while (count_ <= 56)
+    {
+      uint64_t byte = 0;
+      if (data_ < end_)
+      {
+        byte = *data_++;
+      }
+      else if (++padding_ > 8)
+      {
+        throw std::runtime_error("[RawCodec::decode] Truncated stripe.");
+      }
+      buffer_ |= byte << count_;
+      count_ += 8;
+    }
+  }
+
+  const uint8_t* data_;
+  const uint8_t* end_;
+  uint64_t buffer_{ 0 };
+  unsigned int count_{ 0 };
+  size_t padding_{ 0 };  ///< Zero bytes read past the end.
+};
+
+RAW_CODEC_INLINE uint32_t zigzag(int32_t residual)
+{
+  return (static_cast<uint32_t>(residual) << 1) ^ static_cast<uint32_t>(residual >> 31);
+}
+
+RAW_CODEC_INLINE int32_t unzigzag(uint32_t value)
+{
+  return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+/** Median edge detector of LOCO-I: the median of left, up and their gradient. */
+RAW_CODEC_INLINE int32_t predict(int32_t left, int32_t up, int32_t up_left)
+{
+  const int32_t low = std::min(left, up);
+  const int32_t high = std::max(left, up);
+  return std::min(std::max(left + up - up_left, low), high);
+}
+
+template <typename T>
+RAW_CODEC_INLINE uint32_t orRow(const T* __restrict row, size_t width)
+{
+  uint32_t bits = 0;
+  for (size_t x = 0; x < width; ++x)
+  {
+    bits |= row[x];
+  }
+  return bits;
+}
+
+/** Copies the pixels of one plane out of a frame row, without the low bits that are 0 in the whole frame. */
+template <typename T, size_t Stride>
+RAW_CODEC_INLINE void extractRow(const T* __restrict src, size_t width, unsigned int shift, uint16_t* __restrict dst)
+{
+  for (size_t x = 0; x < width; ++x)
+  {
+    dst[x] = static_cast<uint16_t>(src[Stride * x] >> shift);
+  }
+}
+
+RAW_CODEC_KERNEL uint32_t orRow8(const uint8_t* row, size_t width)
+{
+  return orRow(row, width);
+}
+
+RAW_CODEC_KERNEL uint32_t orRow16(const uint16_t* row, size_t width)
+{
+  return orRow(row, width);
+}
+
+RAW_CODEC_KERNEL void extractRow8(const uint8_t* src, size_t width, size_t stride, unsigned int shift, uint16_t* dst)
+{
+  if (stride == 2)
+  {
+    extractRow<uint8_t, 2>(src, width, shift, dst);
+  }
+  else
+  {
+    extractRow<uint8_t, 1>(src, width, shift, dst);
+  }
+}
+
+RAW_CODEC_KERNEL void extractRow16(const uint16_t* src, size_t width, size_t stride, unsigned int shift,
+                                   uint16_t* dst)
+{
+  if (stride == 2)
+  {
+    extractRow<uint16_t, 2>(src, width, shift, dst);
+  }
+  else
+  {
+    extractRow<uint16_t, 1>(src, width, shift, dst);
+  }
+}
+
+/** Residuals of a plane row, zigzag mapped to unsigned values. The first row of a stripe is predicted from the left. */
+RAW_CODEC_KERNEL void predictRow(const uint16_t* __restrict current, const uint16_t* __restrict previous,
+                                 size_t width, uint32_t* __restrict residuals)
+{
+  if (width == 0)
+  {
+    return;
+  }
+  if (previous == nullptr)
+  {
+    residuals[0] = zigzag(current[0]);
+    for (size_t x = 1; x < width; ++x)
+    {
+      residuals[x] = zigzag(static_cast<int32_t>(current[x]) - static_cast<int32_t>(current[x - 1]));
+    }
+    return;
+  }
+  residuals[0] = zigzag(static_cast<int32_t>(current[0]) - static_cast<int32_t>(previous[0]));
+  for (size_t x = 1; x < width; ++x)
+  {
+    residuals[x] = zigzag(static_cast<int32_t>(current[x]) - predict(current[x - 1], previous[x], previous[x - 1]));
+  }
+}
+
+uint32_t orRow(const uint8_t* row, size_t width)
+{
+  return orRow8(row, width);
+}
+
+uint32_t orRow(const uint16_t* row, size_t width)
+{
+  return orRow16(row, width);
+}
+
+void extractRow(const uint8_t* src, size_t width, size_t stride, unsigned int shift, uint16_t* dst)
+{
+  extractRow8(src, width, stride, shift, dst);
+}
+
+void extractRow(const uint16_t* src, size_t width, size_t stride, unsigned int shift, uint16_t* dst)
+{
+  extractRow16(src, width, stride, shift, dst);
+}
+
+/** Rice codes the residuals of a row in blocks, each with the parameter that fits the mean of its residuals. */
+void encodeResiduals(const uint32_t* residuals, size_t count, unsigned int raw_bits, BitWriter* writer)
+{
+  for (size_t start = 0; start < count; start += BLOCK_SIZE)
+  {
+    const size_t size = std::min(BLOCK_SIZE, count - start);
+    const uint32_t* block = residuals + start;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+      sum += block[i];
+    }
+    // k = floor(log2(mean)).
+    unsigned int k = 0;
+    while (k < MAX_K && (static_cast<uint64_t>(size) << (k + 1)) <= sum)
+    {
+      ++k;
+    }
+    writer->put(k, K_BITS);
+
+    const uint32_t mask = (1u << k) - 1;
+    for (size_t i = 0; i < size; ++i)
+    {
+      const uint32_t quotient = block[i] >> k;
+      if (quotient >= ESCAPE)
+      {
+        writer->put(1u << ESCAPE, ESCAPE + 1);
+        writer->put(block[i], raw_bits);
+      }
+      else if (quotient + 1 + k <= 32)
+      {
+        // Unary quotient terminated by a 1 bit, followed by the k low bits.
+        writer->put((1u << quotient) | ((block[i] & mask) << (quotient + 1)), quotient + 1 + k);
+      }
+      else
+      {
+        writer->put(1u << quotient, quotient + 1);
+        writer->put(block[i] & mask, k);
+      }
+    }
+  }
+}
+
+void decodeResiduals(BitReader* reader, size_t count, unsigned int raw_bits, uint32_t* residuals)
+{
+  for (size_t start = 0; start < count; start += BLOCK_SIZE)
+  {
+    const size_t size = std::min(BLOCK_SIZE, count - start);
+    const unsigned int k = reader->get(K_BITS);
+    if (k > MAX_K)
+    {
+      throw std::runtime_error("[RawCodec::decode] Corrupt stripe.");
+    }
+    for (size_t i = 0; i < size; ++i)
+    {
+      const unsigned int quotient = reader->getQuotient();
+      residuals[start + i] = quotient == ESCAPE ? reader->get(raw_bits) : (quotient << k) | reader->get(k);
+    }
+  }
+}
+
+/** Reverses predictRow(), throws if a pixel is out of range. */
+void reconstructRow(const uint32_t* residuals, const uint16_t* previous, size_t width, int32_t max_value,
+                    uint16_t* current)
+{
+  for (size_t x = 0; x < width; ++x)
+  {
+    int32_t prediction;
+    if (x == 0)
+    {
+      prediction = previous == nullptr ? 0 : previous[0];
+    }
+    else
+    {
+      prediction = previous == nullptr ? current[x - 1] : predict(current[x - 1], previous[x], previous[x - 1]);
+    }
+    const int32_t value = prediction + unzigzag(residuals[x]);
+    if (value < 0 || value > max_value)
+    {
+      throw std::runtime_error("[RawCodec::decode] Corrupt stripe.");
+    }
+    current[x] = static_cast<uint16_t>(value);
+  }
+}
+
+template <typename T>
+size_t encodeStripe(const uint8_t* src, size_t step, const Geometry& geometry, unsigned int shift,
+                    unsigned int raw_bits, size_t begin, size_t end, uint16_t* rows, uint32_t* residuals,
+                    uint8_t* out)
+{
+  const size_t max_width = geometry.planeWidth(0);
+  uint16_t* previous[4];
+  uint16_t* current[4];
+  for (size_t plane = 0; plane < geometry.planes_x * geometry.planes_y; ++plane)
+  {
+    previous[plane] = rows + 2 * plane * max_width;
+    current[plane] = previous[plane] + max_width;
+  }
+
+  BitWriter writer(out);
+  for (size_t row = begin; row < end; ++row)
+  {
+    for (size_t plane_y = 0; plane_y < geometry.planes_y; ++plane_y)
+    {
+      const size_t y = row * geometry.planes_y + plane_y;
+      if (y >= geometry.height)
+      {
+        break;
+      }
+      const T* src_row = reinterpret_cast<const T*>(src + y * step);
+      for (size_t plane_x = 0; plane_x < geometry.planes_x; ++plane_x)
+      {
+        const size_t plane = plane_y * geometry.planes_x + plane_x;
+        const size_t width = geometry.planeWidth(plane_x);
+        extractRow(src_row + plane_x, width, geometry.planes_x, shift, current[plane]);
+        predictRow(current[plane], row == begin ? nullptr : previous[plane], width, residuals);
+        encodeResiduals(residuals, width, raw_bits, &writer);
+        std::swap(previous[plane], current[plane]);
+      }
+    }
+  }
+  return writer.finish();
+}
+
+template <typename T>
+void decodeStripe(const uint8_t* data, size_t size, const Geometry& geometry, unsigned int shift,
+                  unsigned int raw_bits, size_t begin, size_t end, uint8_t* image)
+{
+  const size_t max_width = geometry.planeWidth(0);
+  const size_t planes = geometry.planes_x * geometry.planes_y;
+  std::vector<uint16_t> rows(2 * planes * max_width);
+  std::vector<uint32_t> residuals(max_width);
+  uint16_t* previous[4];
+  uint16_t* current[4];
+  for (size_t plane = 0; plane < planes; ++plane)
+  {
+    previous[plane] = rows.data() + 2 * plane * max_width;
+    current[plane] = previous[plane] + max_width;
+  }
+  const int32_t max_value = (1 << (8 * sizeof(T) - shift)) - 1;
+
+  BitReader reader(data, size);
+  for (size_t row = begin; row < end; ++row)
+  {
+    for (size_t plane_y = 0; plane_y < geometry.planes_y; ++plane_y)
+    {
+      const size_t y = row * geometry.planes_y + plane_y;
+      if (y >= geometry.height)
+      {
+        break;
+      }
+      T* dst_row = reinterpret_cast<T*>(image) + y * geometry.width;
+      for (size_t plane_x = 0; plane_x < geometry.planes_x; ++plane_x)
+      {
+        const size_t plane = plane_y * geometry.planes_x + plane_x;
+        const size_t width = geometry.planeWidth(plane_x);
+        decodeResiduals(&reader, width, raw_bits, residuals.data());
+        reconstructRow(residuals.data(), row == begin ? nullptr : previous[plane], width, max_value, current[plane]);
+        for (size_t x = 0; x < width; ++x)
+        {
+          dst_row[geometry.planes_x * x + plane_x] = static_cast<T>(current[plane][x] << shift);
+        }
+        std::swap(previous[plane], current[plane]);
+      }
+    }
+  }
+  if (reader.overran())
+  {
+    throw std::runtime_error("[RawCodec::decode] Truncated stripe.");
+  }
+}
+}  // namespace
+
+RawCodec::RawCodec(unsigned int threads)
+{
+  threads = std::max(1u, threads);
+  stripe_data_.resize(threads);
+  scratch_.resize(threads);
+  for (size_t stripe = 1; stripe < threads; ++stripe)
+  {
+    workers_.emplace_back(&RawCodec::workerLoop, this, stripe);
+  }
+}
+
+RawCodec::~RawCodec()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_cv_.notify_all();
+  for (auto& worker : workers_)
+  {
+    worker.join();
+  }
+}
+
+bool RawCodec::isSupported(const std::string& encoding)
+{
+  unsigned int bit_depth;
+  size_t planes;
+  return parseGeometry(encoding, &bit_depth, &planes);
+}
+
+void RawCodec::encode(const void* src, size_t width, size_t height, size_t step, const std::string& encoding,
+                      std::vector<uint8_t>* encoded)
+{
+  unsigned int bit_depth;
+  size_t planes;
+  if (!parseGeometry(encoding, &bit_depth, &planes))
+  {
+    throw std::runtime_error("[RawCodec::encode] Cannot encode frames with encoding " + encoding + ".");
+  }
+  if (encoding.size() >= sizeof(RawCodecHeader::encoding))
+  {
+    throw std::runtime_error("[RawCodec::encode] Encoding name too long: " + encoding + ".");
+  }
+  const Geometry geometry{ width, height, planes, planes };
+  const uint8_t* src_bytes = static_cast<const uint8_t*>(src);
+
+  // Frames unpacked from fewer bits, e.g. 12-bit frames in mono16, have low bits that are 0 everywhere.
+  uint32_t set_bits = 0;
+  for (size_t y = 0; y < height; ++y)
+  {
+    set_bits |= bit_depth == 8 ? orRow(src_bytes + y * step, width) :
+                                 orRow(reinterpret_cast<const uint16_t*>(src_bytes + y * step), width);
+  }
+  const unsigned int shift = set_bits == 0 ? 0 : static_cast<unsigned int>(__builtin_ctz(set_bits));
+  // Zigzag mapped residuals need one bit more than the pixels.
+  const unsigned int raw_bits = bit_depth - shift + 1;
+
+  const size_t stripes = std::max<size_t>(1, std::min<size_t>(getThreads(), geometry.planeRows()));
+  const size_t max_width = geometry.planeWidth(0);
+  std::vector<size_t> stripe_sizes(stripes, 0);
+  const std::function<void(size_t)> job = [&](size_t stripe) {
+    if (stripe >= stripes)
+    {
+      return;
+    }
+    const size_t begin = geometry.stripeBegin(stripe, stripes);
+    const size_t end = geometry.stripeBegin(stripe + 1, stripes);
+    const size_t capacity = ((end - begin) * planes * width * MAX_RESIDUAL_BITS + 7) / 8 + 16;
+    if (stripe_data_[stripe].size() < capacity)
+    {
+      stripe_data_[stripe].resize(capacity);
+    }
+    // Two plane rows per plane and the residuals of one plane row.
+    std::vector<uint8_t>& scratch = scratch_[stripe];
+    const size_t rows_size = 2 * planes * planes * max_width * sizeof(uint16_t);
+    const size_t scratch_size = rows_size + max_width * sizeof(uint32_t) + sizeof(uint32_t);
+    if (scratch.size() < scratch_size)
+    {
+      scratch.resize(scratch_size);
+    }
+    uint16_t* rows = reinterpret_cast<uint16_t*>(scratch.data());
+    uint32_t* residuals = reinterpret_cast<uint32_t*>(scratch.data() + (rows_size + 3) / 4 * 4);
+    stripe_sizes[stripe] =
+        bit_depth == 8 ?
+            encodeStripe<uint8_t>(src_bytes, step, geometry, shift, raw_bits, begin, end, rows, residuals,
+                                  stripe_data_[stripe].data()) :
+            encodeStripe<uint16_t>(src_bytes, step, geometry, shift, raw_bits, begin, end, rows, residuals,
+                                   stripe_data_[stripe].data());
+  };
+  runStripes(job);
+
+  RawCodecHeader header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.bit_depth = static_cast<uint8_t>(bit_depth);
+  header.shift = static_cast<uint8_t>(shift);
+  header.width = static_cast<uint32_t>(width);
+  header.height = static_cast<uint32_t>(height);
+  header.stripes = static_cast<uint32_t>(stripes);
+  std::strncpy(header.encoding, encoding.c_str(), sizeof(header.encoding) - 1);
+
+  size_t total = sizeof(header) + stripes * sizeof(uint32_t);
+  for (const size_t size : stripe_sizes)
+  {
+    total += size;
+  }
+  encoded->resize(total);
+  uint8_t* out = encoded->data();
+  std::memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  for (const size_t size : stripe_sizes)
+  {
+    const uint32_t size32 = static_cast<uint32_t>(size);
+    std::memcpy(out, &size32, sizeof(size32));
+    out += sizeof(size32);
+  }
+  for (size_t stripe = 0; stripe < stripes; ++stripe)
+  {
+    std::memcpy(out, stripe_data_[stripe].data(), stripe_sizes[stripe]);
+    out += stripe_sizes[stripe];
+  }
+}
+
+bool RawCodec::readHeader(const uint8_t* data, size_t size, RawCodecHeader* header)
+{
+  if (size < sizeof(RawCodecHeader))
+  {
+    return false;
+  }
+  std::memcpy(header, data, sizeof(RawCodecHeader));
+  header->encoding[sizeof(header->encoding) - 1] = '\0';
+  return std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION;
+}
+
+void RawCodec::decode(const uint8_t* data, size_t size, RawCodecHeader* header, std::vector<uint8_t>* image)
+{
+  if (!readHeader(data, size, header))
+  {
+    throw std::runtime_error("[RawCodec::decode] Not a frame of this codec version.");
+  }
+  unsigned int bit_depth;
+  size_t planes;
+  if (!parseGeometry(header->encoding, &bit_depth, &planes) || bit_depth != header->bit_depth ||
+      header->shift >= bit_depth)
+  {
+    throw std::runtime_error("[RawCodec::decode] Invalid header.");
+  }
+  const Geometry geometry{ header->width, header->height, planes, planes };
+  const size_t stripes = header->stripes;
+  // Every pixel takes at least one bit, which bounds the size of corrupt headers.
+  const uint64_t pixels = static_cast<uint64_t>(header->width) * header->height;
+  if (stripes == 0 || stripes > std::max<size_t>(1, geometry.planeRows()) || pixels > 8 * static_cast<uint64_t>(size))
+  {
+    throw std::runtime_error("[RawCodec::decode] Invalid header.");
+  }
+
+  const uint8_t* sizes = data + sizeof(RawCodecHeader);
+  const uint8_t* stripe_data = sizes + stripes * sizeof(uint32_t);
+  const uint8_t* end = data + size;
+  if (stripe_data > end)
+  {
+    throw std::runtime_error("[RawCodec::decode] Truncated frame.");
+  }
+  image->assign(static_cast<size_t>(pixels) * (bit_depth / 8), 0);
+  const unsigned int raw_bits = bit_depth - header->shift + 1;
+  for (size_t stripe = 0; stripe < stripes; ++stripe)
+  {
+    uint32_t stripe_size;
+    std::memcpy(&stripe_size, sizes + stripe * sizeof(uint32_t), sizeof(stripe_size));
+    if (stripe_size > static_cast<size_t>(end - stripe_data))
+    {
+      throw std::runtime_error("[RawCodec::decode] Truncated frame.");
+    }
+    const size_t begin = geometry.stripeBegin(stripe, stripes);
+    const size_t stripe_end = geometry.stripeBegin(stripe + 1, stripes);
+    if (bit_depth == 8)
+    {
+      decodeStripe<uint8_t>(stripe_data, stripe_size, geometry, header->shift, raw_bits, begin, stripe_end,
+                            image->data());
+    }
+    else
+    {
+      decodeStripe<uint16_t>(stripe_data, stripe_size, geometry, header->shift, raw_bits, begin, stripe_end,
+                             image->data());
+    }
+    stripe_data += stripe_size;
+  }
+}
+
+void RawCodec::runStripes(const std::function<void(size_t)>& job)
+{
+  if (workers_.empty())
+  {
+    job(0);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    pending_ = workers_.size();
+    ++generation_;
+  }
+  job_cv_.notify_all();
+  job(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return pending_ == 0; });
+  job_ = nullptr;
+}
+
+void RawCodec::workerLoop(size_t stripe)
+{
+  uint64_t seen_generation = 0;
+  while (true)
+  {
+    const std::function<void(size_t)>* job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+      if (stop_)
+      {
+        return;
+      }
+      seen_generation = generation_;
+      job = job_;
+    }
+    (*job)(stripe);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0)
+      {
+        done_cv_.notify_one();
+      }
+    }
+  }
+}
+}  // namespace any_spinnaker_camera_driver
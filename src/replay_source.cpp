@@ -0,0 +1,173 @@
+/**
+Software License Agreement (BSD)
+
+\file      replay_source.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/replay_source.h"
+#include "any_spinnaker_camera_driver/frame_recorder.h"
+#include "any_spinnaker_camera_driver/raw_codec.h"
+
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <wfov_camera_msgs/WFOVImage.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+bool endsWith(const std::string& value, const std::string& suffix)
+{
+  return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/** Replays a file written by the flight recorder. */
+class RecordingReplaySource : public ReplaySource
+{
+public:
+  explicit RecordingReplaySource(const std::string& path) : reader_(path)
+  {
+  }
+
+  bool next(sensor_msgs::Image* image) override
+  {
+    FrameRecordMetadata metadata;
+    const uint8_t* data = nullptr;
+    // Skip records that are corrupt, e.g. because the recorder was killed while writing them.
+    while (position_ < reader_.size())
+    {
+      if (reader_.getFrame(position_++, &metadata, &data))
+      {
+        image->header.stamp.fromNSec(metadata.stamp_ns);
+        image->height = metadata.height;
+        image->width = metadata.width;
+        image->step = metadata.step;
+        image->encoding = metadata.encoding;
+        image->is_bigendian = 0;
+        if (metadata.flags & FRAME_RECORD_FLAG_RAW_CODEC)
+        {
+          RawCodecHeader header;
+          try
+          {
+            RawCodec::decode(data, metadata.data_size, &header, &image->data);
+          }
+          catch (const std::runtime_error&)
+          {
+            continue;
+          }
+          image->step = static_cast<uint32_t>(image->height > 0 ? image->data.size() / image->height : 0);
+          return true;
+        }
+        image->data.assign(data, data + metadata.data_size);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void rewind() override
+  {
+    position_ = 0;
+  }
+
+private:
+  FrameRecordReader reader_;
+  size_t position_{ 0 };
+};
+
+/** Replays sensor_msgs/Image or wfov_camera_msgs/WFOVImage messages from a rosbag. */
+class BagReplaySource : public ReplaySource
+{
+public:
+  BagReplaySource(const std::string& path, const std::string& topic) : topic_(topic)
+  {
+    try
+    {
+      bag_.open(path, rosbag::bagmode::Read);
+    }
+    catch (const rosbag::BagException& e)
+    {
+      throw std::runtime_error("[BagReplaySource] Unable to open '" + path + "': " + std::string(e.what()));
+    }
+
+    const std::string suffix = "/" + topic_;
+    view_.reset(new rosbag::View(bag_, [this, suffix](const rosbag::ConnectionInfo* connection) {
+      const bool topic_matches = connection->topic == topic_ || endsWith(connection->topic, suffix);
+      return topic_matches &&
+             (connection->datatype == "sensor_msgs/Image" || connection->datatype == "wfov_camera_msgs/WFOVImage");
+    }));
+    if (view_->size() == 0)
+    {
+      throw std::runtime_error("[BagReplaySource] No images on topic '" + topic_ + "' in '" + path + "'.");
+    }
+    rewind();
+  }
+
+  bool next(sensor_msgs::Image* image) override
+  {
+    while (it_ != view_->end())
+    {
+      const rosbag::MessageInstance& message = *it_++;
+      sensor_msgs::ImageConstPtr recorded = message.instantiate<sensor_msgs::Image>();
+      if (!recorded)
+      {
+        wfov_camera_msgs::WFOVImageConstPtr wfov_image = message.instantiate<wfov_camera_msgs::WFOVImage>();
+        if (wfov_image)
+          recorded = boost::make_shared<sensor_msgs::Image>(wfov_image->image);
+      }
+      if (recorded)
+      {
+        *image = *recorded;
+        // Fall back to the time the message was recorded if the image was not stamped.
+        if (image->header.stamp.isZero())
+          image->header.stamp = message.getTime();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void rewind() override
+  {
+    it_ = view_->begin();
+  }
+
+private:
+  std::string topic_;
+  rosbag::Bag bag_;
+  std::unique_ptr<rosbag::View> view_;
+  rosbag::View::iterator it_;
+};
+}  // namespace
+
+std::unique_ptr<ReplaySource> ReplaySource::create(const std::string& path, const std::string& topic)
+{
+  if (endsWith(path, ".bag"))
+  {
+    return std::unique_ptr<ReplaySource>(new BagReplaySource(path, topic));
+  }
+  return std::unique_ptr<ReplaySource>(new RecordingReplaySource(path));
+}
+}  // namespace any_spinnaker_camera_driver
@@ -0,0 +1,331 @@
+/**
+Software License Agreement (BSD)
+
+\file      shared_frame_ring.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/shared_frame_ring.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+const char SHARED_FRAME_RING_MAGIC[8] = { 'S', 'P', 'N', 'K', 'S', 'H', 'M', '\0' };
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "Atomics in shared memory have to be lock free");
+
+uint32_t holderPid(uint64_t holder)
+{
+  return static_cast<uint32_t>(holder >> 32);
+}
+
+uint32_t holderCount(uint64_t holder)
+{
+  return static_cast<uint32_t>(holder);
+}
+
+bool isAlive(uint32_t pid)
+{
+  return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+}
+
+/*!
+ * \brief Adds a reference of this process to a slot.
+ *
+ * Sequentially consistent, so that either the consumer sees the writing flag or the producer sees the reference.
+ * \return False if all holder entries are used by other processes.
+ */
+bool addHolder(SharedFrameSlot& slot, uint32_t pid)
+{
+  // Joins the entry of this process, or claims a free one.
+  for (std::atomic<uint64_t>& holder : slot.holders)
+  {
+    uint64_t value = holder.load();
+    while (holderPid(value) == pid)
+    {
+      if (holder.compare_exchange_weak(value, value + 1))
+        return true;
+    }
+  }
+  for (std::atomic<uint64_t>& holder : slot.holders)
+  {
+    uint64_t value = 0;
+    if (holder.compare_exchange_strong(value, (static_cast<uint64_t>(pid) << 32) | 1))
+      return true;
+  }
+  return false;
+}
+
+/// Removes a reference of this process from a slot, frees its entry with the last one.
+void removeHolder(SharedFrameSlot& slot, uint32_t pid)
+{
+  for (std::atomic<uint64_t>& holder : slot.holders)
+  {
+    uint64_t value = holder.load();
+    while (holderPid(value) == pid)
+    {
+      if (holder.compare_exchange_weak(value, holderCount(value) == 1 ? 0 : value - 1))
+        return;
+    }
+  }
+}
+
+size_t alignUp(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t pageSize()
+{
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+/// POSIX shared memory names need a leading slash.
+std::string shmName(const std::string& name)
+{
+  return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+}  // namespace
+
+SharedFrameRing::SharedFrameRing(const std::string& name, uint32_t slot_count, size_t slot_size) : name_(name)
+{
+  if (slot_count == 0 || slot_size == 0)
+  {
+    throw std::runtime_error("[SharedFrameRing] Ring '" + name_ + "' needs at least one slot of non-zero size.");
+  }
+
+  const size_t slot_table_offset = alignUp(sizeof(SharedFrameRingHeader), alignof(SharedFrameSlot));
+  const size_t data_offset = alignUp(slot_table_offset + slot_count * sizeof(SharedFrameSlot), pageSize());
+  const size_t slot_stride = alignUp(slot_size, pageSize());
+  map_size_ = data_offset + slot_count * slot_stride;
+
+  // Consumers of a previous producer keep their (now orphaned) mapping until they see the new ring id.
+  shm_unlink(shmName(name_).c_str());
+  const int fd = shm_open(shmName(name_).c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+  if (fd < 0)
+  {
+    throw std::runtime_error("[SharedFrameRing] Unable to create shared memory '" + name_ +
+                             "': " + std::string(std::strerror(errno)));
+  }
+  if (ftruncate(fd, static_cast<off_t>(map_size_)) != 0)
+  {
+    close(fd);
+    shm_unlink(shmName(name_).c_str());
+    throw std::runtime_error("[SharedFrameRing] Unable to size shared memory '" + name_ +
+                             "': " + std::string(std::strerror(errno)));
+  }
+  void* map = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+  {
+    shm_unlink(shmName(name_).c_str());
+    throw std::runtime_error("[SharedFrameRing] Unable to map shared memory '" + name_ +
+                             "': " + std::string(std::strerror(errno)));
+  }
+  map_ = static_cast<uint8_t*>(map);
+
+  header_ = reinterpret_cast<SharedFrameRingHeader*>(map_);
+  slots_ = reinterpret_cast<SharedFrameSlot*>(map_ + slot_table_offset);
+  data_ = map_ + data_offset;
+
+  header_->version = VERSION;
+  header_->slot_count = slot_count;
+  header_->ring_id = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^
+                     (static_cast<uint64_t>(getpid()) << 48);
+  header_->slot_size = slot_stride;
+  header_->slot_table_offset = slot_table_offset;
+  header_->data_offset = data_offset;
+  for (uint32_t i = 0; i < slot_count; ++i)
+  {
+    new (&slots_[i]) SharedFrameSlot();
+    slots_[i].writing.store(0);
+    slots_[i].size = 0;
+    slots_[i].sequence.store(0);
+    for (std::atomic<uint64_t>& holder : slots_[i].holders)
+      holder.store(0);
+  }
+  // Publishing the magic last makes the ring visible to consumers only once it is initialized.
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header_->magic, SHARED_FRAME_RING_MAGIC, sizeof(SHARED_FRAME_RING_MAGIC));
+}
+
+SharedFrameRing::~SharedFrameRing()
+{
+  munmap(map_, map_size_);
+  shm_unlink(shmName(name_).c_str());
+}
+
+bool SharedFrameRing::write(const uint8_t* data, size_t size, uint32_t* slot, uint64_t* sequence)
+{
+  const uint32_t slot_count = header_->slot_count;
+  if (size > header_->slot_size)
+  {
+    dropped_frames_++;
+    return false;
+  }
+
+  // Round robin keeps the time until a slot is reused, and therefore the time consumers have to pick up a descriptor,
+  // as long as possible.
+  for (uint32_t i = 0; i < slot_count; ++i)
+  {
+    const uint32_t candidate = (next_slot_ + i) % slot_count;
+    SharedFrameSlot& shared_slot = slots_[candidate];
+    // Consumers add their reference before they check the flag, the producer sets the flag before it checks the
+    // references. One of both sees the other.
+    shared_slot.writing.store(1);
+    if (isHeld(shared_slot))
+    {
+      shared_slot.writing.store(0, std::memory_order_release);
+      continue;
+    }
+
+    std::memcpy(data_ + candidate * header_->slot_size, data, size);
+    shared_slot.size = static_cast<uint32_t>(size);
+    shared_slot.sequence.store(++sequence_, std::memory_order_relaxed);
+    shared_slot.writing.store(0, std::memory_order_release);
+
+    next_slot_ = (candidate + 1) % slot_count;
+    *slot = candidate;
+    *sequence = sequence_;
+    return true;
+  }
+
+  dropped_frames_++;
+  return false;
+}
+
+bool SharedFrameRing::isHeld(SharedFrameSlot& slot)
+{
+  bool held = false;
+  for (std::atomic<uint64_t>& holder : slot.holders)
+  {
+    uint64_t value = holder.load();
+    if (value == 0)
+      continue;
+    if (isAlive(holderPid(value)))
+    {
+      held = true;
+      continue;
+    }
+    // A dead process cannot change its entry anymore, only a living one reusing its pid could.
+    if (holder.compare_exchange_strong(value, 0))
+      reclaimed_references_ += holderCount(value);
+    else
+      held = true;
+  }
+  return held;
+}
+
+struct SharedFrameRingClient::Mapping
+{
+  std::string name;
+  uint8_t* map{ nullptr };
+  size_t map_size{ 0 };
+  const SharedFrameRingHeader* header{ nullptr };
+  SharedFrameSlot* slots{ nullptr };
+
+  ~Mapping()
+  {
+    if (map != nullptr)
+      munmap(map, map_size);
+  }
+};
+
+SharedFrameRingClient::SharedFrameRingClient() = default;
+
+SharedFrameRingClient::~SharedFrameRingClient() = default;
+
+std::shared_ptr<const SharedFrame> SharedFrameRingClient::acquire(const std::string& name, uint64_t ring_id,
+                                                                  uint32_t slot, uint64_t sequence)
+{
+  if (!mapping_ || mapping_->name != name || mapping_->header->ring_id != ring_id)
+  {
+    // Frames still held from an old mapping keep it alive through their deleters.
+    mapping_.reset();
+
+    const int fd = shm_open(shmName(name).c_str(), O_RDWR, 0);
+    if (fd < 0)
+      return nullptr;
+    struct stat shm_stat;
+    if (fstat(fd, &shm_stat) != 0 || static_cast<size_t>(shm_stat.st_size) < sizeof(SharedFrameRingHeader))
+    {
+      close(fd);
+      return nullptr;
+    }
+    auto mapping = std::make_shared<Mapping>();
+    mapping->name = name;
+    mapping->map_size = static_cast<size_t>(shm_stat.st_size);
+    void* map = mmap(nullptr, mapping->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+      return nullptr;
+    mapping->map = static_cast<uint8_t*>(map);
+    mapping->header = reinterpret_cast<const SharedFrameRingHeader*>(mapping->map);
+
+    const SharedFrameRingHeader& header = *mapping->header;
+    if (std::memcmp(header.magic, SHARED_FRAME_RING_MAGIC, sizeof(SHARED_FRAME_RING_MAGIC)) != 0 ||
+        header.version != SharedFrameRing::VERSION || header.ring_id != ring_id ||
+        header.data_offset + header.slot_count * header.slot_size > mapping->map_size)
+    {
+      return nullptr;
+    }
+    mapping->slots = reinterpret_cast<SharedFrameSlot*>(mapping->map + header.slot_table_offset);
+    mapping_ = mapping;
+  }
+
+  if (slot >= mapping_->header->slot_count)
+    return nullptr;
+
+  // Owning the references by pid lets the producer reclaim them if this process dies while holding the slot.
+  const uint32_t pid = static_cast<uint32_t>(getpid());
+  SharedFrameSlot& shared_slot = mapping_->slots[slot];
+  if (!addHolder(shared_slot, pid))
+    return nullptr;
+  // Rejects frames that the producer is overwriting or has overwritten already.
+  if (shared_slot.writing.load() != 0 || shared_slot.sequence.load(std::memory_order_acquire) != sequence)
+  {
+    removeHolder(shared_slot, pid);
+    return nullptr;
+  }
+
+  SharedFrame* frame = new SharedFrame{ mapping_->map + mapping_->header->data_offset + slot * mapping_->header->slot_size,
+                                        shared_slot.size };
+  std::shared_ptr<Mapping> mapping = mapping_;
+  return std::shared_ptr<const SharedFrame>(frame, [mapping, slot, pid](const SharedFrame* released) {
+    removeHolder(mapping->slots[slot], pid);
+    delete released;
+  });
+}
+}  // namespace any_spinnaker_camera_driver
@@ -0,0 +1,377 @@
+/**
+Software License Agreement (BSD)
+
+\file      software_binning.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/software_binning.h"
+
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+// The row kernels are built for AVX2 and the baseline, the dynamic loader picks the variant supported by the CPU.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define SOFTWARE_BINNING_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define SOFTWARE_BINNING_KERNEL
+#endif
+
+#if defined(__GNUC__)
+#define SOFTWARE_BINNING_INLINE inline __attribute__((always_inline))
+#else
+#define SOFTWARE_BINNING_INLINE inline
+#endif
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+/** Parses the encoding, returns false if it is not supported. planes is 2 for Bayer and 1 for mono frames. */
+bool parseGeometry(const std::string& encoding, unsigned int* bit_depth, size_t* planes)
+{
+  BayerDemosaicer::Pattern pattern;
+  if (BayerDemosaicer::parseEncoding(encoding, &pattern, bit_depth))
+  {
+    *planes = 2;
+    return true;
+  }
+  *planes = 1;
+  if (encoding == "mono8")
+  {
+    *bit_depth = 8;
+    return true;
+  }
+  if (encoding == "mono16")
+  {
+    *bit_depth = 16;
+    return true;
+  }
+  return false;
+}
+
+template <typename T>
+SOFTWARE_BINNING_INLINE void loadRowImpl(const T* __restrict src, uint32_t* __restrict accumulator, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    accumulator[i] = src[i];
+  }
+}
+
+template <typename T>
+SOFTWARE_BINNING_INLINE void addRowImpl(const T* __restrict src, uint32_t* __restrict accumulator, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    accumulator[i] += src[i];
+  }
+}
+
+SOFTWARE_BINNING_KERNEL void loadRow8(const uint8_t* src, uint32_t* accumulator, size_t size)
+{
+  loadRowImpl(src, accumulator, size);
+}
+
+SOFTWARE_BINNING_KERNEL void loadRow16(const uint16_t* src, uint32_t* accumulator, size_t size)
+{
+  loadRowImpl(src, accumulator, size);
+}
+
+SOFTWARE_BINNING_KERNEL void addRow8(const uint8_t* src, uint32_t* accumulator, size_t size)
+{
+  addRowImpl(src, accumulator, size);
+}
+
+SOFTWARE_BINNING_KERNEL void addRow16(const uint16_t* src, uint32_t* accumulator, size_t size)
+{
+  addRowImpl(src, accumulator, size);
+}
+
+SOFTWARE_BINNING_INLINE void accumulateRow(const uint8_t* src, uint32_t* accumulator, size_t size, bool first)
+{
+  first ? loadRow8(src, accumulator, size) : addRow8(src, accumulator, size);
+}
+
+SOFTWARE_BINNING_INLINE void accumulateRow(const uint16_t* src, uint32_t* accumulator, size_t size, bool first)
+{
+  first ? loadRow16(src, accumulator, size) : addRow16(src, accumulator, size);
+}
+
+/** Sum of the binned pixels, saturated. */
+struct Saturate
+{
+  uint32_t max;
+  SOFTWARE_BINNING_INLINE uint32_t operator()(uint32_t sum) const
+  {
+    return std::min(sum, max);
+  }
+};
+
+/** Rounded average of a power of two of binned pixels. */
+struct Shift
+{
+  uint32_t round;
+  unsigned int shift;
+  SOFTWARE_BINNING_INLINE uint32_t operator()(uint32_t sum) const
+  {
+    return (sum + round) >> shift;
+  }
+};
+
+/** Rounded average of any number of binned pixels. */
+struct Divide
+{
+  uint32_t round;
+  uint32_t divisor;
+  SOFTWARE_BINNING_INLINE uint32_t operator()(uint32_t sum) const
+  {
+    return (sum + round) / divisor;
+  }
+};
+
+/**
+ * Sums binning_x cells of the accumulated rows every stride cells and writes the combined values of the cells.
+ * A cell has one pixel per plane.
+ */
+template <typename T, size_t PLANES, typename Combine>
+SOFTWARE_BINNING_INLINE void reduceRow(const uint32_t* __restrict accumulator, size_t cells, size_t stride,
+                                       unsigned int binning_x, Combine combine, T* __restrict dst)
+{
+  if (binning_x == 2 && stride == 2)
+  {
+    // Plain 2 x binning, written with constant strides so it is vectorized as well.
+    for (size_t x = 0; x < cells * PLANES; x += PLANES)
+    {
+      for (size_t plane = 0; plane < PLANES; ++plane)
+      {
+        dst[x + plane] = static_cast<T>(combine(accumulator[2 * x + plane] + accumulator[2 * x + PLANES + plane]));
+      }
+    }
+    return;
+  }
+  for (size_t x = 0; x < cells; ++x)
+  {
+    const uint32_t* block = accumulator + x * stride * PLANES;
+    for (size_t plane = 0; plane < PLANES; ++plane)
+    {
+      uint32_t sum = 0;
+      for (unsigned int i = 0; i < binning_x; ++i)
+      {
+        sum += block[i * PLANES + plane];
+      }
+      dst[x * PLANES + plane] = static_cast<T>(combine(sum));
+    }
+  }
+}
+
+template <typename T, size_t PLANES>
+SOFTWARE_BINNING_INLINE void reduceRowImpl(const uint32_t* accumulator, size_t cells, size_t stride,
+                                           unsigned int binning_x, SoftwareBinning::Mode mode, unsigned int binned,
+                                           uint32_t max, T* dst)
+{
+  if (mode == SoftwareBinning::Mode::SUM)
+  {
+    reduceRow<T, PLANES>(accumulator, cells, stride, binning_x, Saturate{ max }, dst);
+  }
+  else if ((binned & (binned - 1)) == 0)
+  {
+    unsigned int shift = 0;
+    while ((1u << shift) < binned)
+    {
+      ++shift;
+    }
+    reduceRow<T, PLANES>(accumulator, cells, stride, binning_x, Shift{ binned / 2, shift }, dst);
+  }
+  else
+  {
+    reduceRow<T, PLANES>(accumulator, cells, stride, binning_x, Divide{ binned / 2, binned }, dst);
+  }
+}
+
+SOFTWARE_BINNING_KERNEL void reduceRowMono8(const uint32_t* accumulator, size_t cells, size_t stride,
+                                            unsigned int binning_x, SoftwareBinning::Mode mode, unsigned int binned,
+                                            uint32_t max, uint8_t* dst)
+{
+  reduceRowImpl<uint8_t, 1>(accumulator, cells, stride, binning_x, mode, binned, max, dst);
+}
+
+SOFTWARE_BINNING_KERNEL void reduceRowMono16(const uint32_t* accumulator, size_t cells, size_t stride,
+                                             unsigned int binning_x, SoftwareBinning::Mode mode, unsigned int binned,
+                                             uint32_t max, uint16_t* dst)
+{
+  reduceRowImpl<uint16_t, 1>(accumulator, cells, stride, binning_x, mode, binned, max, dst);
+}
+
+SOFTWARE_BINNING_KERNEL void reduceRowBayer8(const uint32_t* accumulator, size_t cells, size_t stride,
+                                             unsigned int binning_x, SoftwareBinning::Mode mode, unsigned int binned,
+                                             uint32_t max, uint8_t* dst)
+{
+  reduceRowImpl<uint8_t, 2>(accumulator, cells, stride, binning_x, mode, binned, max, dst);
+}
+
+SOFTWARE_BINNING_KERNEL void reduceRowBayer16(const uint32_t* accumulator, size_t cells, size_t stride,
+                                              unsigned int binning_x, SoftwareBinning::Mode mode, unsigned int binned,
+                                              uint32_t max, uint16_t* dst)
+{
+  reduceRowImpl<uint16_t, 2>(accumulator, cells, stride, binning_x, mode, binned, max, dst);
+}
+
+SOFTWARE_BINNING_INLINE void reduceRow(const uint32_t* accumulator, size_t planes, size_t cells, size_t stride,
+                                       unsigned int binning_x, SoftwareBinning::Mode mode, unsigned int binned,
+                                       uint32_t max, uint8_t* dst)
+{
+  planes == 2 ? reduceRowBayer8(accumulator, cells, stride, binning_x, mode, binned, max, dst) :
+                reduceRowMono8(accumulator, cells, stride, binning_x, mode, binned, max, dst);
+}
+
+SOFTWARE_BINNING_INLINE void reduceRow(const uint32_t* accumulator, size_t planes, size_t cells, size_t stride,
+                                       unsigned int binning_x, SoftwareBinning::Mode mode, unsigned int binned,
+                                       uint32_t max, uint16_t* dst)
+{
+  planes == 2 ? reduceRowBayer16(accumulator, cells, stride, binning_x, mode, binned, max, dst) :
+                reduceRowMono16(accumulator, cells, stride, binning_x, mode, binned, max, dst);
+}
+
+template <typename T>
+void processImpl(const uint8_t* src, size_t src_step, size_t planes, size_t output_width, size_t output_height,
+                 unsigned int binning_x, unsigned int binning_y, unsigned int factor_x, unsigned int factor_y,
+                 SoftwareBinning::Mode mode, unsigned int bit_depth, std::vector<uint32_t>* accumulator, uint8_t* dst,
+                 size_t dst_step)
+{
+  const size_t cells_x = output_width / planes;
+  const size_t cells_y = output_height / planes;
+  if (cells_x == 0 || cells_y == 0)
+  {
+    return;
+  }
+  // Only the columns up to the last binned block are accumulated.
+  const size_t used_width = ((cells_x - 1) * factor_x + binning_x) * planes;
+  accumulator->resize(used_width);
+  const unsigned int binned = binning_x * binning_y;
+  const uint32_t max = (1u << bit_depth) - 1;
+
+  for (size_t y = 0; y < cells_y; ++y)
+  {
+    for (size_t plane = 0; plane < planes; ++plane)
+    {
+      for (unsigned int i = 0; i < binning_y; ++i)
+      {
+        const size_t row = ((y * factor_y + i) * planes + plane);
+        accumulateRow(reinterpret_cast<const T*>(src + row * src_step), accumulator->data(), used_width, i == 0);
+      }
+      reduceRow(accumulator->data(), planes, cells_x, factor_x, binning_x, mode, binned, max,
+                reinterpret_cast<T*>(dst + (y * planes + plane) * dst_step));
+    }
+  }
+}
+}  // namespace
+
+SoftwareBinning::SoftwareBinning(unsigned int binning_x, unsigned int binning_y, unsigned int decimation_x,
+                                 unsigned int decimation_y, Mode mode)
+  : binning_x_(binning_x)
+  , binning_y_(binning_y)
+  , decimation_x_(decimation_x)
+  , decimation_y_(decimation_y)
+  , mode_(mode)
+{
+  if (binning_x_ == 0 || binning_y_ == 0 || decimation_x_ == 0 || decimation_y_ == 0)
+  {
+    throw std::runtime_error("[SoftwareBinning] The binning and decimation factors have to be at least 1.");
+  }
+  // The sums of 16-bit pixels have to fit the 32-bit accumulators.
+  if (static_cast<uint64_t>(binning_x_) * binning_y_ > (1u << 16))
+  {
+    throw std::runtime_error("[SoftwareBinning] Too many binned pixels.");
+  }
+}
+
+bool SoftwareBinning::parseMode(const std::string& name, Mode* mode)
+{
+  if (name == "sum")
+  {
+    *mode = Mode::SUM;
+    return true;
+  }
+  if (name == "average")
+  {
+    *mode = Mode::AVERAGE;
+    return true;
+  }
+  return false;
+}
+
+bool SoftwareBinning::isSupported(const std::string& encoding)
+{
+  unsigned int bit_depth;
+  size_t planes;
+  return parseGeometry(encoding, &bit_depth, &planes);
+}
+
+bool SoftwareBinning::isIdentity() const
+{
+  return getFactorX() == 1 && getFactorY() == 1;
+}
+
+void SoftwareBinning::getOutputSize(size_t width, size_t height, const std::string& encoding, size_t* output_width,
+                                    size_t* output_height) const
+{
+  unsigned int bit_depth;
+  size_t planes;
+  if (!parseGeometry(encoding, &bit_depth, &planes))
+  {
+    throw std::runtime_error("[SoftwareBinning::getOutputSize] Unsupported encoding " + encoding);
+  }
+  // The cells skipped by the decimation only have to exist behind all but the last block.
+  const size_t cells_x = width / planes;
+  const size_t cells_y = height / planes;
+  *output_width = cells_x < binning_x_ ? 0 : ((cells_x - binning_x_) / getFactorX() + 1) * planes;
+  *output_height = cells_y < binning_y_ ? 0 : ((cells_y - binning_y_) / getFactorY() + 1) * planes;
+}
+
+void SoftwareBinning::process(const void* src, size_t width, size_t height, size_t src_step,
+                              const std::string& encoding, void* dst, size_t dst_step)
+{
+  unsigned int bit_depth;
+  size_t planes;
+  if (!parseGeometry(encoding, &bit_depth, &planes))
+  {
+    throw std::runtime_error("[SoftwareBinning::process] Unsupported encoding " + encoding);
+  }
+  size_t output_width;
+  size_t output_height;
+  getOutputSize(width, height, encoding, &output_width, &output_height);
+  if (bit_depth == 8)
+  {
+    processImpl<uint8_t>(static_cast<const uint8_t*>(src), src_step, planes, output_width, output_height, binning_x_,
+                         binning_y_, getFactorX(), getFactorY(), mode_, bit_depth, &accumulator_,
+                         static_cast<uint8_t*>(dst), dst_step);
+  }
+  else
+  {
+    processImpl<uint16_t>(static_cast<const uint8_t*>(src), src_step, planes, output_width, output_height, binning_x_,
+                          binning_y_, getFactorX(), getFactorY(), mode_, bit_depth, &accumulator_,
+                          static_cast<uint8_t*>(dst), dst_step);
+  }
+}
+}  // namespace any_spinnaker_camera_driver
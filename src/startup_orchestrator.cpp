@@ -0,0 +1,187 @@
+/**
+Software License Agreement (BSD)
+
+\file      startup_orchestrator.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "any_spinnaker_camera_driver/startup_orchestrator.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace any_spinnaker_camera_driver
+{
+std::shared_ptr<StartupOrchestrator> StartupOrchestrator::instance()
+{
+  static std::mutex instance_mutex;
+  static std::weak_ptr<StartupOrchestrator> instance;
+
+  std::lock_guard<std::mutex> lock(instance_mutex);
+  std::shared_ptr<StartupOrchestrator> orchestrator = instance.lock();
+  if (!orchestrator)
+  {
+    orchestrator.reset(new StartupOrchestrator());
+    instance = orchestrator;
+  }
+  return orchestrator;
+}
+
+void StartupOrchestrator::setMaxParallel(unsigned int slots)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slots > 0 && (max_parallel_ == 0 || slots < max_parallel_))
+    {
+      max_parallel_ = slots;
+    }
+  }
+  slot_cv_.notify_all();
+}
+
+void StartupOrchestrator::registerCamera(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!has_origin_)
+  {
+    origin_ = Clock::now();
+    has_origin_ = true;
+  }
+  if (cameras_.emplace(name, CameraTiming()).second)
+  {
+    // A camera registering late extends the rig.
+    total_ms_ = 0.0;
+  }
+}
+
+void StartupOrchestrator::unregisterCamera(const std::string& name)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cameras_.erase(name);
+  }
+  slot_cv_.notify_all();
+}
+
+bool StartupOrchestrator::run(const std::string& name, const std::function<void()>& bring_up)
+{
+  const Clock::time_point requested = Clock::now();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Unregistering the camera, e.g. when its driver shuts down, ends the wait.
+    slot_cv_.wait(lock, [this, &name]() {
+      return cameras_.count(name) == 0 || max_parallel_ == 0 || running_ < max_parallel_;
+    });
+    const auto camera = cameras_.find(name);
+    if (camera == cameras_.end())
+    {
+      throw std::runtime_error("[StartupOrchestrator::run] Camera '" + name + "' is not registered.");
+    }
+    ++running_;
+    ++camera->second.attempts;
+  }
+  const Clock::time_point started = Clock::now();
+
+  try
+  {
+    bring_up();
+  }
+  catch (...)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_;
+    }
+    slot_cv_.notify_one();
+    throw;
+  }
+
+  const Clock::time_point finished = Clock::now();
+  bool completed_rig = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --running_;
+    const auto camera = cameras_.find(name);
+    if (camera != cameras_.end() && !camera->second.ready)
+    {
+      CameraTiming& timing = camera->second;
+      timing.ready = true;
+      timing.wait_ms = std::chrono::duration<double, std::milli>(started - requested).count();
+      timing.bring_up_ms = std::chrono::duration<double, std::milli>(finished - started).count();
+      timing.ready_ms = has_origin_ ? sinceOrigin(finished) : timing.bring_up_ms;
+      if (total_ms_ == 0.0 && isComplete())
+      {
+        total_ms_ = std::max(timing.ready_ms, 1e-3);
+        completed_rig = true;
+      }
+    }
+  }
+  slot_cv_.notify_one();
+  return completed_rig;
+}
+
+StartupOrchestrator::CameraTiming StartupOrchestrator::getTiming(const std::string& name) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto camera = cameras_.find(name);
+  return camera != cameras_.end() ? camera->second : CameraTiming();
+}
+
+double StartupOrchestrator::getTotalMs() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return total_ms_;
+}
+
+std::string StartupOrchestrator::toString() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string summary;
+  char buffer[256];
+  for (const auto& camera : cameras_)
+  {
+    if (camera.second.ready)
+      std::snprintf(buffer, sizeof(buffer), "%s %.1f ms (waited %.1f ms)", camera.first.c_str(),
+                    camera.second.bring_up_ms, camera.second.wait_ms);
+    else
+      std::snprintf(buffer, sizeof(buffer), "%s pending", camera.first.c_str());
+    summary += (summary.empty() ? "" : ", ") + std::string(buffer);
+  }
+  if (total_ms_ > 0.0)
+  {
+    std::snprintf(buffer, sizeof(buffer), "total %.1f ms", total_ms_);
+    summary += (summary.empty() ? "" : ", ") + std::string(buffer);
+  }
+  return summary;
+}
+
+bool StartupOrchestrator::isComplete() const
+{
+  return std::all_of(cameras_.begin(), cameras_.end(),
+                     [](const std::pair<const std::string, CameraTiming>& camera) { return camera.second.ready; });
+}
+
+double StartupOrchestrator::sinceOrigin(Clock::time_point time) const
+{
+  return std::chrono::duration<double, std::milli>(time - origin_).count();
+}
+}  // namespace any_spinnaker_camera_driver
@@ -0,0 +1,110 @@
+/**
+Software License Agreement (BSD)
+
+\file      startup_profiler.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/startup_profiler.h"
+
+#include <cstdio>
+
+namespace any_spinnaker_camera_driver
+{
+StartupProfiler::StartupProfiler() : origin_(Clock::now())
+{
+}
+
+void StartupProfiler::begin(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (finished_)
+    return;
+  const Clock::time_point now = Clock::now();
+  phases_.push_back(Phase{ name, sinceOrigin(now), 0.0 });
+  phase_starts_.push_back(now);
+}
+
+void StartupProfiler::end(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (finished_)
+    return;
+  const Clock::time_point now = Clock::now();
+  for (size_t i = phases_.size(); i-- > 0;)
+  {
+    if (phases_[i].name == name)
+    {
+      phases_[i].duration_ms = std::chrono::duration<double, std::milli>(now - phase_starts_[i]).count();
+      return;
+    }
+  }
+}
+
+void StartupProfiler::finish(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (finished_)
+    return;
+  finish_time_ = Clock::now();
+  phases_.push_back(Phase{ name, sinceOrigin(finish_time_), 0.0 });
+  phase_starts_.push_back(finish_time_);
+  finished_ = true;
+}
+
+bool StartupProfiler::isFinished() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return finished_;
+}
+
+std::vector<StartupProfiler::Phase> StartupProfiler::getPhases() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return phases_;
+}
+
+double StartupProfiler::getTotalMs() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sinceOrigin(finished_ ? finish_time_ : Clock::now());
+}
+
+std::string StartupProfiler::toString() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string summary;
+  char buffer[128];
+  for (const Phase& phase : phases_)
+  {
+    if (phase.duration_ms > 0.0)
+      std::snprintf(buffer, sizeof(buffer), "%s %.1f ms @ %.1f", phase.name.c_str(), phase.duration_ms, phase.start_ms);
+    else
+      std::snprintf(buffer, sizeof(buffer), "%s @ %.1f", phase.name.c_str(), phase.start_ms);
+    summary += (summary.empty() ? "" : ", ") + std::string(buffer);
+  }
+  return summary;
+}
+
+double StartupProfiler::sinceOrigin(Clock::time_point time) const
+{
+  return std::chrono::duration<double, std::milli>(time - origin_).count();
+}
+}  // namespace any_spinnaker_camera_driver
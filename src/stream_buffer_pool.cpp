@@ -0,0 +1,118 @@
+/**
+Software License Agreement (BSD)
+
+\file      stream_buffer_pool.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/stream_buffer_pool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+/// Size of the huge pages the mappings are rounded to, the default size on x86-64 and aarch64.
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+size_t alignUp(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+StreamBufferPool::StreamBufferPool(bool huge_pages, bool lock) : huge_pages_(huge_pages), lock_(lock)
+{
+}
+
+StreamBufferPool::~StreamBufferPool()
+{
+  release();
+}
+
+void StreamBufferPool::reserve(size_t buffer_count, size_t payload_size)
+{
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t buffer_size = alignUp(payload_size, page_size);
+  if (memory_ != nullptr && buffer_count * buffer_size <= mapped_size_)
+  {
+    buffer_count_ = buffer_count;
+    buffer_size_ = buffer_size;
+    return;
+  }
+
+  release();
+  const size_t size = buffer_count * buffer_size;
+  void* memory = MAP_FAILED;
+  bool huge_page_backed = false;
+  size_t mapped_size = size;
+#ifdef MAP_HUGETLB
+  if (huge_pages_)
+  {
+    mapped_size = alignUp(size, HUGE_PAGE_SIZE);
+    memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    huge_page_backed = memory != MAP_FAILED;
+  }
+#endif
+  if (memory == MAP_FAILED)
+  {
+    // No (or not enough) huge pages reserved in the system.
+    mapped_size = size;
+    memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+  }
+  if (memory == MAP_FAILED)
+  {
+    throw std::runtime_error("[StreamBufferPool::reserve] Unable to allocate " + std::to_string(size) +
+                             " bytes of stream buffers: " + std::string(std::strerror(errno)));
+  }
+
+  // Touch every page, so that the first frames do not page fault in the SDK's receive path.
+  std::memset(memory, 0, mapped_size);
+  const bool locked = lock_ && mlock(memory, mapped_size) == 0;
+
+  memory_ = memory;
+  mapped_size_ = mapped_size;
+  buffer_count_ = buffer_count;
+  buffer_size_ = buffer_size;
+  huge_page_backed_ = huge_page_backed;
+  locked_ = locked;
+  allocations_++;
+}
+
+void StreamBufferPool::release()
+{
+  if (memory_ == nullptr)
+    return;
+  if (locked_)
+    munlock(memory_, mapped_size_);
+  munmap(memory_, mapped_size_);
+  memory_ = nullptr;
+  mapped_size_ = 0;
+  locked_ = false;
+  huge_page_backed_ = false;
+}
+}  // namespace any_spinnaker_camera_driver
@@ -0,0 +1,174 @@
+/**
+Software License Agreement (BSD)
+
+\file      thread_config.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "any_spinnaker_camera_driver/thread_config.h"
+
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <alloca.h>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+namespace any_spinnaker_camera_driver
+{
+namespace
+{
+std::string policyName(int policy)
+{
+  switch (policy)
+  {
+    case SCHED_FIFO:
+      return "fifo";
+    case SCHED_RR:
+      return "rr";
+    case SCHED_OTHER:
+      return "other";
+    default:
+      return "unknown";
+  }
+}
+
+void appendMessage(ThreadConfigResult* result, const std::string& message)
+{
+  result->complete = false;
+  if (!result->message.empty())
+    result->message += "; ";
+  result->message += message;
+}
+}  // namespace
+
+std::string ThreadConfigResult::toString() const
+{
+  std::stringstream stream;
+  stream << policy;
+  if (policy != "other")
+    stream << " " << priority;
+  stream << " on cpus " << cpus;
+  if (!complete)
+    stream << " (" << message << ")";
+  return stream.str();
+}
+
+ThreadConfigResult applyThreadConfig(pthread_t thread, const ThreadConfig& config)
+{
+  ThreadConfigResult result;
+
+  int policy = SCHED_OTHER;
+  if (config.policy == "fifo")
+  {
+    policy = SCHED_FIFO;
+  }
+  else if (config.policy == "rr")
+  {
+    policy = SCHED_RR;
+  }
+  else if (config.policy != "other")
+  {
+    appendMessage(&result, "unknown policy '" + config.policy + "'");
+  }
+
+  if (policy != SCHED_OTHER)
+  {
+    sched_param param{};
+    const int min_priority = sched_get_priority_min(policy);
+    const int max_priority = sched_get_priority_max(policy);
+    param.sched_priority = config.priority < min_priority ? min_priority :
+                           config.priority > max_priority ? max_priority : config.priority;
+    if (param.sched_priority != config.priority)
+    {
+      appendMessage(&result, "priority clamped to " + std::to_string(param.sched_priority));
+    }
+    const int error = pthread_setschedparam(thread, policy, &param);
+    if (error != 0)
+    {
+      appendMessage(&result, "setting " + config.policy + " failed: " + std::string(std::strerror(error)));
+    }
+  }
+
+  if (!config.cpus.empty())
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : config.cpus)
+    {
+      if (cpu >= 0 && cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &cpu_set);
+    }
+    const int error = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+    if (error != 0)
+    {
+      appendMessage(&result, "setting the affinity failed: " + std::string(std::strerror(error)));
+    }
+  }
+
+  // Report what the kernel actually applied, not what was requested.
+  int applied_policy = SCHED_OTHER;
+  sched_param applied_param{};
+  if (pthread_getschedparam(thread, &applied_policy, &applied_param) == 0)
+  {
+    result.policy = policyName(applied_policy);
+    result.priority = applied_param.sched_priority;
+  }
+
+  cpu_set_t applied_cpus;
+  CPU_ZERO(&applied_cpus);
+  if (pthread_getaffinity_np(thread, sizeof(applied_cpus), &applied_cpus) == 0)
+  {
+    std::stringstream cpus;
+    int count = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (!CPU_ISSET(cpu, &applied_cpus))
+        continue;
+      cpus << (count++ > 0 ? "," : "") << cpu;
+    }
+    result.cpus = config.cpus.empty() ? "all" : cpus.str();
+  }
+  return result;
+}
+
+void prefaultStack(size_t size)
+{
+  if (size == 0)
+    return;
+  volatile unsigned char* stack = static_cast<volatile unsigned char*>(alloca(size));
+  for (size_t i = 0; i < size; i += 4096)
+  {
+    stack[i] = 0;
+  }
+}
+
+bool lockProcessMemory(std::string* error)
+{
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+  {
+    if (error != nullptr)
+      *error = std::strerror(errno);
+    return false;
+  }
+  return true;
+}
+}  // namespace any_spinnaker_camera_driver
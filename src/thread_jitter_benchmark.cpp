@@ -0,0 +1,188 @@
+/**
+Software License Agreement (BSD)
+
+\file      thread_jitter_benchmark.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/**
+   @file thread_jitter_benchmark.cpp
+   @brief Measures the wake-up jitter of a periodic thread, with and without the scheduling config of the driver.
+
+   The loop wakes up at the frame period like the acquisition thread and records how late each wake-up is. Busy
+   threads can be started next to it to emulate the perception load sharing the cores.
+*/
+
+#include "any_spinnaker_camera_driver/thread_config.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+void printUsage()
+{
+  std::cerr << "Usage: thread_jitter_benchmark [options]" << std::endl
+            << "  --period <ms>       Period of the measured loop (default 33.3)." << std::endl
+            << "  --iterations <n>    Number of periods to measure (default 1000)." << std::endl
+            << "  --policy <p>        other, fifo or rr (default other)." << std::endl
+            << "  --priority <n>      Real-time priority (default 50)." << std::endl
+            << "  --cpus <list>       Comma separated CPUs of the measured thread, e.g. 2,3." << std::endl
+            << "  --mlock             Lock the process memory." << std::endl
+            << "  --load <n>          Number of busy threads competing for the CPUs (default 0)." << std::endl
+            << std::endl
+            << "Compare e.g. '--load 8' against '--load 8 --policy fifo --cpus 2'." << std::endl;
+}
+
+std::vector<int> parseCpus(const std::string& list)
+{
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string cpu;
+  while (std::getline(stream, cpu, ','))
+  {
+    cpus.push_back(std::stoi(cpu));
+  }
+  return cpus;
+}
+
+void addNanoseconds(timespec* time, long nanoseconds)
+{
+  time->tv_nsec += nanoseconds;
+  while (time->tv_nsec >= 1000000000L)
+  {
+    time->tv_nsec -= 1000000000L;
+    time->tv_sec++;
+  }
+}
+
+double differenceUs(const timespec& late, const timespec& early)
+{
+  return (late.tv_sec - early.tv_sec) * 1e6 + (late.tv_nsec - early.tv_nsec) * 1e-3;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  double period_ms = 33.3;
+  int iterations = 1000;
+  int load_threads = 0;
+  bool lock_memory = false;
+  any_spinnaker_camera_driver::ThreadConfig config;
+  config.priority = 50;
+  config.prefault_stack_size = 256 * 1024;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string argument = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (argument == "--period" && has_value)
+      period_ms = std::atof(argv[++i]);
+    else if (argument == "--iterations" && has_value)
+      iterations = std::atoi(argv[++i]);
+    else if (argument == "--policy" && has_value)
+      config.policy = argv[++i];
+    else if (argument == "--priority" && has_value)
+      config.priority = std::atoi(argv[++i]);
+    else if (argument == "--cpus" && has_value)
+      config.cpus = parseCpus(argv[++i]);
+    else if (argument == "--load" && has_value)
+      load_threads = std::atoi(argv[++i]);
+    else if (argument == "--mlock")
+      lock_memory = true;
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+  if (period_ms <= 0.0 || iterations <= 0)
+  {
+    printUsage();
+    return 1;
+  }
+
+  if (lock_memory)
+  {
+    std::string error;
+    if (!any_spinnaker_camera_driver::lockProcessMemory(&error))
+      std::cerr << "mlockall failed: " << error << std::endl;
+  }
+
+  std::atomic<bool> running{ true };
+  std::vector<std::thread> load;
+  for (int i = 0; i < load_threads; ++i)
+  {
+    load.emplace_back([&running]() {
+      volatile unsigned long counter = 0;
+      while (running.load(std::memory_order_relaxed))
+        counter = counter + 1;
+    });
+  }
+
+  std::vector<double> latencies_us;
+  latencies_us.reserve(static_cast<size_t>(iterations));
+  std::thread measured([&]() {
+    const any_spinnaker_camera_driver::ThreadConfigResult result =
+        any_spinnaker_camera_driver::applyThreadConfig(pthread_self(), config);
+    any_spinnaker_camera_driver::prefaultStack(config.prefault_stack_size);
+    std::printf("Measured thread: %s\n", result.toString().c_str());
+
+    const long period_ns = static_cast<long>(period_ms * 1e6);
+    timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (int i = 0; i < iterations; ++i)
+    {
+      addNanoseconds(&next, period_ns);
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+      timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      latencies_us.push_back(differenceUs(now, next));
+    }
+  });
+  measured.join();
+
+  running = false;
+  for (auto& thread : load)
+    thread.join();
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  double sum = 0.0;
+  for (const double latency : latencies_us)
+    sum += latency;
+  const auto percentile = [&latencies_us](double p) {
+    return latencies_us[std::min(latencies_us.size() - 1, static_cast<size_t>(p * latencies_us.size()))];
+  };
+  std::printf("Wake-up latency over %d periods of %.1f ms with %d busy threads [us]:\n", iterations, period_ms,
+              load_threads);
+  std::printf("  min %.1f  mean %.1f  p50 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n", latencies_us.front(),
+              sum / latencies_us.size(), percentile(0.5), percentile(0.99), percentile(0.999), latencies_us.back());
+  return 0;
+}
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/bayer_demosaicer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::BayerDemosaicer;
+
+namespace
+{
+const BayerDemosaicer::Pattern PATTERNS[] = { BayerDemosaicer::Pattern::RGGB, BayerDemosaicer::Pattern::GRBG,
+                                              BayerDemosaicer::Pattern::GBRG, BayerDemosaicer::Pattern::BGGR };
+
+/// Color of a pixel, 'R', 'G' or 'B'.
+char colorAt(BayerDemosaicer::Pattern pattern, size_t x, size_t y)
+{
+  const char* order = "RGGB";
+  switch (pattern)
+  {
+    case BayerDemosaicer::Pattern::RGGB:
+      order = "RGGB";
+      break;
+    case BayerDemosaicer::Pattern::GRBG:
+      order = "GRBG";
+      break;
+    case BayerDemosaicer::Pattern::GBRG:
+      order = "GBRG";
+      break;
+    case BayerDemosaicer::Pattern::BGGR:
+      order = "BGGR";
+      break;
+  }
+  return order[2 * (y & 1) + (x & 1)];
+}
+
+/// Mirrors a coordinate one pixel outside of the image back inside, keeping the Bayer phase.
+size_t mirror(ptrdiff_t i, size_t size)
+{
+  if (i < 0)
+    return 1;
+  if (static_cast<size_t>(i) >= size)
+    return size - 2;
+  return static_cast<size_t>(i);
+}
+
+/// Straightforward demosaicing of one pixel at a time, following the documented interpolation.
+template <typename T>
+void referenceDemosaic(const std::vector<T>& bayer, size_t width, size_t height, BayerDemosaicer::Pattern pattern,
+                       bool edge_aware, std::vector<T>* color, std::vector<T>* mono)
+{
+  const auto at = [&](ptrdiff_t x, ptrdiff_t y) -> int {
+    return bayer[mirror(y, height) * width + mirror(x, width)];
+  };
+  color->assign(3 * width * height, 0);
+  mono->assign(width * height, 0);
+  for (size_t y = 0; y < height; ++y)
+  {
+    for (size_t x = 0; x < width; ++x)
+    {
+      const ptrdiff_t sx = static_cast<ptrdiff_t>(x);
+      const ptrdiff_t sy = static_cast<ptrdiff_t>(y);
+      const int center = at(sx, sy);
+      const int l = at(sx - 1, sy);
+      const int r = at(sx + 1, sy);
+      const int u = at(sx, sy - 1);
+      const int d = at(sx, sy + 1);
+      int red;
+      int green;
+      int blue;
+      const char own = colorAt(pattern, x, y);
+      if (own == 'G')
+      {
+        const int horizontal = (l + r + 1) >> 1;
+        const int vertical = (u + d + 1) >> 1;
+        // The neighbors in the row are red in red rows.
+        const bool red_row = colorAt(pattern, x ^ 1, y) == 'R';
+        green = center;
+        red = red_row ? horizontal : vertical;
+        blue = red_row ? vertical : horizontal;
+      }
+      else
+      {
+        green = (l + r + u + d + 2) >> 2;
+        if (edge_aware)
+        {
+          const int gradient_h = std::abs(l - r);
+          const int gradient_v = std::abs(u - d);
+          if (gradient_h < gradient_v)
+            green = (l + r + 1) >> 1;
+          else if (gradient_v < gradient_h)
+            green = (u + d + 1) >> 1;
+        }
+        const int diagonal =
+            (at(sx - 1, sy - 1) + at(sx + 1, sy - 1) + at(sx - 1, sy + 1) + at(sx + 1, sy + 1) + 2) >> 2;
+        red = own == 'R' ? center : diagonal;
+        blue = own == 'B' ? center : diagonal;
+      }
+      T* rgb = &(*color)[3 * (y * width + x)];
+      rgb[0] = static_cast<T>(red);
+      rgb[1] = static_cast<T>(green);
+      rgb[2] = static_cast<T>(blue);
+      (*mono)[y * width + x] = static_cast<T>((4899u * red + 9617u * green + 1868u * blue + 8192u) >> 14);
+    }
+  }
+}
+
+/// Converts an image with padded rows and compares it to the reference.
+template <typename T>
+void expectMatchesReference(size_t width, size_t height, BayerDemosaicer::Pattern pattern,
+                            BayerDemosaicer::Method method, unsigned int threads, uint32_t seed)
+{
+  std::mt19937 random(seed);
+  std::vector<T> bayer(width * height);
+  for (T& pixel : bayer)
+    pixel = static_cast<T>(random());
+
+  // Rows with padding, so that the steps are used.
+  const size_t src_step = (width + 3) * sizeof(T);
+  const size_t color_step = (3 * width + 5) * sizeof(T);
+  const size_t mono_step = (width + 7) * sizeof(T);
+  std::vector<uint8_t> src(src_step * height, 0);
+  for (size_t y = 0; y < height; ++y)
+    std::memcpy(&src[y * src_step], &bayer[y * width], width * sizeof(T));
+  std::vector<uint8_t> color(color_step * height, 0);
+  std::vector<uint8_t> mono(mono_step * height, 0);
+
+  BayerDemosaicer demosaicer(method, threads);
+  demosaicer.process(src.data(), width, height, src_step, pattern, 8 * sizeof(T), color.data(), color_step,
+                     mono.data(), mono_step);
+
+  std::vector<T> expected_color;
+  std::vector<T> expected_mono;
+  referenceDemosaic(bayer, width, height, pattern, method == BayerDemosaicer::Method::EDGE_AWARE, &expected_color,
+                    &expected_mono);
+  for (size_t y = 0; y < height; ++y)
+  {
+    const T* color_row = reinterpret_cast<const T*>(&color[y * color_step]);
+    const T* mono_row = reinterpret_cast<const T*>(&mono[y * mono_step]);
+    for (size_t x = 0; x < width; ++x)
+    {
+      for (size_t c = 0; c < 3; ++c)
+      {
+        ASSERT_EQ(color_row[3 * x + c], expected_color[3 * (y * width + x) + c])
+            << "pixel " << x << ", " << y << " channel " << c << " of a " << width << " x " << height << " image";
+      }
+      ASSERT_EQ(mono_row[x], expected_mono[y * width + x])
+          << "pixel " << x << ", " << y << " of a " << width << " x " << height << " image";
+    }
+  }
+}
+
+struct Size
+{
+  size_t width;
+  size_t height;
+};
+
+const Size SIZES[] = { { 2, 2 }, { 3, 2 }, { 2, 3 }, { 3, 3 }, { 4, 4 }, { 5, 7 }, { 17, 9 }, { 64, 33 }, { 65, 40 } };
+}  // namespace
+
+TEST(BayerDemosaicer, parseEncoding)  // NOLINT
+{
+  BayerDemosaicer::Pattern pattern;
+  unsigned int bit_depth;
+  ASSERT_TRUE(BayerDemosaicer::parseEncoding("bayer_gbrg16", &pattern, &bit_depth));
+  EXPECT_EQ(pattern, BayerDemosaicer::Pattern::GBRG);
+  EXPECT_EQ(bit_depth, 16u);
+  ASSERT_TRUE(BayerDemosaicer::parseEncoding("bayer_rggb8", &pattern, &bit_depth));
+  EXPECT_EQ(pattern, BayerDemosaicer::Pattern::RGGB);
+  EXPECT_EQ(bit_depth, 8u);
+  EXPECT_FALSE(BayerDemosaicer::parseEncoding("mono8", &pattern, &bit_depth));
+  EXPECT_FALSE(BayerDemosaicer::parseEncoding("bayer_rggb12", &pattern, &bit_depth));
+  EXPECT_FALSE(BayerDemosaicer::parseEncoding("bayer_xyzw8", &pattern, &bit_depth));
+}
+
+TEST(BayerDemosaicer, bilinear8MatchesReference)  // NOLINT
+{
+  uint32_t seed = 1;
+  for (const BayerDemosaicer::Pattern pattern : PATTERNS)
+    for (const Size& size : SIZES)
+      expectMatchesReference<uint8_t>(size.width, size.height, pattern, BayerDemosaicer::Method::BILINEAR, 1, seed++);
+}
+
+TEST(BayerDemosaicer, bilinear16MatchesReference)  // NOLINT
+{
+  uint32_t seed = 100;
+  for (const BayerDemosaicer::Pattern pattern : PATTERNS)
+    for (const Size& size : SIZES)
+      expectMatchesReference<uint16_t>(size.width, size.height, pattern, BayerDemosaicer::Method::BILINEAR, 1, seed++);
+}
+
+TEST(BayerDemosaicer, edgeAwareMatchesReference)  // NOLINT
+{
+  uint32_t seed = 200;
+  for (const BayerDemosaicer::Pattern pattern : PATTERNS)
+  {
+    for (const Size& size : SIZES)
+    {
+      expectMatchesReference<uint8_t>(size.width, size.height, pattern, BayerDemosaicer::Method::EDGE_AWARE, 1,
+                                      seed++);
+      expectMatchesReference<uint16_t>(size.width, size.height, pattern, BayerDemosaicer::Method::EDGE_AWARE, 1,
+                                       seed++);
+    }
+  }
+}
+
+TEST(BayerDemosaicer, bandsMatchReference)  // NOLINT
+{
+  uint32_t seed = 300;
+  for (const BayerDemosaicer::Pattern pattern : PATTERNS)
+  {
+    // Bands of odd and even heights, and more threads than rows.
+    expectMatchesReference<uint8_t>(33, 31, pattern, BayerDemosaicer::Method::BILINEAR, 3, seed++);
+    expectMatchesReference<uint16_t>(34, 29, pattern, BayerDemosaicer::Method::EDGE_AWARE, 4, seed++);
+    expectMatchesReference<uint8_t>(7, 3, pattern, BayerDemosaicer::Method::EDGE_AWARE, 4, seed++);
+  }
+}
+
+TEST(BayerDemosaicer, colorOrMonoOnly)  // NOLINT
+{
+  const size_t width = 9;
+  const size_t height = 6;
+  std::vector<uint8_t> bayer(width * height);
+  for (size_t i = 0; i < bayer.size(); ++i)
+    bayer[i] = static_cast<uint8_t>(37 * i);
+  std::vector<uint8_t> expected_color;
+  std::vector<uint8_t> expected_mono;
+  referenceDemosaic(bayer, width, height, BayerDemosaicer::Pattern::BGGR, false, &expected_color, &expected_mono);
+
+  BayerDemosaicer demosaicer(BayerDemosaicer::Method::BILINEAR, 2);
+  std::vector<uint8_t> color(3 * width * height);
+  demosaicer.process(bayer.data(), width, height, width, BayerDemosaicer::Pattern::BGGR, 8, color.data(), 3 * width,
+                     nullptr, 0);
+  EXPECT_EQ(color, expected_color);
+  std::vector<uint8_t> mono(width * height);
+  demosaicer.process(bayer.data(), width, height, width, BayerDemosaicer::Pattern::BGGR, 8, nullptr, 0, mono.data(),
+                     width);
+  EXPECT_EQ(mono, expected_mono);
+}
+
+TEST(BayerDemosaicer, rejectsInvalidImages)  // NOLINT
+{
+  BayerDemosaicer demosaicer(BayerDemosaicer::Method::BILINEAR, 1);
+  std::vector<uint8_t> buffer(64);
+  EXPECT_THROW(demosaicer.process(buffer.data(), 1, 4, 1, BayerDemosaicer::Pattern::RGGB, 8, buffer.data(), 3,
+                                  nullptr, 0),
+               std::runtime_error);
+  EXPECT_THROW(demosaicer.process(buffer.data(), 4, 2, 4, BayerDemosaicer::Pattern::RGGB, 12, buffer.data(), 12,
+                                  nullptr, 0),
+               std::runtime_error);
+}
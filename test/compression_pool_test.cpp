@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/compression_pool.h"
+
+#include <opencv2/imgcodecs.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using any_spinnaker_camera_driver::CompressionPool;
+
+namespace
+{
+sensor_msgs::ImagePtr makeImage(uint32_t seq, const std::string& encoding = "mono8")
+{
+  sensor_msgs::ImagePtr image(new sensor_msgs::Image);
+  image->header.seq = seq;
+  image->encoding = encoding;
+  image->width = 8;
+  image->height = 6;
+  image->step = image->width;
+  image->data.resize(image->step * image->height);
+  for (size_t i = 0; i < image->data.size(); ++i)
+    image->data[i] = static_cast<uint8_t>(seq + 7 * i);
+  return image;
+}
+
+/// Collects the sequence numbers of the compressed images handed to the callback.
+class Collector
+{
+public:
+  void add(const sensor_msgs::CompressedImageConstPtr& compressed)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sequences_.push_back(compressed->header.seq);
+    cv_.notify_all();
+  }
+
+  /// Waits until the given number of images arrived, returns their sequence numbers.
+  std::vector<uint32_t> wait(size_t count)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, std::chrono::seconds(5), [&]() { return sequences_.size() >= count; });
+    return sequences_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<uint32_t> sequences_;
+};
+
+/// The statistics once the given number of images was handed on, the pool counts them after the callback returned.
+CompressionPool::Statistics waitForCompressed(const CompressionPool& pool, uint64_t count)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  CompressionPool::Statistics statistics = pool.getStatistics();
+  while (statistics.compressed < count && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    statistics = pool.getStatistics();
+  }
+  return statistics;
+}
+}  // namespace
+
+TEST(CompressionPool, dropsTheOldestImageWhenFull)  // NOLINT
+{
+  CompressionPool::Config config;
+  config.format = "png";
+  config.threads = 1;
+  config.queue_size = 2;
+
+  // The callback of the first image blocks the only worker until the gate opens.
+  std::promise<void> entered;
+  std::promise<void> gate;
+  std::shared_future<void> gate_opened = gate.get_future().share();
+  bool first = true;
+  Collector collector;
+  CompressionPool pool(config, [&](const sensor_msgs::CompressedImageConstPtr& compressed) {
+    if (first)
+    {
+      first = false;
+      entered.set_value();
+      gate_opened.wait();
+    }
+    collector.add(compressed);
+  });
+
+  pool.submit(makeImage(0));
+  entered.get_future().wait();
+  // Never blocks: the queue keeps the two newest images.
+  for (uint32_t seq = 1; seq <= 4; ++seq)
+    pool.submit(makeImage(seq));
+  EXPECT_EQ(pool.getStatistics().dropped, 2u);
+
+  gate.set_value();
+  EXPECT_EQ(collector.wait(3), std::vector<uint32_t>({ 0, 3, 4 }));
+  const CompressionPool::Statistics statistics = waitForCompressed(pool, 3);
+  EXPECT_EQ(statistics.compressed, 3u);
+  EXPECT_EQ(statistics.dropped, 2u);
+  EXPECT_EQ(statistics.failed, 0u);
+}
+
+TEST(CompressionPool, handsOnResultsInOrder)  // NOLINT
+{
+  CompressionPool::Config config;
+  config.format = "jpeg";
+  config.threads = 4;
+  config.queue_size = 64;
+  Collector collector;
+  CompressionPool pool(config, [&](const sensor_msgs::CompressedImageConstPtr& compressed) {
+    collector.add(compressed);
+  });
+
+  std::vector<uint32_t> expected;
+  for (uint32_t seq = 0; seq < 40; ++seq)
+  {
+    // Images that cannot be compressed do not hold back the later ones.
+    pool.submit(makeImage(seq, seq % 10 == 5 ? "yuv422" : "mono8"));
+    if (seq % 10 != 5)
+      expected.push_back(seq);
+  }
+  EXPECT_EQ(collector.wait(expected.size()), expected);
+  const CompressionPool::Statistics statistics = waitForCompressed(pool, expected.size());
+  EXPECT_EQ(statistics.compressed, expected.size());
+  EXPECT_EQ(statistics.dropped, 0u);
+  EXPECT_EQ(statistics.failed, 4u);
+  EXPECT_FALSE(statistics.last_error.empty());
+}
+
+TEST(CompressionPool, compressesLosslesslyToPng)  // NOLINT
+{
+  CompressionPool::Config config;
+  config.format = "png";
+  sensor_msgs::ImagePtr image = makeImage(1, "mono16");
+  image->step = 2 * image->width;
+  image->data.resize(image->step * image->height);
+  for (size_t i = 0; i < image->data.size(); ++i)
+    image->data[i] = static_cast<uint8_t>(31 * i);
+
+  sensor_msgs::CompressedImage compressed;
+  std::string error;
+  ASSERT_TRUE(CompressionPool::compress(*image, config, &compressed, &error)) << error;
+  EXPECT_EQ(compressed.format, "mono16; png compressed mono16");
+  EXPECT_EQ(compressed.header.seq, 1u);
+
+  const cv::Mat decoded = cv::imdecode(compressed.data, cv::IMREAD_UNCHANGED);
+  ASSERT_EQ(decoded.type(), CV_16UC1);
+  ASSERT_EQ(decoded.cols, static_cast<int>(image->width));
+  ASSERT_EQ(decoded.rows, static_cast<int>(image->height));
+  for (int y = 0; y < decoded.rows; ++y)
+  {
+    for (int x = 0; x < decoded.cols; ++x)
+    {
+      uint16_t expected;
+      std::memcpy(&expected, &image->data[y * image->step + 2 * x], sizeof(expected));
+      EXPECT_EQ(decoded.at<uint16_t>(y, x), expected);
+    }
+  }
+
+  config.format = "webp";
+  EXPECT_FALSE(CompressionPool::compress(*image, config, &compressed, &error));
+  EXPECT_FALSE(error.empty());
+}
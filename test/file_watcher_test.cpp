@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/file_watcher.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using any_spinnaker_camera_driver::waitForFile;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// Temporary directory, removed with its content.
+class TemporaryDirectory
+{
+public:
+  TemporaryDirectory()
+  {
+    char path[] = "/tmp/file_watcher_test_XXXXXX";
+    path_ = ::mkdtemp(path);
+  }
+
+  ~TemporaryDirectory()
+  {
+    const std::string command = "rm -rf '" + path_ + "'";
+    EXPECT_EQ(std::system(command.c_str()), 0);
+  }
+
+  const std::string& getPath() const
+  {
+    return path_;
+  }
+
+private:
+  std::string path_;
+};
+
+void createFile(const std::string& path)
+{
+  std::ofstream file(path);
+  file << "1234abcd";
+}
+
+double secondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+}  // namespace
+
+TEST(FileWatcher, existingFile)  // NOLINT
+{
+  TemporaryDirectory dir;
+  const std::string path = dir.getPath() + "/serial";
+  createFile(path);
+  const Clock::time_point start = Clock::now();
+  EXPECT_TRUE(waitForFile(path, 1.0));
+  EXPECT_LT(secondsSince(start), 0.05);
+}
+
+TEST(FileWatcher, timesOut)  // NOLINT
+{
+  TemporaryDirectory dir;
+  const Clock::time_point start = Clock::now();
+  EXPECT_FALSE(waitForFile(dir.getPath() + "/missing/serial", 0.3));
+  const double elapsed = secondsSince(start);
+  EXPECT_GE(elapsed, 0.3);
+  EXPECT_LT(elapsed, 1.0);
+}
+
+TEST(FileWatcher, followsCreatedDirectories)  // NOLINT
+{
+  TemporaryDirectory dir;
+  const std::string device = dir.getPath() + "/usb1/1-1";
+  const std::string path = device + "/serial";
+  // The directories appear one by one, like a device enumerated by the kernel.
+  std::thread creator([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ::mkdir((dir.getPath() + "/usb1").c_str(), 0755);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ::mkdir(device.c_str(), 0755);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    createFile(path);
+  });
+  const Clock::time_point start = Clock::now();
+  EXPECT_TRUE(waitForFile(path, 5.0));
+  const double elapsed = secondsSince(start);
+  creator.join();
+  EXPECT_GE(elapsed, 0.3);
+  // Well before the timeout, the wait ends with the creation of the file.
+  EXPECT_LT(elapsed, 1.0);
+}
+
+TEST(FileWatcher, stopAbandonsTheWait)  // NOLINT
+{
+  TemporaryDirectory dir;
+  std::atomic<bool> stop{ false };
+  std::thread stopper([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    stop = true;
+  });
+  const Clock::time_point start = Clock::now();
+  // Waits forever unless stopped.
+  EXPECT_FALSE(waitForFile(dir.getPath() + "/serial", 0.0, [&]() { return stop.load(); }));
+  const double elapsed = secondsSince(start);
+  stopper.join();
+  EXPECT_GE(elapsed, 0.2);
+  EXPECT_LT(elapsed, 1.0);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/frame_decimator.h"
+
+#include <cstdint>
+#include <vector>
+
+using any_spinnaker_camera_driver::FrameDecimator;
+
+namespace
+{
+constexpr uint64_t PERIOD_NS = 33333333;  // 30 fps
+constexpr uint64_t START_NS = 1000000000;
+
+/// Returns the indices of the selected frames among the given frame indices.
+std::vector<uint64_t> select(FrameDecimator* decimator, const std::vector<uint64_t>& frames,
+                             uint64_t start_ns = START_NS)
+{
+  std::vector<uint64_t> selected;
+  for (const uint64_t frame : frames)
+  {
+    if (decimator->select(start_ns + frame * PERIOD_NS))
+      selected.push_back(frame);
+  }
+  return selected;
+}
+
+std::vector<uint64_t> range(uint64_t begin, uint64_t end)
+{
+  std::vector<uint64_t> frames;
+  for (uint64_t frame = begin; frame < end; ++frame)
+    frames.push_back(frame);
+  return frames;
+}
+}  // namespace
+
+TEST(FrameDecimator, factorOneSelectsEveryFrame)  // NOLINT
+{
+  FrameDecimator decimator(1);
+  EXPECT_EQ(select(&decimator, range(0, 10)), range(0, 10));
+
+  FrameDecimator clamped(0);
+  EXPECT_EQ(clamped.getFactor(), 1u);
+}
+
+TEST(FrameDecimator, evenSpacing)  // NOLINT
+{
+  FrameDecimator decimator(15);
+  EXPECT_EQ(select(&decimator, range(0, 61)), std::vector<uint64_t>({ 0, 15, 30, 45, 60 }));
+  EXPECT_NEAR(decimator.getPeriodEstimate(), PERIOD_NS * 1e-9, 1e-6);
+}
+
+TEST(FrameDecimator, toleratesJitter)  // NOLINT
+{
+  FrameDecimator decimator(3);
+  std::vector<uint64_t> selected;
+  for (uint64_t frame = 0; frame < 30; ++frame)
+  {
+    // Stamps jitter by a twentieth of a period.
+    const int64_t jitter = (frame % 2 == 0 ? 1 : -1) * static_cast<int64_t>(PERIOD_NS / 20);
+    if (decimator.select(START_NS + frame * PERIOD_NS + jitter))
+      selected.push_back(frame);
+  }
+  EXPECT_EQ(selected, std::vector<uint64_t>({ 0, 3, 6, 9, 12, 15, 18, 21, 24, 27 }));
+}
+
+TEST(FrameDecimator, droppedFramesKeepTheSpacing)  // NOLINT
+{
+  FrameDecimator decimator(5);
+  std::vector<uint64_t> frames = range(0, 40);
+  // Frames 4 to 6 and 20 are dropped, the selection continues on the time grid of the full stream.
+  frames.erase(frames.begin() + 20);
+  frames.erase(frames.begin() + 4, frames.begin() + 7);
+  EXPECT_EQ(select(&decimator, frames), std::vector<uint64_t>({ 0, 7, 12, 17, 22, 27, 32, 37 }));
+  // The drops do not inflate the period estimate.
+  EXPECT_NEAR(decimator.getPeriodEstimate(), PERIOD_NS * 1e-9, 1e-6);
+}
+
+TEST(FrameDecimator, clockReset)  // NOLINT
+{
+  FrameDecimator decimator(4);
+  EXPECT_EQ(select(&decimator, range(0, 6)), std::vector<uint64_t>({ 0, 4 }));
+  // The camera clock restarts, e.g. after a reconnect: the next frame is selected and the spacing restarts from it.
+  EXPECT_EQ(select(&decimator, range(0, 9), 1000), std::vector<uint64_t>({ 0, 4, 8 }));
+
+  decimator.reset();
+  EXPECT_EQ(decimator.getPeriodEstimate(), 0.0);
+  EXPECT_TRUE(decimator.select(START_NS));
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/frame_recorder.h"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::FrameRecordMetadata;
+using any_spinnaker_camera_driver::FrameRecordReader;
+using any_spinnaker_camera_driver::FrameRecorder;
+
+namespace
+{
+std::string temporaryPath()
+{
+  return "/tmp/frame_recorder_test_" + std::to_string(getpid()) + "_" +
+         ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+std::vector<uint8_t> makeFrame(size_t size, uint8_t seed)
+{
+  std::vector<uint8_t> frame(size);
+  for (size_t i = 0; i < size; ++i)
+    frame[i] = static_cast<uint8_t>(seed + i);
+  return frame;
+}
+
+FrameRecordMetadata makeMetadata(uint64_t frame_id)
+{
+  FrameRecordMetadata metadata;
+  metadata.stamp_ns = 1000 * frame_id;
+  metadata.hardware_stamp_ns = 2000 * frame_id;
+  metadata.frame_id = frame_id;
+  metadata.width = 64;
+  metadata.height = 16;
+  metadata.step = 64;
+  std::strncpy(metadata.encoding, "bayer_rggb8", sizeof(metadata.encoding) - 1);
+  return metadata;
+}
+}  // namespace
+
+TEST(FrameRecorder, roundTrip)  // NOLINT
+{
+  const std::string path = temporaryPath();
+  {
+    FrameRecorder recorder(path, 1 << 20, 16, 0.01);
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+      const std::vector<uint8_t> frame = makeFrame(1024, i);
+      ASSERT_TRUE(recorder.record(makeMetadata(i), frame.data(), frame.size()));
+    }
+    EXPECT_EQ(recorder.getRecordedFrames(), 10u);
+  }
+
+  FrameRecordReader reader(path);
+  EXPECT_TRUE(reader.wasClosed());
+  ASSERT_EQ(reader.size(), 10u);
+  for (size_t i = 0; i < reader.size(); ++i)
+  {
+    FrameRecordMetadata metadata;
+    const uint8_t* data = nullptr;
+    ASSERT_TRUE(reader.getFrame(i, &metadata, &data));
+    EXPECT_EQ(metadata.frame_id, i);
+    EXPECT_EQ(metadata.hardware_stamp_ns, 2000 * i);
+    EXPECT_STREQ(metadata.encoding, "bayer_rggb8");
+    ASSERT_EQ(metadata.data_size, 1024u);
+    const std::vector<uint8_t> expected = makeFrame(1024, static_cast<uint8_t>(i));
+    EXPECT_EQ(std::memcmp(data, expected.data(), expected.size()), 0);
+  }
+  unlink(path.c_str());
+}
+
+TEST(FrameRecorder, overwritesOldestFrames)  // NOLINT
+{
+  const std::string path = temporaryPath();
+  const size_t frame_size = 100000;
+  {
+    // Room for roughly five frames, far more frames than that are recorded.
+    FrameRecorder recorder(path, 4096 * 2 + 5 * frame_size + 4096, 64, 0.01);
+    for (uint8_t i = 0; i < 40; ++i)
+    {
+      const std::vector<uint8_t> frame = makeFrame(frame_size - 7 * i, i);
+      ASSERT_TRUE(recorder.record(makeMetadata(i), frame.data(), frame.size()));
+    }
+  }
+
+  FrameRecordReader reader(path);
+  ASSERT_GE(reader.size(), 3u);
+  ASSERT_LE(reader.size(), 5u);
+  for (size_t i = 0; i < reader.size(); ++i)
+  {
+    FrameRecordMetadata metadata;
+    const uint8_t* data = nullptr;
+    ASSERT_TRUE(reader.getFrame(i, &metadata, &data));
+    // Only the most recent frames survive, in order.
+    EXPECT_EQ(metadata.frame_id, 40 - reader.size() + i);
+    const std::vector<uint8_t> expected =
+        makeFrame(frame_size - 7 * metadata.frame_id, static_cast<uint8_t>(metadata.frame_id));
+    ASSERT_EQ(metadata.data_size, expected.size());
+    EXPECT_EQ(std::memcmp(data, expected.data(), expected.size()), 0);
+  }
+  unlink(path.c_str());
+}
+
+TEST(FrameRecorder, indexCapacityLimitsFrames)  // NOLINT
+{
+  const std::string path = temporaryPath();
+  {
+    FrameRecorder recorder(path, 1 << 20, 4, 0.01);
+    for (uint8_t i = 0; i < 9; ++i)
+    {
+      const std::vector<uint8_t> frame = makeFrame(128, i);
+      ASSERT_TRUE(recorder.record(makeMetadata(i), frame.data(), frame.size()));
+    }
+    // A frame larger than the data segment is rejected.
+    const std::vector<uint8_t> huge(2 << 20);
+    EXPECT_FALSE(recorder.record(makeMetadata(9), huge.data(), huge.size()));
+    EXPECT_EQ(recorder.getDroppedFrames(), 1u);
+  }
+
+  FrameRecordReader reader(path);
+  ASSERT_EQ(reader.size(), 4u);
+  FrameRecordMetadata metadata;
+  const uint8_t* data = nullptr;
+  ASSERT_TRUE(reader.getFrame(0, &metadata, &data));
+  EXPECT_EQ(metadata.frame_id, 5u);
+  EXPECT_FALSE(reader.getFrame(4, &metadata, &data));
+  unlink(path.c_str());
+}
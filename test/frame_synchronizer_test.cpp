@@ -0,0 +1,152 @@
+/**
+Software License Agreement (BSD)
+
+\file      frame_synchronizer_test.cpp
+\authors   ANYbotics AG
+\copyright Copyright (c) 2026, ANYbotics AG, All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+   following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+   following disclaimer in the documentation and/or other materials provided with the distribution.
+ * Neither the name of ANYbotics AG nor the names of its contributors may be used to endorse or promote
+   products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WAR-
+RANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, IN-
+DIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/frame_synchronizer.h"
+
+using Synchronizer = any_spinnaker_camera_driver::FrameSynchronizer<int>;
+
+namespace
+{
+constexpr uint64_t kPeriodNs = 50000000;  // 20 Hz trigger.
+
+Synchronizer::Frame makeFrame(uint64_t hardware_stamp_ns, uint64_t frame_id, uint64_t receive_stamp_ns, int payload)
+{
+  Synchronizer::Frame frame;
+  frame.hardware_stamp_ns = hardware_stamp_ns;
+  frame.frame_id = frame_id;
+  frame.receive_stamp_ns = receive_stamp_ns;
+  frame.payload = payload;
+  return frame;
+}
+}  // namespace
+
+TEST(FrameSynchronizer, pairsCamerasWithDifferentClocks)  // NOLINT
+{
+  Synchronizer::Config config;
+  config.tolerance = 0.002;
+  Synchronizer synchronizer(2, config);
+
+  // The cameras count from different epochs and deliver with a varying latency.
+  const uint64_t epoch_left = 1000000000;
+  const uint64_t epoch_right = 7000000000;
+  Synchronizer::Set set;
+  unsigned int sets = 0;
+  for (uint64_t i = 0; i < 20; ++i)
+  {
+    const uint64_t trigger = 100 * kPeriodNs + i * kPeriodNs;
+    const uint64_t latency = 3000000 + (i % 3) * 1000000;
+    EXPECT_FALSE(synchronizer.add(0, makeFrame(epoch_left + i * kPeriodNs, 10 + i, trigger + latency, 1), &set));
+    if (synchronizer.add(1, makeFrame(epoch_right + i * kPeriodNs, 500 + i, trigger + latency + 200000, 2), &set))
+    {
+      ++sets;
+      ASSERT_EQ(set.frames.size(), 2u);
+      EXPECT_EQ(set.frames[0].payload, 1);
+      EXPECT_EQ(set.frames[1].payload, 2);
+      EXPECT_EQ(set.frames[1].frame_id - set.frames[0].frame_id, 490u);
+      EXPECT_EQ(set.stamp_ns, trigger + latency);
+    }
+  }
+  EXPECT_EQ(sets, 20u);
+  EXPECT_EQ(synchronizer.getStatistics().dropped, 0u);
+  EXPECT_DOUBLE_EQ(synchronizer.getStatistics().getPairingRate(2), 1.0);
+}
+
+TEST(FrameSynchronizer, dropsFramesWithoutPartner)  // NOLINT
+{
+  Synchronizer::Config config;
+  config.shared_clock = true;
+  config.tolerance = 0.001;
+  Synchronizer synchronizer(2, config);
+
+  Synchronizer::Set set;
+  unsigned int sets = 0;
+  for (uint64_t i = 0; i < 10; ++i)
+  {
+    const uint64_t stamp = i * kPeriodNs;
+    synchronizer.add(0, makeFrame(stamp, i + 1, stamp, 0), &set);
+    // The second camera misses every third trigger.
+    if (i % 3 != 1 && synchronizer.add(1, makeFrame(stamp + 300000, i + 1, stamp, 1), &set))
+    {
+      ++sets;
+      EXPECT_EQ(set.frames[0].hardware_stamp_ns, stamp);
+      EXPECT_NEAR(set.skew_ms, 0.3, 1e-9);
+    }
+  }
+  EXPECT_EQ(sets, 7u);
+  // The unmatched frame of the first camera is dropped once the second camera delivered a later frame.
+  EXPECT_EQ(synchronizer.getStatistics().dropped, 3u);
+}
+
+TEST(FrameSynchronizer, matchesByFrameIdAfterLearningOffsets)  // NOLINT
+{
+  Synchronizer::Config config;
+  config.shared_clock = true;
+  config.use_frame_ids = true;
+  config.tolerance = 0.001;
+  Synchronizer synchronizer(2, config);
+
+  Synchronizer::Set set;
+  ASSERT_FALSE(synchronizer.add(0, makeFrame(0, 5, 0, 0), &set));
+  ASSERT_TRUE(synchronizer.add(1, makeFrame(100, 8, 0, 1), &set));
+
+  // Once the offset of 3 is known, the counters decide, even if the time stamps drift apart.
+  ASSERT_FALSE(synchronizer.add(0, makeFrame(kPeriodNs, 6, 0, 0), &set));
+  ASSERT_TRUE(synchronizer.add(1, makeFrame(kPeriodNs + 5000000, 9, 0, 1), &set));
+  EXPECT_EQ(set.frames[0].frame_id, 6u);
+  EXPECT_EQ(set.frames[1].frame_id, 9u);
+
+  // A restarted camera makes the synchronizer learn the offsets again by time.
+  ASSERT_FALSE(synchronizer.add(1, makeFrame(2 * kPeriodNs, 1, 0, 1), &set));
+  ASSERT_TRUE(synchronizer.add(0, makeFrame(2 * kPeriodNs, 7, 0, 0), &set));
+  EXPECT_EQ(set.frames[1].frame_id, 1u);
+}
+
+TEST(FrameSynchronizer, countsFramesDiscardedOnRestart)  // NOLINT
+{
+  Synchronizer::Config config;
+  config.shared_clock = true;
+  config.tolerance = 0.001;
+  Synchronizer synchronizer(2, config);
+
+  // The first camera delivers two frames the second one has no partners for yet.
+  Synchronizer::Set set;
+  ASSERT_FALSE(synchronizer.add(0, makeFrame(0, 10, 0, 0), &set));
+  ASSERT_FALSE(synchronizer.add(0, makeFrame(kPeriodNs, 11, 0, 0), &set));
+  // The counter of the first camera jumps back, the queued frames are discarded.
+  ASSERT_FALSE(synchronizer.add(0, makeFrame(2 * kPeriodNs, 1, 0, 0), &set));
+  ASSERT_TRUE(synchronizer.add(1, makeFrame(2 * kPeriodNs, 20, 0, 1), &set));
+
+  const Synchronizer::Statistics& statistics = synchronizer.getStatistics();
+  EXPECT_EQ(statistics.frames, 4u);
+  EXPECT_EQ(statistics.sets, 1u);
+  EXPECT_EQ(statistics.dropped, 2u);
+  EXPECT_DOUBLE_EQ(statistics.getPairingRate(2), 0.5);
+
+  // Frames forgotten by a reset are counted as well.
+  ASSERT_FALSE(synchronizer.add(1, makeFrame(3 * kPeriodNs, 21, 0, 1), &set));
+  synchronizer.reset();
+  EXPECT_EQ(synchronizer.getStatistics().dropped, 3u);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/grab_recovery_policy.h"
+
+#include <chrono>
+#include <vector>
+
+using any_spinnaker_camera_driver::GrabRecoveryPolicy;
+using Tier = GrabRecoveryPolicy::Tier;
+
+namespace
+{
+GrabRecoveryPolicy::Clock::time_point at(int ms)
+{
+  return GrabRecoveryPolicy::Clock::time_point() + std::chrono::milliseconds(ms);
+}
+
+std::vector<Tier> fail(GrabRecoveryPolicy* policy, int failures, int start_ms = 0)
+{
+  std::vector<Tier> tiers;
+  for (int i = 0; i < failures; ++i)
+    tiers.push_back(policy->onFailure(at(start_ms + i)));
+  return tiers;
+}
+}  // namespace
+
+TEST(GrabRecoveryPolicy, escalatesInOrder)  // NOLINT
+{
+  GrabRecoveryPolicy policy;
+  EXPECT_EQ(fail(&policy, 7), std::vector<Tier>({ Tier::RETRY, Tier::RETRY, Tier::REARM, Tier::REINIT,
+                                                  Tier::RECONNECT, Tier::RECONNECT, Tier::RECONNECT }));
+
+  GrabRecoveryPolicy::Config config;
+  config.retries = 0;
+  config.rearms = 2;
+  config.reinits = 0;
+  policy.setConfig(config);
+  EXPECT_TRUE(policy.onSuccess(at(10)));
+  EXPECT_EQ(fail(&policy, 4, 20), std::vector<Tier>({ Tier::REARM, Tier::REARM, Tier::RECONNECT, Tier::RECONNECT }));
+}
+
+TEST(GrabRecoveryPolicy, successResetsTheIncident)  // NOLINT
+{
+  GrabRecoveryPolicy policy;
+  EXPECT_FALSE(policy.onSuccess(at(0)));
+
+  EXPECT_EQ(fail(&policy, 3), std::vector<Tier>({ Tier::RETRY, Tier::RETRY, Tier::REARM }));
+  EXPECT_TRUE(policy.onSuccess(at(5)));
+  EXPECT_FALSE(policy.onSuccess(at(6)));
+
+  // The next incident starts over with retries.
+  EXPECT_EQ(fail(&policy, 2, 10), std::vector<Tier>({ Tier::RETRY, Tier::RETRY }));
+}
+
+TEST(GrabRecoveryPolicy, lostDeviceReconnects)  // NOLINT
+{
+  GrabRecoveryPolicy policy;
+  EXPECT_EQ(policy.onFailure(at(0)), Tier::RETRY);
+  EXPECT_EQ(policy.onFailure(at(1), true), Tier::RECONNECT);
+  EXPECT_EQ(policy.onFailure(at(2)), Tier::RECONNECT);
+  EXPECT_TRUE(policy.onSuccess(at(3)));
+
+  // Also as the first failure of an incident.
+  EXPECT_EQ(policy.onFailure(at(10), true), Tier::RECONNECT);
+  EXPECT_TRUE(policy.onSuccess(at(11)));
+  EXPECT_EQ(policy.onFailure(at(20)), Tier::RETRY);
+}
+
+TEST(GrabRecoveryPolicy, statistics)  // NOLINT
+{
+  GrabRecoveryPolicy policy;
+  GrabRecoveryPolicy::Statistics statistics = policy.getStatistics();
+  EXPECT_EQ(statistics.incidents, 0u);
+  EXPECT_EQ(statistics.last_tier, Tier::NONE);
+
+  // A retry that recovered after 30 ms.
+  fail(&policy, 1, 100);
+  ASSERT_TRUE(policy.onSuccess(at(130)));
+  statistics = policy.getStatistics();
+  EXPECT_EQ(statistics.incidents, 1u);
+  EXPECT_DOUBLE_EQ(statistics.last_downtime_ms, 30.0);
+  EXPECT_DOUBLE_EQ(statistics.max_downtime_ms, 30.0);
+  EXPECT_EQ(statistics.last_tier, Tier::RETRY);
+
+  // A re-initialization that recovered after 500 ms, counted by its highest tier.
+  fail(&policy, 4, 1000);
+  ASSERT_TRUE(policy.onSuccess(at(1500)));
+  // A reconnect that recovered after 10 ms.
+  policy.onFailure(at(2000), true);
+  ASSERT_TRUE(policy.onSuccess(at(2010)));
+
+  statistics = policy.getStatistics();
+  EXPECT_EQ(statistics.incidents, 3u);
+  EXPECT_DOUBLE_EQ(statistics.last_downtime_ms, 10.0);
+  EXPECT_DOUBLE_EQ(statistics.max_downtime_ms, 500.0);
+  EXPECT_EQ(statistics.last_tier, Tier::RECONNECT);
+  EXPECT_EQ(statistics.incidents_per_tier[static_cast<size_t>(Tier::NONE)], 0u);
+  EXPECT_EQ(statistics.incidents_per_tier[static_cast<size_t>(Tier::RETRY)], 1u);
+  EXPECT_EQ(statistics.incidents_per_tier[static_cast<size_t>(Tier::REARM)], 0u);
+  EXPECT_EQ(statistics.incidents_per_tier[static_cast<size_t>(Tier::REINIT)], 1u);
+  EXPECT_EQ(statistics.incidents_per_tier[static_cast<size_t>(Tier::RECONNECT)], 1u);
+
+  EXPECT_EQ(GrabRecoveryPolicy::toString(Tier::REARM), "re-arm");
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/image_pyramid.h"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::ImagePyramid;
+
+namespace
+{
+struct Image
+{
+  size_t width{ 0 };
+  size_t height{ 0 };
+  unsigned int channels{ 1 };
+  std::vector<unsigned int> data;  ///< Channels of the pixels, row by row without padding.
+
+  unsigned int at(size_t x, size_t y, unsigned int c) const
+  {
+    return data[(y * width + x) * channels + c];
+  }
+};
+
+/// Reference 2 x 2 box filter, odd rows and columns are dropped.
+Image referenceBox(const Image& src)
+{
+  Image out;
+  out.width = src.width / 2;
+  out.height = src.height / 2;
+  out.channels = src.channels;
+  for (size_t y = 0; y < out.height; ++y)
+    for (size_t x = 0; x < out.width; ++x)
+      for (unsigned int c = 0; c < src.channels; ++c)
+        out.data.push_back((src.at(2 * x, 2 * y, c) + src.at(2 * x + 1, 2 * y, c) + src.at(2 * x, 2 * y + 1, c) +
+                            src.at(2 * x + 1, 2 * y + 1, c) + 2) /
+                           4);
+  return out;
+}
+
+/// Reference superpixel reduction, pattern is e.g. "rggb".
+Image referenceSuperpixel(const Image& src, const std::string& pattern)
+{
+  Image out;
+  out.width = src.width / 2;
+  out.height = src.height / 2;
+  out.channels = 3;
+  for (size_t y = 0; y < out.height; ++y)
+  {
+    for (size_t x = 0; x < out.width; ++x)
+    {
+      unsigned int red = 0;
+      unsigned int greens = 0;
+      unsigned int blue = 0;
+      for (size_t i = 0; i < 4; ++i)
+      {
+        const unsigned int value = src.at(2 * x + i % 2, 2 * y + i / 2, 0);
+        if (pattern[i] == 'r')
+          red = value;
+        else if (pattern[i] == 'b')
+          blue = value;
+        else
+          greens += value;
+      }
+      out.data.push_back(red);
+      out.data.push_back((greens + 1) / 2);
+      out.data.push_back(blue);
+    }
+  }
+  return out;
+}
+
+Image randomImage(size_t width, size_t height, unsigned int channels, unsigned int bytes, uint32_t seed)
+{
+  std::mt19937 random(seed);
+  Image image;
+  image.width = width;
+  image.height = height;
+  image.channels = channels;
+  image.data.resize(width * height * channels);
+  for (unsigned int& value : image.data)
+    value = random() & (bytes == 1 ? 0xff : 0xffff);
+  return image;
+}
+
+/// Writes an image into a buffer with the given row step.
+std::vector<uint8_t> pack(const Image& image, unsigned int bytes, size_t step)
+{
+  std::vector<uint8_t> buffer(step * image.height, 0);
+  for (size_t y = 0; y < image.height; ++y)
+  {
+    for (size_t i = 0; i < image.width * image.channels; ++i)
+    {
+      const unsigned int value = image.data[y * image.width * image.channels + i];
+      if (bytes == 1)
+      {
+        buffer[y * step + i] = static_cast<uint8_t>(value);
+      }
+      else
+      {
+        const uint16_t wide = static_cast<uint16_t>(value);
+        std::memcpy(&buffer[y * step + 2 * i], &wide, sizeof(wide));
+      }
+    }
+  }
+  return buffer;
+}
+
+/// Expects the image in a buffer with the given row step to be equal to the reference, the padding is not checked.
+void expectEqual(const std::vector<uint8_t>& buffer, size_t step, unsigned int bytes, const Image& expected,
+                 const std::string& context)
+{
+  const size_t row_size = expected.width * expected.channels * bytes;
+  const std::vector<uint8_t> packed = pack(expected, bytes, row_size);
+  for (size_t y = 0; y < expected.height; ++y)
+  {
+    ASSERT_EQ(std::memcmp(&buffer[y * step], &packed[y * row_size], row_size), 0) << "row " << y << " of " << context;
+  }
+}
+
+struct Encoding
+{
+  std::string name;
+  unsigned int channels;
+  unsigned int bytes;
+  std::string pattern;  ///< Bayer pattern, empty for the box filter.
+};
+
+const Encoding ENCODINGS[] = {
+  { "mono8", 1, 1, "" },          { "mono16", 1, 2, "" },         { "rgb8", 3, 1, "" },
+  { "bgr8", 3, 1, "" },           { "rgb16", 3, 2, "" },          { "bgr16", 3, 2, "" },
+  { "bayer_rggb8", 1, 1, "rggb" }, { "bayer_grbg8", 1, 1, "grbg" }, { "bayer_gbrg8", 1, 1, "gbrg" },
+  { "bayer_bggr8", 1, 1, "bggr" }, { "bayer_rggb16", 1, 2, "rggb" }, { "bayer_grbg16", 1, 2, "grbg" },
+  { "bayer_gbrg16", 1, 2, "gbrg" }, { "bayer_bggr16", 1, 2, "bggr" },
+};
+
+struct Size
+{
+  size_t width;
+  size_t height;
+};
+
+const Size SIZES[] = { { 4, 4 }, { 5, 5 }, { 7, 9 }, { 8, 11 }, { 33, 17 }, { 64, 48 }, { 101, 67 } };
+}  // namespace
+
+TEST(ImagePyramid, reducedEncoding)  // NOLINT
+{
+  std::string reduced;
+  ASSERT_TRUE(ImagePyramid::getReducedEncoding("bayer_gbrg16", &reduced));
+  EXPECT_EQ(reduced, "rgb16");
+  ASSERT_TRUE(ImagePyramid::getReducedEncoding("bayer_rggb8", &reduced));
+  EXPECT_EQ(reduced, "rgb8");
+  ASSERT_TRUE(ImagePyramid::getReducedEncoding("bgr8", &reduced));
+  EXPECT_EQ(reduced, "bgr8");
+  EXPECT_FALSE(ImagePyramid::getReducedEncoding("yuv422", &reduced));
+
+  EXPECT_EQ(ImagePyramid::getReducedPixelSize("bayer_bggr16"), 6u);
+  EXPECT_EQ(ImagePyramid::getReducedPixelSize("mono8"), 1u);
+  EXPECT_EQ(ImagePyramid::getReducedPixelSize("rgb16"), 6u);
+  EXPECT_EQ(ImagePyramid::getReducedPixelSize("yuv422"), 0u);
+
+  ImagePyramid pyramid;
+  std::vector<uint8_t> buffer(64);
+  EXPECT_THROW(pyramid.reduce(buffer.data(), 4, 4, 8, "yuv422", buffer.data(), 8, nullptr, 0), std::runtime_error);
+}
+
+TEST(ImagePyramid, matchesReference)  // NOLINT
+{
+  uint32_t seed = 1;
+  for (const Encoding& encoding : ENCODINGS)
+  {
+    for (const Size& size : SIZES)
+    {
+      const std::string context =
+          encoding.name + " " + std::to_string(size.width) + " x " + std::to_string(size.height);
+      const Image src = randomImage(size.width, size.height, encoding.channels, encoding.bytes, seed++);
+      const Image half = encoding.pattern.empty() ? referenceBox(src) : referenceSuperpixel(src, encoding.pattern);
+      const Image quarter = referenceBox(half);
+
+      // Rows with padding, so that the steps are used.
+      const size_t src_step = (size.width * encoding.channels + 3) * encoding.bytes;
+      const size_t half_step = (half.width * half.channels + 5) * encoding.bytes;
+      const size_t quarter_step = (quarter.width * quarter.channels + 1) * encoding.bytes;
+      const std::vector<uint8_t> src_buffer = pack(src, encoding.bytes, src_step);
+      std::vector<uint8_t> half_buffer(half_step * half.height);
+      std::vector<uint8_t> quarter_buffer(quarter_step * quarter.height);
+
+      ImagePyramid pyramid;
+      pyramid.reduce(src_buffer.data(), size.width, size.height, src_step, encoding.name, half_buffer.data(),
+                     half_step, quarter_buffer.data(), quarter_step);
+      expectEqual(half_buffer, half_step, encoding.bytes, half, "half of " + context);
+      expectEqual(quarter_buffer, quarter_step, encoding.bytes, quarter, "quarter of " + context);
+
+      std::vector<uint8_t> half_only(half_step * half.height);
+      pyramid.reduce(src_buffer.data(), size.width, size.height, src_step, encoding.name, half_only.data(), half_step,
+                     nullptr, 0);
+      expectEqual(half_only, half_step, encoding.bytes, half, "half only of " + context);
+    }
+  }
+}
+
+TEST(ImagePyramid, quarterOnly)  // NOLINT
+{
+  // The half resolution rows go through the scratch rows, which grow with the image and are reused between calls.
+  ImagePyramid pyramid;
+  uint32_t seed = 1000;
+  for (const Size& size : SIZES)
+  {
+    for (const Encoding& encoding : ENCODINGS)
+    {
+      const std::string context =
+          encoding.name + " " + std::to_string(size.width) + " x " + std::to_string(size.height);
+      const Image src = randomImage(size.width, size.height, encoding.channels, encoding.bytes, seed++);
+      const Image half = encoding.pattern.empty() ? referenceBox(src) : referenceSuperpixel(src, encoding.pattern);
+      const Image quarter = referenceBox(half);
+
+      const size_t src_step = size.width * encoding.channels * encoding.bytes;
+      const size_t quarter_step = (quarter.width * quarter.channels + 2) * encoding.bytes;
+      const std::vector<uint8_t> src_buffer = pack(src, encoding.bytes, src_step);
+      std::vector<uint8_t> quarter_buffer(quarter_step * quarter.height);
+      pyramid.reduce(src_buffer.data(), size.width, size.height, src_step, encoding.name, nullptr, 0,
+                     quarter_buffer.data(), quarter_step);
+      expectEqual(quarter_buffer, quarter_step, encoding.bytes, quarter, "quarter only of " + context);
+    }
+  }
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/packed_pixels.h"
+
+#include <vector>
+
+using any_spinnaker_camera_driver::PackedLayout;
+using any_spinnaker_camera_driver::getPackedEncoding;
+using any_spinnaker_camera_driver::getPackedLayout;
+using any_spinnaker_camera_driver::getPackedRowSize;
+using any_spinnaker_camera_driver::unpack12;
+
+namespace
+{
+/** Packs a row of 12-bit values, the reference for the unpacking. */
+void packRow(const std::vector<uint16_t>& pixels, PackedLayout layout, uint8_t* row)
+{
+  for (size_t i = 0; i < pixels.size(); i += 2)
+  {
+    const unsigned int first = pixels[i];
+    const unsigned int second = i + 1 < pixels.size() ? pixels[i + 1] : 0;
+    uint8_t* group = row + 3 * i / 2;
+    if (layout == PackedLayout::MSB_PACKED)
+    {
+      group[0] = static_cast<uint8_t>(first >> 4);
+      group[1] = static_cast<uint8_t>((first & 0x0f) | ((second & 0x0f) << 4));
+    }
+    else
+    {
+      group[0] = static_cast<uint8_t>(first & 0xff);
+      group[1] = static_cast<uint8_t>((first >> 8) | ((second & 0x0f) << 4));
+    }
+    if (i + 1 < pixels.size())
+    {
+      group[2] = static_cast<uint8_t>(second >> 4);
+    }
+  }
+}
+
+void expectRoundTrip(size_t width, size_t height, PackedLayout layout)
+{
+  const size_t src_step = getPackedRowSize(width) + 5;  // Padded rows.
+  std::vector<uint8_t> packed(src_step * height, 0xaa);
+  std::vector<std::vector<uint16_t>> rows(height, std::vector<uint16_t>(width));
+  for (size_t y = 0; y < height; ++y)
+  {
+    for (size_t x = 0; x < width; ++x)
+    {
+      rows[y][x] = static_cast<uint16_t>((x * 37 + y * 1013) % 4096);
+    }
+    packRow(rows[y], layout, packed.data() + y * src_step);
+  }
+
+  std::vector<uint16_t> unpacked(width * height);
+  unpack12(packed.data(), width, height, src_step, layout, unpacked.data(), 2 * width);
+  for (size_t y = 0; y < height; ++y)
+  {
+    for (size_t x = 0; x < width; ++x)
+    {
+      ASSERT_EQ(unpacked[y * width + x], rows[y][x] << 4) << "pixel " << x << ", " << y;
+    }
+  }
+}
+}  // namespace
+
+TEST(PackedPixels, layouts)  // NOLINT
+{
+  EXPECT_EQ(getPackedLayout("Mono12p"), PackedLayout::LSB_PACKED);
+  EXPECT_EQ(getPackedLayout("BayerRG12p"), PackedLayout::LSB_PACKED);
+  EXPECT_EQ(getPackedLayout("Mono12Packed"), PackedLayout::MSB_PACKED);
+  EXPECT_EQ(getPackedLayout("BayerBG12Packed"), PackedLayout::MSB_PACKED);
+  EXPECT_EQ(getPackedLayout("Mono12"), PackedLayout::NONE);
+  EXPECT_EQ(getPackedLayout("Mono16"), PackedLayout::NONE);
+  EXPECT_EQ(getPackedEncoding("mono16", PackedLayout::LSB_PACKED), "mono12p");
+  EXPECT_EQ(getPackedEncoding("bayer_rggb16", PackedLayout::MSB_PACKED), "bayer_rggb12packed");
+}
+
+TEST(PackedPixels, knownBytes)  // NOLINT
+{
+  // Pixels 0x123 and 0x456.
+  const uint8_t lsb_packed[] = { 0x23, 0x61, 0x45 };
+  const uint8_t msb_packed[] = { 0x12, 0x63, 0x45 };
+  uint16_t unpacked[2];
+  unpack12(lsb_packed, 2, 1, 3, PackedLayout::LSB_PACKED, unpacked, 4);
+  EXPECT_EQ(unpacked[0], 0x1230);
+  EXPECT_EQ(unpacked[1], 0x4560);
+  unpack12(msb_packed, 2, 1, 3, PackedLayout::MSB_PACKED, unpacked, 4);
+  EXPECT_EQ(unpacked[0], 0x1230);
+  EXPECT_EQ(unpacked[1], 0x4560);
+}
+
+TEST(PackedPixels, roundTrip)  // NOLINT
+{
+  for (const PackedLayout layout : { PackedLayout::LSB_PACKED, PackedLayout::MSB_PACKED })
+  {
+    expectRoundTrip(1440, 4, layout);
+    expectRoundTrip(67, 3, layout);  // Odd width and a tail shorter than a vector.
+    expectRoundTrip(1, 1, layout);
+  }
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/pixel_format_negotiation.h"
+
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::OutputDemand;
+using any_spinnaker_camera_driver::PixelFormatChoice;
+using any_spinnaker_camera_driver::getBytesPerPixel;
+using any_spinnaker_camera_driver::negotiatePixelFormat;
+
+namespace
+{
+const std::vector<std::string> COLOR_FORMATS = { "Mono8",        "Mono16",   "Mono12p", "BayerBG8", "BayerBG16",
+                                                 "BayerBG12p",   "RGB8",     "BGR8",    "BGRa8",    "YCbCr422_8" };
+const std::vector<std::string> MONO_FORMATS = { "Mono8", "Mono16", "Mono12p" };
+
+OutputDemand makeDemand(bool raw, bool color, bool mono)
+{
+  OutputDemand demand;
+  demand.raw = raw;
+  demand.color = color;
+  demand.mono = mono;
+  return demand;
+}
+}  // namespace
+
+TEST(PixelFormatNegotiation, bytesPerPixel)  // NOLINT
+{
+  EXPECT_EQ(getBytesPerPixel("Mono8"), 1.0);
+  EXPECT_EQ(getBytesPerPixel("BayerRG8"), 1.0);
+  EXPECT_EQ(getBytesPerPixel("BayerGB16"), 2.0);
+  EXPECT_EQ(getBytesPerPixel("Mono12p"), 1.5);
+  EXPECT_EQ(getBytesPerPixel("BayerGR12Packed"), 1.5);
+  EXPECT_EQ(getBytesPerPixel("YCbCr422_8"), 2.0);
+  EXPECT_EQ(getBytesPerPixel("RGB8Packed"), 3.0);
+  EXPECT_EQ(getBytesPerPixel("BGRa8"), 4.0);
+  EXPECT_EQ(getBytesPerPixel("Unknown"), 0.0);
+}
+
+TEST(PixelFormatNegotiation, colorSensor)  // NOLINT
+{
+  // Color is demosaiced on the host from Bayer frames, a third of the bandwidth of RGB8.
+  PixelFormatChoice choice = negotiatePixelFormat(COLOR_FORMATS, makeDemand(false, true, false));
+  EXPECT_EQ(choice.pixel_format, "BayerBG8");
+  EXPECT_EQ(choice.reference_format, "RGB8");
+  EXPECT_NEAR(choice.getSavings(), 2.0 / 3.0, 1e-9);
+
+  choice = negotiatePixelFormat(COLOR_FORMATS, makeDemand(true, false, true));
+  EXPECT_EQ(choice.pixel_format, "BayerBG8");
+  EXPECT_EQ(choice.getSavings(), 0.0);
+
+  // Only mono images, the camera converts them.
+  choice = negotiatePixelFormat(COLOR_FORMATS, makeDemand(false, false, true));
+  EXPECT_EQ(choice.pixel_format, "Mono8");
+
+  // No demand keeps the raw frames.
+  choice = negotiatePixelFormat(COLOR_FORMATS, OutputDemand());
+  EXPECT_EQ(choice.pixel_format, "BayerBG8");
+}
+
+TEST(PixelFormatNegotiation, monoSensor)  // NOLINT
+{
+  for (const OutputDemand& demand : { makeDemand(true, false, false), makeDemand(false, true, true), OutputDemand() })
+  {
+    const PixelFormatChoice choice = negotiatePixelFormat(MONO_FORMATS, demand);
+    EXPECT_EQ(choice.pixel_format, "Mono8");
+    EXPECT_EQ(choice.bytes_per_pixel, 1.0);
+  }
+  EXPECT_TRUE(negotiatePixelFormat({ "Mono16" }, OutputDemand()).pixel_format.empty());
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/raw_codec.h"
+
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::RawCodec;
+using any_spinnaker_camera_driver::RawCodecHeader;
+
+namespace
+{
+/** A smooth gradient with sensor-like noise and a different level per Bayer color. */
+template <typename T>
+std::vector<T> makeFrame(size_t width, size_t height, size_t step, unsigned int bits, unsigned int shift)
+{
+  std::mt19937 random(42);
+  std::normal_distribution<double> noise(0.0, 2.0);
+  std::vector<T> frame(step * height / sizeof(T), 0x5a);
+  const double max_value = (1u << bits) - 1;
+  for (size_t y = 0; y < height; ++y)
+  {
+    for (size_t x = 0; x < width; ++x)
+    {
+      const double level = 0.2 + 0.1 * ((x % 2) + 2 * (y % 2)) + 0.3 * x / width;
+      const double value = std::min(max_value, std::max(0.0, level * max_value + noise(random)));
+      frame[y * step / sizeof(T) + x] = static_cast<T>(static_cast<unsigned int>(value) << shift);
+    }
+  }
+  return frame;
+}
+
+template <typename T>
+size_t expectRoundTrip(RawCodec* codec, const std::string& encoding, size_t width, size_t height, unsigned int bits,
+                       unsigned int shift = 0)
+{
+  const size_t step = (width + 3) * sizeof(T);  // Padded rows.
+  const std::vector<T> frame = makeFrame<T>(width, height, step, bits, shift);
+  std::vector<uint8_t> encoded;
+  codec->encode(frame.data(), width, height, step, encoding, &encoded);
+
+  RawCodecHeader header;
+  std::vector<uint8_t> decoded;
+  RawCodec::decode(encoded.data(), encoded.size(), &header, &decoded);
+  EXPECT_EQ(header.width, width);
+  EXPECT_EQ(header.height, height);
+  EXPECT_EQ(std::string(header.encoding), encoding);
+  EXPECT_EQ(decoded.size(), width * height * sizeof(T));
+  for (size_t y = 0; y < height; ++y)
+  {
+    EXPECT_EQ(std::memcmp(decoded.data() + y * width * sizeof(T), frame.data() + y * step / sizeof(T),
+                          width * sizeof(T)),
+              0)
+        << encoding << " " << width << "x" << height << ", row " << y;
+  }
+  return encoded.size();
+}
+}  // namespace
+
+TEST(RawCodec, encodings)  // NOLINT
+{
+  EXPECT_TRUE(RawCodec::isSupported("mono8"));
+  EXPECT_TRUE(RawCodec::isSupported("mono16"));
+  EXPECT_TRUE(RawCodec::isSupported("bayer_rggb8"));
+  EXPECT_TRUE(RawCodec::isSupported("bayer_gbrg16"));
+  EXPECT_FALSE(RawCodec::isSupported("rgb8"));
+  EXPECT_FALSE(RawCodec::isSupported("bayer_rggb12p"));
+
+  RawCodec codec(1);
+  std::vector<uint8_t> encoded;
+  const uint8_t pixels[4] = {};
+  EXPECT_THROW(codec.encode(pixels, 2, 2, 2, "rgb8", &encoded), std::runtime_error);
+}
+
+TEST(RawCodec, roundTrip)  // NOLINT
+{
+  for (const unsigned int threads : { 1u, 2u, 3u })
+  {
+    RawCodec codec(threads);
+    expectRoundTrip<uint8_t>(&codec, "bayer_rggb8", 640, 480, 8);
+    expectRoundTrip<uint8_t>(&codec, "bayer_bggr8", 67, 5, 8);  // Odd size.
+    expectRoundTrip<uint8_t>(&codec, "mono8", 101, 33, 8);
+    expectRoundTrip<uint16_t>(&codec, "bayer_grbg16", 320, 240, 16);
+    expectRoundTrip<uint16_t>(&codec, "bayer_rggb16", 321, 241, 12, 4);  // Unpacked 12-bit frame.
+    expectRoundTrip<uint16_t>(&codec, "mono16", 64, 2, 10, 6);
+    expectRoundTrip<uint8_t>(&codec, "bayer_rggb8", 1, 1, 8);
+    expectRoundTrip<uint8_t>(&codec, "mono8", 0, 0, 8);
+  }
+}
+
+TEST(RawCodec, extremes)  // NOLINT
+{
+  // White noise over the full range takes the escape path, constant frames the shortest codes.
+  RawCodec codec(2);
+  const size_t width = 256;
+  const size_t height = 64;
+  std::mt19937 random(7);
+  std::vector<uint16_t> noise(width * height);
+  for (auto& pixel : noise)
+  {
+    pixel = static_cast<uint16_t>(random());
+  }
+  std::vector<uint16_t> constant(width * height, 0xffff);
+  for (const auto* frame : { &noise, &constant })
+  {
+    std::vector<uint8_t> encoded;
+    codec.encode(frame->data(), width, height, 2 * width, "bayer_rggb16", &encoded);
+    RawCodecHeader header;
+    std::vector<uint8_t> decoded;
+    RawCodec::decode(encoded.data(), encoded.size(), &header, &decoded);
+    EXPECT_EQ(std::memcmp(decoded.data(), frame->data(), decoded.size()), 0);
+  }
+}
+
+TEST(RawCodec, compresses)  // NOLINT
+{
+  RawCodec codec(2);
+  const size_t size = expectRoundTrip<uint8_t>(&codec, "bayer_rggb8", 1440, 1080, 8);
+  EXPECT_LT(size, 1440u * 1080u * 3 / 4);
+  const size_t size12 = expectRoundTrip<uint16_t>(&codec, "bayer_rggb16", 1440, 1080, 12, 4);
+  EXPECT_LT(size12, 1440u * 1080u * 2 / 2);
+}
+
+TEST(RawCodec, corruptData)  // NOLINT
+{
+  RawCodec codec(2);
+  const size_t width = 128;
+  const size_t height = 64;
+  const std::vector<uint8_t> frame = makeFrame<uint8_t>(width, height, width, 8, 0);
+  std::vector<uint8_t> encoded;
+  codec.encode(frame.data(), width, height, width, "bayer_rggb8", &encoded);
+
+  RawCodecHeader header;
+  std::vector<uint8_t> decoded;
+  std::vector<uint8_t> truncated(encoded.begin(), encoded.begin() + encoded.size() / 2);
+  EXPECT_THROW(RawCodec::decode(truncated.data(), truncated.size(), &header, &decoded), std::runtime_error);
+  std::vector<uint8_t> bad_magic = encoded;
+  bad_magic[0] = 'X';
+  EXPECT_THROW(RawCodec::decode(bad_magic.data(), bad_magic.size(), &header, &decoded), std::runtime_error);
+  EXPECT_FALSE(RawCodec::readHeader(encoded.data(), 3, &header));
+}
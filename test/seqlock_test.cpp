@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/seqlock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using any_spinnaker_camera_driver::SeqLock;
+
+namespace
+{
+/** Spans several words, all fields hold the same number when consistent. */
+struct Value
+{
+  uint64_t a{ 0 };
+  double b{ 0.0 };
+  uint16_t c{ 0 };
+  uint32_t d{ 0 };
+  bool even{ true };
+};
+
+Value makeValue(uint32_t number)
+{
+  Value value;
+  value.a = number;
+  value.b = number;
+  value.c = static_cast<uint16_t>(number);
+  value.d = number;
+  value.even = number % 2 == 0;
+  return value;
+}
+}  // namespace
+
+TEST(SeqLock, storeAndModify)  // NOLINT
+{
+  SeqLock<Value> lock(makeValue(3));
+  EXPECT_EQ(lock.load().d, 3u);
+  EXPECT_EQ(lock.getVersion(), 0u);
+
+  lock.store(makeValue(8));
+  EXPECT_EQ(lock.load().a, 8u);
+  EXPECT_TRUE(lock.load().even);
+
+  lock.modify([](Value* value) { value->c = 42; });
+  const Value value = lock.load();
+  EXPECT_EQ(value.a, 8u);
+  EXPECT_EQ(value.c, 42);
+  EXPECT_EQ(lock.getVersion(), 2u);
+}
+
+TEST(SeqLock, readsAreConsistent)  // NOLINT
+{
+  SeqLock<Value> lock;
+  std::atomic<bool> done{ false };
+  std::thread writer([&lock, &done]() {
+    for (uint32_t number = 1; number <= 200000; ++number)
+    {
+      lock.store(makeValue(number));
+    }
+    done = true;
+  });
+
+  uint64_t reads = 0;
+  uint64_t last = 0;
+  while (!done)
+  {
+    const Value value = lock.load();
+    ASSERT_EQ(value.b, static_cast<double>(value.a));
+    ASSERT_EQ(value.c, static_cast<uint16_t>(value.a));
+    ASSERT_EQ(value.d, value.a);
+    ASSERT_EQ(value.even, value.a % 2 == 0);
+    ASSERT_GE(value.a, last);
+    last = value.a;
+    ++reads;
+  }
+  writer.join();
+  EXPECT_GT(reads, 0u);
+  EXPECT_EQ(lock.load().a, 200000u);
+}
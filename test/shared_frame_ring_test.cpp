@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/shared_frame_ring.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::SharedFrame;
+using any_spinnaker_camera_driver::SharedFrameRing;
+using any_spinnaker_camera_driver::SharedFrameRingClient;
+
+namespace
+{
+std::string ringName()
+{
+  return "shared_frame_ring_test_" + std::to_string(getpid()) + "_" +
+         ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+std::vector<uint8_t> makeFrame(size_t size, uint8_t seed)
+{
+  std::vector<uint8_t> frame(size);
+  for (size_t i = 0; i < size; ++i)
+    frame[i] = static_cast<uint8_t>(seed + i);
+  return frame;
+}
+}  // namespace
+
+TEST(SharedFrameRing, writeAndAcquire)  // NOLINT
+{
+  SharedFrameRing ring(ringName(), 4, 4096);
+  SharedFrameRingClient client;
+
+  const std::vector<uint8_t> frame = makeFrame(1000, 7);
+  uint32_t slot = 0;
+  uint64_t sequence = 0;
+  ASSERT_TRUE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+
+  std::shared_ptr<const SharedFrame> shared = client.acquire(ring.getName(), ring.getRingId(), slot, sequence);
+  ASSERT_TRUE(shared);
+  ASSERT_EQ(shared->size, frame.size());
+  EXPECT_EQ(std::memcmp(shared->data, frame.data(), frame.size()), 0);
+
+  // Unknown rings, ring ids and slots are rejected.
+  EXPECT_FALSE(client.acquire(ring.getName() + "_missing", ring.getRingId(), slot, sequence));
+  EXPECT_FALSE(client.acquire(ring.getName(), ring.getRingId() + 1, slot, sequence));
+  EXPECT_FALSE(client.acquire(ring.getName(), ring.getRingId(), 4, sequence));
+
+  // Frames larger than a slot are dropped.
+  const std::vector<uint8_t> large = makeFrame(ring.getSlotSize() + 1, 0);
+  EXPECT_FALSE(ring.write(large.data(), large.size(), &slot, &sequence));
+  EXPECT_EQ(ring.getDroppedFrames(), 1u);
+}
+
+TEST(SharedFrameRing, rejectsOverwrittenFrames)  // NOLINT
+{
+  SharedFrameRing ring(ringName(), 2, 4096);
+  SharedFrameRingClient client;
+
+  const std::vector<uint8_t> frame = makeFrame(100, 0);
+  uint32_t first_slot = 0;
+  uint64_t first_sequence = 0;
+  ASSERT_TRUE(ring.write(frame.data(), frame.size(), &first_slot, &first_sequence));
+  uint32_t slot = 0;
+  uint64_t sequence = 0;
+  ASSERT_TRUE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+  ASSERT_TRUE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+  ASSERT_EQ(slot, first_slot);
+
+  EXPECT_FALSE(client.acquire(ring.getName(), ring.getRingId(), first_slot, first_sequence));
+  EXPECT_TRUE(client.acquire(ring.getName(), ring.getRingId(), slot, sequence));
+}
+
+TEST(SharedFrameRing, heldSlotsAreNotOverwritten)  // NOLINT
+{
+  SharedFrameRing ring(ringName(), 2, 4096);
+  SharedFrameRingClient client;
+
+  const std::vector<uint8_t> first = makeFrame(100, 1);
+  uint32_t first_slot = 0;
+  uint64_t first_sequence = 0;
+  ASSERT_TRUE(ring.write(first.data(), first.size(), &first_slot, &first_sequence));
+  std::shared_ptr<const SharedFrame> held = client.acquire(ring.getName(), ring.getRingId(), first_slot, first_sequence);
+  std::shared_ptr<const SharedFrame> copy = client.acquire(ring.getName(), ring.getRingId(), first_slot, first_sequence);
+  ASSERT_TRUE(held);
+  ASSERT_TRUE(copy);
+
+  // Only the free slot is written while the first one is held.
+  const std::vector<uint8_t> frame = makeFrame(100, 2);
+  uint32_t slot = 0;
+  uint64_t sequence = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+    EXPECT_NE(slot, first_slot);
+  }
+  EXPECT_EQ(std::memcmp(held->data, first.data(), first.size()), 0);
+
+  // Holding the other slot as well drops the frames.
+  std::shared_ptr<const SharedFrame> other = client.acquire(ring.getName(), ring.getRingId(), slot, sequence);
+  ASSERT_TRUE(other);
+  EXPECT_FALSE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+  EXPECT_EQ(ring.getDroppedFrames(), 1u);
+
+  // The slot is released with its last reference.
+  held.reset();
+  EXPECT_FALSE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+  copy.reset();
+  ASSERT_TRUE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+  EXPECT_EQ(slot, first_slot);
+  EXPECT_EQ(ring.getReclaimedReferences(), 0u);
+}
+
+TEST(SharedFrameRing, reclaimsSlotsOfDeadConsumers)  // NOLINT
+{
+  SharedFrameRing ring(ringName(), 2, 4096);
+
+  const std::vector<uint8_t> frame = makeFrame(100, 3);
+  uint32_t slot = 0;
+  uint64_t sequence = 0;
+  ASSERT_TRUE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+
+  // The consumer exits without releasing the slot, as if it was killed.
+  const pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0)
+  {
+    SharedFrameRingClient client;
+    std::shared_ptr<const SharedFrame> held = client.acquire(ring.getName(), ring.getRingId(), slot, sequence);
+    _exit(held ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+
+  for (int i = 0; i < 4; ++i)
+  {
+    ASSERT_TRUE(ring.write(frame.data(), frame.size(), &slot, &sequence));
+  }
+  EXPECT_EQ(ring.getDroppedFrames(), 0u);
+  EXPECT_EQ(ring.getReclaimedReferences(), 1u);
+}
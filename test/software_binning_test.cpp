@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/software_binning.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using any_spinnaker_camera_driver::SoftwareBinning;
+
+namespace
+{
+/** Straightforward binning of a frame with rows of width pixels, planes is 2 for Bayer frames. */
+template <typename T>
+std::vector<T> referenceBinning(const std::vector<T>& frame, size_t width, size_t height, size_t planes,
+                                unsigned int binning_x, unsigned int binning_y, unsigned int decimation_x,
+                                unsigned int decimation_y, SoftwareBinning::Mode mode, size_t* output_width,
+                                size_t* output_height)
+{
+  const uint32_t max = (1u << (8 * sizeof(T))) - 1;
+  std::vector<T> output;
+  *output_width = 0;
+  for (size_t cell_x = 0; (cell_x + binning_x) * planes <= width; cell_x += binning_x * decimation_x)
+  {
+    *output_width += planes;
+  }
+  *output_height = 0;
+  for (size_t cell_y = 0; (cell_y + binning_y) * planes <= height; cell_y += binning_y * decimation_y)
+  {
+    for (size_t plane_y = 0; plane_y < planes; ++plane_y)
+    {
+      for (size_t cell_x = 0; (cell_x + binning_x) * planes <= width; cell_x += binning_x * decimation_x)
+      {
+        for (size_t plane_x = 0; plane_x < planes; ++plane_x)
+        {
+          uint32_t sum = 0;
+          for (unsigned int i = 0; i < binning_y; ++i)
+          {
+            for (unsigned int j = 0; j < binning_x; ++j)
+            {
+              sum += frame[((cell_y + i) * planes + plane_y) * width + (cell_x + j) * planes + plane_x];
+            }
+          }
+          const uint32_t binned = binning_x * binning_y;
+          output.push_back(static_cast<T>(mode == SoftwareBinning::Mode::SUM ? std::min(sum, max) :
+                                                                                (sum + binned / 2) / binned));
+        }
+      }
+      ++*output_height;
+    }
+  }
+  return output;
+}
+
+template <typename T>
+void expectMatchesReference(const std::string& encoding, size_t planes, size_t width, size_t height,
+                            unsigned int binning_x, unsigned int binning_y, unsigned int decimation_x,
+                            unsigned int decimation_y, SoftwareBinning::Mode mode)
+{
+  std::mt19937 random(7);
+  std::uniform_int_distribution<uint32_t> pixel(0, (1u << (8 * sizeof(T))) - 1);
+  std::vector<T> frame(width * height);
+  for (T& value : frame)
+  {
+    value = static_cast<T>(pixel(random));
+  }
+  size_t expected_width;
+  size_t expected_height;
+  const std::vector<T> expected = referenceBinning(frame, width, height, planes, binning_x, binning_y, decimation_x,
+                                                   decimation_y, mode, &expected_width, &expected_height);
+
+  SoftwareBinning binning(binning_x, binning_y, decimation_x, decimation_y, mode);
+  size_t output_width;
+  size_t output_height;
+  binning.getOutputSize(width, height, encoding, &output_width, &output_height);
+  ASSERT_EQ(output_width, expected_width);
+  ASSERT_EQ(output_height, expected_height);
+
+  const size_t dst_step = (output_width + 1) * sizeof(T);  // Padded rows.
+  std::vector<T> output(dst_step / sizeof(T) * output_height);
+  binning.process(frame.data(), width, height, width * sizeof(T), encoding, output.data(), dst_step);
+  for (size_t y = 0; y < output_height; ++y)
+  {
+    for (size_t x = 0; x < output_width; ++x)
+    {
+      ASSERT_EQ(output[y * dst_step / sizeof(T) + x], expected[y * output_width + x])
+          << encoding << " " << width << "x" << height << " binning " << binning_x << "x" << binning_y
+          << " decimation " << decimation_x << "x" << decimation_y << " at " << x << ", " << y;
+    }
+  }
+}
+}  // namespace
+
+TEST(SoftwareBinning, encodings)  // NOLINT
+{
+  EXPECT_TRUE(SoftwareBinning::isSupported("mono8"));
+  EXPECT_TRUE(SoftwareBinning::isSupported("mono16"));
+  EXPECT_TRUE(SoftwareBinning::isSupported("bayer_rggb8"));
+  EXPECT_TRUE(SoftwareBinning::isSupported("bayer_bggr16"));
+  EXPECT_FALSE(SoftwareBinning::isSupported("rgb8"));
+
+  SoftwareBinning::Mode mode;
+  EXPECT_TRUE(SoftwareBinning::parseMode("sum", &mode));
+  EXPECT_EQ(mode, SoftwareBinning::Mode::SUM);
+  EXPECT_TRUE(SoftwareBinning::parseMode("average", &mode));
+  EXPECT_EQ(mode, SoftwareBinning::Mode::AVERAGE);
+  EXPECT_FALSE(SoftwareBinning::parseMode("median", &mode));
+
+  EXPECT_THROW(SoftwareBinning(0, 1, 1, 1, SoftwareBinning::Mode::SUM), std::runtime_error);
+  SoftwareBinning binning(2, 2, 1, 1, SoftwareBinning::Mode::SUM);
+  EXPECT_FALSE(binning.isIdentity());
+  EXPECT_TRUE(SoftwareBinning(1, 1, 1, 1, SoftwareBinning::Mode::SUM).isIdentity());
+  const uint8_t pixels[12] = {};
+  uint8_t output[3];
+  EXPECT_THROW(binning.process(pixels, 2, 2, 6, "rgb8", output, 3), std::runtime_error);
+}
+
+TEST(SoftwareBinning, bayerKeepsPattern)  // NOLINT
+{
+  // 4 x 4 RGGB frame, every color has its own level.
+  const uint8_t frame[16] = { 10, 100, 12, 102,  //
+                              50, 200, 52, 202,  //
+                              14, 104, 16, 106,  //
+                              54, 204, 56, 206 };
+  uint8_t output[4];
+  SoftwareBinning average(2, 2, 1, 1, SoftwareBinning::Mode::AVERAGE);
+  average.process(frame, 4, 4, 4, "bayer_rggb8", output, 2);
+  EXPECT_EQ(output[0], 13);
+  EXPECT_EQ(output[1], 103);
+  EXPECT_EQ(output[2], 53);
+  EXPECT_EQ(output[3], 203);
+
+  SoftwareBinning sum(2, 2, 1, 1, SoftwareBinning::Mode::SUM);
+  sum.process(frame, 4, 4, 4, "bayer_rggb8", output, 2);
+  EXPECT_EQ(output[0], 52);
+  EXPECT_EQ(output[1], 255);  // Saturated.
+
+  SoftwareBinning decimation(1, 1, 2, 2, SoftwareBinning::Mode::SUM);
+  decimation.process(frame, 4, 4, 4, "bayer_rggb8", output, 2);
+  EXPECT_EQ(output[0], 10);
+  EXPECT_EQ(output[1], 100);
+  EXPECT_EQ(output[2], 50);
+  EXPECT_EQ(output[3], 200);
+}
+
+TEST(SoftwareBinning, matchesReference)  // NOLINT
+{
+  const unsigned int factors[][4] = { { 1, 1, 1, 1 }, { 2, 1, 1, 1 }, { 2, 2, 1, 1 }, { 1, 1, 2, 2 },
+                                      { 2, 2, 2, 1 }, { 3, 3, 1, 1 }, { 4, 2, 1, 3 }, { 1, 2, 3, 1 } };
+  for (const auto& f : factors)
+  {
+    for (const SoftwareBinning::Mode mode : { SoftwareBinning::Mode::SUM, SoftwareBinning::Mode::AVERAGE })
+    {
+      for (const size_t size : { 1, 7, 24, 61 })
+      {
+        expectMatchesReference<uint8_t>("mono8", 1, size + 3, size, f[0], f[1], f[2], f[3], mode);
+        expectMatchesReference<uint16_t>("mono16", 1, size, size + 5, f[0], f[1], f[2], f[3], mode);
+        expectMatchesReference<uint8_t>("bayer_grbg8", 2, size + 3, size, f[0], f[1], f[2], f[3], mode);
+        expectMatchesReference<uint16_t>("bayer_rggb16", 2, size, size + 5, f[0], f[1], f[2], f[3], mode);
+      }
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/startup_orchestrator.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using any_spinnaker_camera_driver::StartupOrchestrator;
+
+namespace
+{
+/// Counts the bring-ups running at the same time.
+class ConcurrencyProbe
+{
+public:
+  void bringUp()
+  {
+    const unsigned int running = ++running_;
+    unsigned int max = max_running_.load();
+    while (running > max && !max_running_.compare_exchange_weak(max, running))
+    {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    --running_;
+  }
+
+  unsigned int getMaxRunning() const
+  {
+    return max_running_.load();
+  }
+
+private:
+  std::atomic<unsigned int> running_{ 0 };
+  std::atomic<unsigned int> max_running_{ 0 };
+};
+}  // namespace
+
+TEST(StartupOrchestrator, limitsConcurrentBringUps)  // NOLINT
+{
+  std::shared_ptr<StartupOrchestrator> orchestrator = StartupOrchestrator::instance();
+  EXPECT_EQ(StartupOrchestrator::instance(), orchestrator);
+  // The smallest limit requested by any camera applies, 0 requests none.
+  orchestrator->setMaxParallel(3);
+  orchestrator->setMaxParallel(0);
+  orchestrator->setMaxParallel(2);
+  orchestrator->setMaxParallel(4);
+
+  const unsigned int cameras = 6;
+  for (unsigned int i = 0; i < cameras; ++i)
+    orchestrator->registerCamera("camera_" + std::to_string(i));
+
+  ConcurrencyProbe probe;
+  std::atomic<unsigned int> completed_rig{ 0 };
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < cameras; ++i)
+  {
+    threads.emplace_back([&, i]() {
+      if (orchestrator->run("camera_" + std::to_string(i), [&]() { probe.bringUp(); }))
+        ++completed_rig;
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  EXPECT_EQ(probe.getMaxRunning(), 2u);
+  // Only the last bring-up completes the rig.
+  EXPECT_EQ(completed_rig.load(), 1u);
+  EXPECT_GT(orchestrator->getTotalMs(), 0.0);
+  for (unsigned int i = 0; i < cameras; ++i)
+  {
+    const StartupOrchestrator::CameraTiming timing = orchestrator->getTiming("camera_" + std::to_string(i));
+    EXPECT_TRUE(timing.ready);
+    EXPECT_EQ(timing.attempts, 1u);
+    EXPECT_GE(timing.bring_up_ms, 25.0);
+    EXPECT_LE(timing.ready_ms, orchestrator->getTotalMs());
+  }
+}
+
+TEST(StartupOrchestrator, failedAttemptReleasesTheSlot)  // NOLINT
+{
+  std::shared_ptr<StartupOrchestrator> orchestrator = StartupOrchestrator::instance();
+  orchestrator->setMaxParallel(1);
+  orchestrator->registerCamera("left");
+  orchestrator->registerCamera("right");
+
+  EXPECT_THROW(orchestrator->run("left", []() { throw std::runtime_error("Camera not found."); }),
+               std::runtime_error);
+  EXPECT_FALSE(orchestrator->getTiming("left").ready);
+  EXPECT_EQ(orchestrator->getTiming("left").attempts, 1u);
+
+  // The slot of the failed attempt is free again.
+  EXPECT_FALSE(orchestrator->run("right", []() {}));
+  EXPECT_TRUE(orchestrator->run("left", []() {}));
+  EXPECT_EQ(orchestrator->getTiming("left").attempts, 2u);
+  EXPECT_EQ(orchestrator->getTiming("right").attempts, 1u);
+}
+
+TEST(StartupOrchestrator, unregisterEndsTheWait)  // NOLINT
+{
+  std::shared_ptr<StartupOrchestrator> orchestrator = StartupOrchestrator::instance();
+  orchestrator->setMaxParallel(1);
+  orchestrator->registerCamera("left");
+  orchestrator->registerCamera("right");
+
+  EXPECT_THROW(orchestrator->run("unknown", []() {}), std::runtime_error);
+
+  // The left camera holds the only slot until it is released.
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> holding;
+  std::thread left([&]() {
+    orchestrator->run("left", [&]() {
+      holding.set_value();
+      released.wait();
+    });
+  });
+  holding.get_future().wait();
+
+  std::atomic<bool> right_ran{ false };
+  std::future<void> right = std::async(std::launch::async, [&]() {
+    orchestrator->run("right", [&]() { right_ran = true; });
+  });
+  EXPECT_EQ(right.wait_for(std::chrono::milliseconds(100)), std::future_status::timeout);
+
+  // The driver of the right camera shuts down while it waits for a slot.
+  orchestrator->unregisterCamera("right");
+  // Still within the bring-up of the left camera, which holds the slot.
+  EXPECT_EQ(right.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  release.set_value();
+  left.join();
+  EXPECT_THROW(right.get(), std::runtime_error);
+  EXPECT_FALSE(right_ran);
+  // The rig consists of the left camera only now.
+  EXPECT_TRUE(orchestrator->getTiming("left").ready);
+  EXPECT_GT(orchestrator->getTotalMs(), 0.0);
+}
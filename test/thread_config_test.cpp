@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include "any_spinnaker_camera_driver/thread_config.h"
+
+#include <sched.h>
+
+#include <future>
+#include <string>
+#include <thread>
+
+using any_spinnaker_camera_driver::applyThreadConfig;
+using any_spinnaker_camera_driver::prefaultStack;
+using any_spinnaker_camera_driver::ThreadConfig;
+using any_spinnaker_camera_driver::ThreadConfigResult;
+
+namespace
+{
+/// A thread that idles until it is destroyed, to be configured by the tests.
+class IdleThread
+{
+public:
+  IdleThread() : stopped_(stop_.get_future()), thread_([this]() { stopped_.wait(); })
+  {
+  }
+
+  ~IdleThread()
+  {
+    stop_.set_value();
+    thread_.join();
+  }
+
+  pthread_t getHandle()
+  {
+    return thread_.native_handle();
+  }
+
+private:
+  std::promise<void> stop_;
+  std::future<void> stopped_;
+  std::thread thread_;
+};
+
+/// First CPU the process may run on.
+int firstAllowedCpu()
+{
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  EXPECT_EQ(sched_getaffinity(0, sizeof(cpus), &cpus), 0);
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &cpus))
+      return cpu;
+  }
+  return 0;
+}
+}  // namespace
+
+TEST(ThreadConfig, defaultScheduling)  // NOLINT
+{
+  IdleThread thread;
+  const ThreadConfigResult result = applyThreadConfig(thread.getHandle(), ThreadConfig());
+  EXPECT_TRUE(result.complete) << result.message;
+  EXPECT_EQ(result.policy, "other");
+  EXPECT_EQ(result.cpus, "all");
+  EXPECT_EQ(result.toString(), "other on cpus all");
+}
+
+TEST(ThreadConfig, unknownPolicy)  // NOLINT
+{
+  IdleThread thread;
+  ThreadConfig config;
+  config.policy = "deadline";
+  config.priority = 10;
+  const ThreadConfigResult result = applyThreadConfig(thread.getHandle(), config);
+  EXPECT_FALSE(result.complete);
+  EXPECT_NE(result.message.find("unknown policy 'deadline'"), std::string::npos) << result.message;
+  // The thread keeps the default policy.
+  EXPECT_EQ(result.policy, "other");
+}
+
+TEST(ThreadConfig, realTimePriorityIsClamped)  // NOLINT
+{
+  IdleThread thread;
+  ThreadConfig config;
+  config.policy = "fifo";
+  config.priority = 1000;
+  const ThreadConfigResult result = applyThreadConfig(thread.getHandle(), config);
+  EXPECT_FALSE(result.complete);
+  const int max_priority = sched_get_priority_max(SCHED_FIFO);
+  EXPECT_NE(result.message.find("priority clamped to " + std::to_string(max_priority)), std::string::npos)
+      << result.message;
+  // Without the privileges for real-time scheduling, the failure is reported and the thread keeps its policy.
+  if (result.message.find("setting fifo failed") == std::string::npos)
+  {
+    EXPECT_EQ(result.policy, "fifo");
+    EXPECT_EQ(result.priority, max_priority);
+  }
+  else
+  {
+    EXPECT_EQ(result.policy, "other");
+  }
+}
+
+TEST(ThreadConfig, affinity)  // NOLINT
+{
+  IdleThread thread;
+  ThreadConfig config;
+  const int cpu = firstAllowedCpu();
+  config.cpus = { cpu };
+  ThreadConfigResult result = applyThreadConfig(thread.getHandle(), config);
+  EXPECT_TRUE(result.complete) << result.message;
+  EXPECT_EQ(result.cpus, std::to_string(cpu));
+
+  // CPUs out of range are ignored, an empty set cannot be applied and the previous affinity stays.
+  config.cpus = { -1, CPU_SETSIZE };
+  result = applyThreadConfig(thread.getHandle(), config);
+  EXPECT_FALSE(result.complete);
+  EXPECT_NE(result.message.find("setting the affinity failed"), std::string::npos) << result.message;
+  EXPECT_EQ(result.cpus, std::to_string(cpu));
+}
+
+TEST(ThreadConfig, toString)  // NOLINT
+{
+  ThreadConfigResult result;
+  result.policy = "fifo";
+  result.priority = 50;
+  result.cpus = "2,3";
+  EXPECT_EQ(result.toString(), "fifo 50 on cpus 2,3");
+  result.complete = false;
+  result.message = "setting fifo failed: Operation not permitted";
+  EXPECT_EQ(result.toString(), "fifo 50 on cpus 2,3 (setting fifo failed: Operation not permitted)");
+}
+
+TEST(ThreadConfig, prefaultStack)  // NOLINT
+{
+  // Touches the stack of the calling thread, a size of 0 does nothing.
+  prefaultStack(0);
+  prefaultStack(256 * 1024);
+  std::thread thread([]() { prefaultStack(64 * 1024); });
+  thread.join();
+}